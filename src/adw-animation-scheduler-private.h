@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-version.h"
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+typedef struct _AdwAnimationSchedulerEntry AdwAnimationSchedulerEntry;
+
+typedef void (*AdwAnimationSchedulerFunc) (gint64   frame_time,
+                                           gpointer user_data);
+
+ADW_AVAILABLE_IN_ALL
+AdwAnimationSchedulerEntry *adw_animation_scheduler_add    (GdkFrameClock              *clock,
+                                                            AdwAnimationSchedulerFunc   func,
+                                                            gpointer                    user_data);
+ADW_AVAILABLE_IN_ALL
+void                        adw_animation_scheduler_remove (AdwAnimationSchedulerEntry *entry);
+
+ADW_AVAILABLE_IN_ALL
+guint adw_animation_scheduler_get_n_entries (GdkFrameClock *clock);
+
+ADW_AVAILABLE_IN_ALL
+gint64 adw_animation_scheduler_get_frame_time (GdkFrameClock *clock);
+
+ADW_AVAILABLE_IN_ALL
+void     adw_animation_scheduler_start_override (void);
+ADW_AVAILABLE_IN_ALL
+void     adw_animation_scheduler_end_override   (void);
+ADW_AVAILABLE_IN_ALL
+gboolean adw_animation_scheduler_get_overridden (void);
+ADW_AVAILABLE_IN_ALL
+gint64   adw_animation_scheduler_override_step  (double refresh_rate);
+
+G_END_DECLS
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-animation-scheduler-private.h"
+
+#include <math.h>
+
+/*
+ * A per-frame-clock scheduler for animations.
+ *
+ * Instead of every animation adding its own tick callback, all animations
+ * that are currently playing on the same frame clock are kept in a single
+ * compact array and are stepped from one handler of the clock's ::update
+ * signal.
+ *
+ * Entries can be added and removed at any time, including from within
+ * an entry callback. Entries added during a tick will only be stepped starting
+ * from the next frame; entries removed during a tick are cleared in place and
+ * the array is compacted once the tick is over.
+ *
+ * For tests and benchmarks, the scheduler can be overridden with a virtual
+ * clock, see adw_animation_scheduler_start_override(). In that case all
+ * entries are added to a single scheduler regardless of their frame clock,
+ * and frames are only produced by adw_animation_scheduler_override_step().
+ */
+
+typedef struct
+{
+  GdkFrameClock *clock;
+  GPtrArray *entries;
+  gulong update_cb_id;
+  gboolean ticking;
+  gboolean needs_compact;
+
+  /* Only used for the override scheduler, which doesn't have a clock */
+  gint64 frame_time;
+} AdwAnimationScheduler;
+
+struct _AdwAnimationSchedulerEntry
+{
+  AdwAnimationScheduler *scheduler;
+  AdwAnimationSchedulerFunc func;
+  gpointer user_data;
+  guint index;
+};
+
+static AdwAnimationScheduler *override_scheduler = NULL;
+
+static void
+compact_entries (AdwAnimationScheduler *self)
+{
+  guint i, j = 0;
+
+  if (!self->needs_compact)
+    return;
+
+  for (i = 0; i < self->entries->len; i++) {
+    AdwAnimationSchedulerEntry *entry = g_ptr_array_index (self->entries, i);
+
+    if (!entry->func) {
+      g_free (entry);
+      continue;
+    }
+
+    entry->index = j;
+    self->entries->pdata[j++] = entry;
+  }
+
+  g_ptr_array_set_size (self->entries, j);
+
+  self->needs_compact = FALSE;
+}
+
+static void
+scheduler_free (AdwAnimationScheduler *self)
+{
+  if (self->clock) {
+    g_signal_handler_disconnect (self->clock, self->update_cb_id);
+    gdk_frame_clock_end_updating (self->clock);
+
+    g_object_set_data (G_OBJECT (self->clock), "adw-animation-scheduler", NULL);
+    g_object_unref (self->clock);
+  }
+
+  g_ptr_array_free (self->entries, TRUE);
+
+  g_free (self);
+}
+
+static void
+tick (AdwAnimationScheduler *self,
+      gint64                 frame_time)
+{
+  guint i, n_entries = self->entries->len;
+
+  self->ticking = TRUE;
+
+  for (i = 0; i < n_entries; i++) {
+    AdwAnimationSchedulerEntry *entry = g_ptr_array_index (self->entries, i);
+
+    if (entry->func)
+      entry->func (frame_time, entry->user_data);
+  }
+
+  self->ticking = FALSE;
+
+  compact_entries (self);
+}
+
+static void
+update_cb (GdkFrameClock         *clock,
+           AdwAnimationScheduler *self)
+{
+  tick (self, gdk_frame_clock_get_frame_time (clock));
+
+  if (self->entries->len == 0)
+    scheduler_free (self);
+}
+
+static AdwAnimationScheduler *
+get_scheduler (GdkFrameClock *clock,
+               gboolean       create)
+{
+  AdwAnimationScheduler *self;
+
+  if (override_scheduler)
+    return override_scheduler;
+
+  self = g_object_get_data (G_OBJECT (clock), "adw-animation-scheduler");
+
+  if (self || !create)
+    return self;
+
+  self = g_new0 (AdwAnimationScheduler, 1);
+  self->clock = g_object_ref (clock);
+  self->entries = g_ptr_array_new ();
+  self->update_cb_id = g_signal_connect (clock, "update",
+                                         G_CALLBACK (update_cb), self);
+
+  g_object_set_data (G_OBJECT (clock), "adw-animation-scheduler", self);
+
+  gdk_frame_clock_begin_updating (clock);
+
+  return self;
+}
+
+/*
+ * adw_animation_scheduler_add:
+ * @clock: a frame clock
+ * @func: the function to call on every frame
+ * @user_data: data to pass to @func
+ *
+ * Schedules @func to be called on every frame of @clock, with the frame time
+ * in microseconds, until the returned entry is removed with
+ * adw_animation_scheduler_remove().
+ *
+ * If the scheduler is overridden, @clock is ignored and can be `NULL`.
+ *
+ * Returns: (transfer none): the new entry
+ */
+AdwAnimationSchedulerEntry *
+adw_animation_scheduler_add (GdkFrameClock             *clock,
+                             AdwAnimationSchedulerFunc  func,
+                             gpointer                   user_data)
+{
+  AdwAnimationScheduler *scheduler;
+  AdwAnimationSchedulerEntry *entry;
+
+  g_return_val_if_fail (override_scheduler || GDK_IS_FRAME_CLOCK (clock), NULL);
+  g_return_val_if_fail (func != NULL, NULL);
+
+  scheduler = get_scheduler (clock, TRUE);
+
+  entry = g_new0 (AdwAnimationSchedulerEntry, 1);
+  entry->scheduler = scheduler;
+  entry->func = func;
+  entry->user_data = user_data;
+  entry->index = scheduler->entries->len;
+
+  g_ptr_array_add (scheduler->entries, entry);
+
+  return entry;
+}
+
+/*
+ * adw_animation_scheduler_remove:
+ * @entry: an entry
+ *
+ * Stops calling the function of @entry.
+ *
+ * @entry must not be used afterwards.
+ */
+void
+adw_animation_scheduler_remove (AdwAnimationSchedulerEntry *entry)
+{
+  AdwAnimationScheduler *scheduler;
+  guint index;
+
+  g_return_if_fail (entry != NULL);
+
+  scheduler = entry->scheduler;
+
+  if (scheduler->ticking) {
+    entry->func = NULL;
+    entry->user_data = NULL;
+    scheduler->needs_compact = TRUE;
+
+    return;
+  }
+
+  index = entry->index;
+
+  g_ptr_array_remove_index_fast (scheduler->entries, index);
+
+  if (index < scheduler->entries->len) {
+    AdwAnimationSchedulerEntry *moved = g_ptr_array_index (scheduler->entries, index);
+
+    moved->index = index;
+  }
+
+  g_free (entry);
+
+  if (scheduler->entries->len == 0 && scheduler != override_scheduler)
+    scheduler_free (scheduler);
+}
+
+/*
+ * adw_animation_scheduler_get_n_entries:
+ * @clock: a frame clock
+ *
+ * Gets the number of entries currently scheduled on @clock.
+ *
+ * Returns: the number of scheduled entries
+ */
+guint
+adw_animation_scheduler_get_n_entries (GdkFrameClock *clock)
+{
+  AdwAnimationScheduler *scheduler;
+  guint i, n = 0;
+
+  g_return_val_if_fail (override_scheduler || GDK_IS_FRAME_CLOCK (clock), 0);
+
+  scheduler = get_scheduler (clock, FALSE);
+
+  if (!scheduler)
+    return 0;
+
+  for (i = 0; i < scheduler->entries->len; i++) {
+    AdwAnimationSchedulerEntry *entry = g_ptr_array_index (scheduler->entries, i);
+
+    if (entry->func)
+      n++;
+  }
+
+  return n;
+}
+
+/*
+ * adw_animation_scheduler_get_frame_time:
+ * @clock: (nullable): a frame clock
+ *
+ * Gets the time of the current frame of @clock, or of the virtual clock if the
+ * scheduler is overridden.
+ *
+ * Returns: the frame time, in microseconds
+ */
+gint64
+adw_animation_scheduler_get_frame_time (GdkFrameClock *clock)
+{
+  if (override_scheduler)
+    return override_scheduler->frame_time;
+
+  g_return_val_if_fail (GDK_IS_FRAME_CLOCK (clock), 0);
+
+  return gdk_frame_clock_get_frame_time (clock);
+}
+
+/*
+ * adw_animation_scheduler_start_override:
+ *
+ * Replaces frame clocks with a virtual clock, for tests and benchmarks.
+ *
+ * While overridden, animations run even if their widget isn't mapped, and only
+ * advance when adw_animation_scheduler_override_step() is called. The virtual
+ * clock starts at 0.
+ *
+ * Animations must not be playing when starting or ending the override.
+ */
+void
+adw_animation_scheduler_start_override (void)
+{
+  g_return_if_fail (override_scheduler == NULL);
+
+  override_scheduler = g_new0 (AdwAnimationScheduler, 1);
+  override_scheduler->entries = g_ptr_array_new ();
+}
+
+/*
+ * adw_animation_scheduler_end_override:
+ *
+ * Stops using the virtual clock.
+ */
+void
+adw_animation_scheduler_end_override (void)
+{
+  g_return_if_fail (override_scheduler != NULL);
+  g_return_if_fail (!override_scheduler->ticking);
+
+  if (override_scheduler->entries->len > 0)
+    g_critical ("Ending the animation scheduler override with %u animations still playing",
+                override_scheduler->entries->len);
+
+  g_clear_pointer (&override_scheduler, scheduler_free);
+}
+
+/*
+ * adw_animation_scheduler_get_overridden:
+ *
+ * Gets whether the scheduler is overridden with a virtual clock.
+ *
+ * Returns: whether the scheduler is overridden
+ */
+gboolean
+adw_animation_scheduler_get_overridden (void)
+{
+  return override_scheduler != NULL;
+}
+
+/*
+ * adw_animation_scheduler_override_step:
+ * @refresh_rate: the refresh rate to simulate, in Hz
+ *
+ * Advances the virtual clock by one frame at @refresh_rate and steps all
+ * scheduled entries.
+ *
+ * Returns: the new frame time, in microseconds
+ */
+gint64
+adw_animation_scheduler_override_step (double refresh_rate)
+{
+  g_return_val_if_fail (override_scheduler != NULL, 0);
+  g_return_val_if_fail (refresh_rate > 0, 0);
+
+  override_scheduler->frame_time += (gint64) round (G_USEC_PER_SEC / refresh_rate);
+
+  tick (override_scheduler, override_scheduler->frame_time);
+
+  return override_scheduler->frame_time;
+}
@@ -10,10 +10,13 @@
 #error "Only <adwaita.h> can be included directly."
 #endif
 
+#include "adw-version.h"
+
 #include "adw-animation-target.h"
 
 G_BEGIN_DECLS
 
+ADW_AVAILABLE_IN_ALL
 void adw_animation_target_set_value (AdwAnimationTarget *self,
                                      double              value);
 
@@ -146,12 +146,18 @@ adw_callback_animation_target_new (AdwAnimationTargetFunc callback,
   return ADW_ANIMATION_TARGET (self);
 }
 
+typedef void (*PropertySetter) (GObject *object,
+                                double   value);
+
 struct _AdwPropertyAnimationTarget
 {
   AdwAnimationTarget parent_instance;
 
   GObject *object;
   GParamSpec *pspec;
+
+  PropertySetter setter;
+  GValue value;
 };
 
 struct _AdwPropertyAnimationTargetClass
@@ -188,19 +194,99 @@ set_object (AdwPropertyAnimationTarget *self,
   g_object_weak_ref (self->object, object_weak_notify, self);
 }
 
+static void
+set_widget_opacity (GObject *object,
+                    double   value)
+{
+  gtk_widget_set_opacity (GTK_WIDGET (object), value);
+}
+
+static void
+set_adjustment_value (GObject *object,
+                      double   value)
+{
+  gtk_adjustment_set_value (GTK_ADJUSTMENT (object), value);
+}
+
+static void
+set_progress_bar_fraction (GObject *object,
+                           double   value)
+{
+  gtk_progress_bar_set_fraction (GTK_PROGRESS_BAR (object), value);
+}
+
+static void
+set_level_bar_value (GObject *object,
+                     double   value)
+{
+  gtk_level_bar_set_value (GTK_LEVEL_BAR (object), value);
+}
+
+/* Commonly animated properties that can skip GValue and property lookup */
+static const struct {
+  GType (*get_type) (void);
+  const char *property_name;
+  PropertySetter setter;
+} property_setters[] = {
+  { gtk_widget_get_type, "opacity", set_widget_opacity },
+  { gtk_adjustment_get_type, "value", set_adjustment_value },
+  { gtk_progress_bar_get_type, "fraction", set_progress_bar_fraction },
+  { gtk_level_bar_get_type, "value", set_level_bar_value },
+};
+
+static PropertySetter
+find_property_setter (GParamSpec *pspec)
+{
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (property_setters); i++) {
+    if (pspec->owner_type == property_setters[i].get_type () &&
+        !g_strcmp0 (pspec->name, property_setters[i].property_name))
+      return property_setters[i].setter;
+  }
+
+  return NULL;
+}
+
 static void
 adw_property_animation_target_set_value (AdwAnimationTarget *target,
                                          double              value)
 {
   AdwPropertyAnimationTarget *self = ADW_PROPERTY_ANIMATION_TARGET (target);
-  GValue gvalue = G_VALUE_INIT;
+  GType value_type;
 
   if (!self->object || !self->pspec)
     return;
 
-  g_value_init (&gvalue, G_TYPE_DOUBLE);
-  g_value_set_double (&gvalue, value);
-  g_object_set_property (self->object, self->pspec->name, &gvalue);
+  if (!self->setter && !G_IS_VALUE (&self->value))
+    return;
+
+  if (self->setter) {
+    self->setter (self->object, value);
+
+    return;
+  }
+
+  value_type = G_VALUE_TYPE (&self->value);
+
+  if (value_type == G_TYPE_DOUBLE) {
+    g_value_set_double (&self->value, value);
+  } else if (value_type == G_TYPE_FLOAT) {
+    g_value_set_float (&self->value, (float) value);
+  } else if (value_type == G_TYPE_INT) {
+    g_value_set_int (&self->value, (int) value);
+  } else {
+    GValue gvalue = G_VALUE_INIT;
+
+    g_value_init (&gvalue, G_TYPE_DOUBLE);
+    g_value_set_double (&gvalue, value);
+    g_value_transform (&gvalue, &self->value);
+    g_value_unset (&gvalue);
+  }
+
+  /* The value is set on every frame even if it didn't change, the property
+   * decides whether that emits notify */
+  g_object_set_property (self->object, self->pspec->name, &self->value);
 }
 
 static void
@@ -224,6 +310,23 @@ adw_property_animation_target_constructed (GObject *object)
              G_OBJECT_TYPE_NAME (self->object),
              g_type_name (self->pspec->owner_type),
              self->pspec->name);
+
+  self->setter = find_property_setter (self->pspec);
+
+  if (self->setter)
+    return;
+
+  if (!g_value_type_transformable (G_TYPE_DOUBLE, self->pspec->value_type)) {
+    g_critical ("Cannot animate %s:%s: values of type %s can't be converted "
+                "from double",
+                g_type_name (self->pspec->owner_type),
+                self->pspec->name,
+                g_type_name (self->pspec->value_type));
+
+    return;
+  }
+
+  g_value_init (&self->value, self->pspec->value_type);
 }
 
 static void
@@ -245,6 +348,9 @@ adw_property_animation_target_finalize (GObject *object)
 
   g_clear_pointer (&self->pspec, g_param_spec_unref);
 
+  if (G_IS_VALUE (&self->value))
+    g_value_unset (&self->value);
+
   G_OBJECT_CLASS (adw_property_animation_target_parent_class)->finalize (object);
 }
 
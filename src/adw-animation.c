@@ -9,9 +9,15 @@
 
 #include "adw-animation-private.h"
 
+#include "adw-animation-scheduler-private.h"
 #include "adw-animation-target-private.h"
 #include "adw-animation-util.h"
 #include "adw-marshalers.h"
+#include "adw-style-manager-private.h"
+
+/* Allow frames to come slightly early when limiting the frame rate, so that
+ * jitter in frame times doesn't make us skip an extra frame */
+#define FRAME_RATE_TOLERANCE 1000 /* µs */
 
 /**
  * AdwAnimation:
@@ -85,8 +91,10 @@ typedef struct
 
   gint64 start_time; /* ms */
   gint64 paused_time;
-  guint tick_cb_id;
+  gint64 last_frame_time; /* µs */
+  AdwAnimationSchedulerEntry *tick_entry;
   gulong unmap_cb_id;
+  AdwStyleManager *style_manager;
 
   AdwAnimationTarget *target;
   gpointer user_data;
@@ -94,6 +102,9 @@ typedef struct
   AdwAnimationState state;
 
   gboolean follow_enable_animations_setting;
+  gboolean quiet;
+  guint max_frame_rate;
+  gboolean essential;
 } AdwAnimationPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (AdwAnimation, adw_animation, G_TYPE_OBJECT)
@@ -105,6 +116,9 @@ enum {
   PROP_VALUE,
   PROP_STATE,
   PROP_FOLLOW_ENABLE_ANIMATIONS_SETTING,
+  PROP_QUIET,
+  PROP_MAX_FRAME_RATE,
+  PROP_ESSENTIAL,
   LAST_PROP,
 };
 
@@ -157,7 +171,8 @@ set_value (AdwAnimation *self,
 
   adw_animation_target_set_value (priv->target, priv->value);
 
-  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_VALUE]);
+  if (!priv->quiet)
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_VALUE]);
 }
 
 static void
@@ -165,9 +180,9 @@ stop_animation (AdwAnimation *self)
 {
   AdwAnimationPrivate *priv = adw_animation_get_instance_private (self);
 
-  if (priv->tick_cb_id) {
-    gtk_widget_remove_tick_callback (priv->widget, priv->tick_cb_id);
-    priv->tick_cb_id = 0;
+  if (priv->tick_entry) {
+    adw_animation_scheduler_remove (priv->tick_entry);
+    priv->tick_entry = NULL;
   }
 
   if (priv->unmap_cb_id) {
@@ -177,25 +192,75 @@ stop_animation (AdwAnimation *self)
 }
 
 static gboolean
-tick_cb (GtkWidget     *widget,
-         GdkFrameClock *frame_clock,
-         AdwAnimation  *self)
+widget_is_inactive (GtkWidget *widget)
+{
+  GtkRoot *root;
+  GdkSurface *surface;
+
+  if (gtk_widget_get_state_flags (widget) & GTK_STATE_FLAG_BACKDROP)
+    return TRUE;
+
+  root = gtk_widget_get_root (widget);
+
+  if (!GTK_IS_NATIVE (root))
+    return FALSE;
+
+  surface = gtk_native_get_surface (GTK_NATIVE (root));
+
+  return GDK_IS_TOPLEVEL (surface) &&
+         (gdk_toplevel_get_state (GDK_TOPLEVEL (surface)) & GDK_TOPLEVEL_STATE_MINIMIZED);
+}
+
+static gboolean
+should_reduce_cost (AdwAnimation *self)
+{
+  AdwAnimationPrivate *priv = adw_animation_get_instance_private (self);
+
+  if (priv->essential ||
+      !adw_style_manager_get_effective_reduce_animation_cost (priv->style_manager))
+    return FALSE;
+
+  return widget_is_inactive (priv->widget);
+}
+
+static guint
+get_max_frame_rate (AdwAnimation *self)
+{
+  AdwAnimationPrivate *priv = adw_animation_get_instance_private (self);
+  guint rate = adw_style_manager_get_effective_max_animation_frame_rate (priv->style_manager);
+
+  if (priv->max_frame_rate > 0 && (rate == 0 || priv->max_frame_rate < rate))
+    rate = priv->max_frame_rate;
+
+  return rate;
+}
+
+static void
+tick_cb (gint64        frame_time,
+         AdwAnimation *self)
 {
   AdwAnimationPrivate *priv = adw_animation_get_instance_private (self);
 
-  gint64 frame_time = gdk_frame_clock_get_frame_time (frame_clock) / 1000; /* ms */
   guint duration = ADW_ANIMATION_GET_CLASS (self)->estimate_duration (self);
-  guint t = (guint) (frame_time - priv->start_time);
+  guint t = (guint) (frame_time / 1000 - priv->start_time); /* ms */
+  guint frame_rate;
 
-  if (t >= duration && duration != ADW_DURATION_INFINITE) {
+  if ((t >= duration && duration != ADW_DURATION_INFINITE) ||
+      should_reduce_cost (self)) {
     adw_animation_skip (self);
 
-    return G_SOURCE_REMOVE;
+    return;
   }
 
-  set_value (self, t);
+  frame_rate = get_max_frame_rate (self);
 
-  return G_SOURCE_CONTINUE;
+  if (frame_rate > 0 && priv->last_frame_time > 0 &&
+      frame_time - priv->last_frame_time < (gint64) G_USEC_PER_SEC / frame_rate - FRAME_RATE_TOLERANCE)
+    return;
+
+  priv->last_frame_time = frame_time;
+
+  set_value (self, t);
 }
 
 static guint
@@ -216,6 +281,7 @@ play (AdwAnimation *self)
 {
 
   AdwAnimationPrivate *priv = adw_animation_get_instance_private (self);
+  GdkFrameClock *frame_clock;
 
   if (priv->state == ADW_ANIMATION_PLAYING) {
     g_critical ("Trying to play animation %p, but it's already playing", self);
@@ -226,24 +292,36 @@ play (AdwAnimation *self)
   priv->state = ADW_ANIMATION_PLAYING;
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_STATE]);
 
+  priv->style_manager =
+    adw_style_manager_get_for_display (gtk_widget_get_display (priv->widget));
+  priv->last_frame_time = 0;
+
   if ((priv->follow_enable_animations_setting &&
        !adw_get_enable_animations (priv->widget)) ||
-      !gtk_widget_get_mapped (priv->widget)) {
+      (!gtk_widget_get_mapped (priv->widget) &&
+       !adw_animation_scheduler_get_overridden ()) ||
+      should_reduce_cost (self)) {
     adw_animation_skip (g_object_ref (self));
 
     return;
   }
 
-  priv->start_time += gdk_frame_clock_get_frame_time (gtk_widget_get_frame_clock (priv->widget)) / 1000;
+  frame_clock = gtk_widget_get_frame_clock (priv->widget);
+
+  priv->start_time += adw_animation_scheduler_get_frame_time (frame_clock) / 1000;
   priv->start_time -= priv->paused_time;
 
-  if (priv->tick_cb_id)
+  if (priv->tick_entry)
     return;
 
   priv->unmap_cb_id =
     g_signal_connect_swapped (priv->widget, "unmap",
                               G_CALLBACK (adw_animation_skip), self);
-  priv->tick_cb_id = gtk_widget_add_tick_callback (priv->widget, (GtkTickCallback) tick_cb, self, NULL);
+
+  priv->tick_entry =
+    adw_animation_scheduler_add (frame_clock,
+                                 (AdwAnimationSchedulerFunc) tick_cb,
+                                 self);
 
   g_object_ref (self);
 }
@@ -305,6 +383,18 @@ adw_animation_get_property (GObject    *object,
     g_value_set_boolean (value, adw_animation_get_follow_enable_animations_setting (self));
     break;
 
+  case PROP_QUIET:
+    g_value_set_boolean (value, adw_animation_get_quiet (self));
+    break;
+
+  case PROP_MAX_FRAME_RATE:
+    g_value_set_uint (value, adw_animation_get_max_frame_rate (self));
+    break;
+
+  case PROP_ESSENTIAL:
+    g_value_set_boolean (value, adw_animation_get_essential (self));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -331,6 +421,18 @@ adw_animation_set_property (GObject      *object,
     adw_animation_set_follow_enable_animations_setting (self, g_value_get_boolean (value));
     break;
 
+  case PROP_QUIET:
+    adw_animation_set_quiet (self, g_value_get_boolean (value));
+    break;
+
+  case PROP_MAX_FRAME_RATE:
+    adw_animation_set_max_frame_rate (self, g_value_get_uint (value));
+    break;
+
+  case PROP_ESSENTIAL:
+    adw_animation_set_essential (self, g_value_get_boolean (value));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -422,6 +524,61 @@ adw_animation_class_init (AdwAnimationClass *klass)
                           TRUE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwAnimation:quiet: (attributes org.gtk.Property.get=adw_animation_get_quiet org.gtk.Property.set=adw_animation_set_quiet)
+   *
+   * Whether to skip per-frame change notifications.
+   *
+   * If set to `TRUE`, [property@Animation:value] is not notified on every
+   * frame, and neither are per-frame properties of subclasses, such as
+   * [property@SpringAnimation:velocity]. The values can still be read at any
+   * time, and [property@Animation:target] still receives every value.
+   *
+   * This can be useful when running many animations at once and only the
+   * target needs the values.
+   *
+   * Since: 1.4
+   */
+  props[PROP_QUIET] =
+    g_param_spec_boolean ("quiet", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAnimation:max-frame-rate: (attributes org.gtk.Property.get=adw_animation_get_max_frame_rate org.gtk.Property.set=adw_animation_set_max_frame_rate)
+   *
+   * The maximum rate at which the animation is updated, in frames per second.
+   *
+   * Frames in between are skipped without computing a new value or updating
+   * [property@Animation:target].
+   *
+   * If set to 0, the animation is updated on every frame, unless
+   * [property@StyleManager:max-animation-frame-rate] is set. If both are set,
+   * the lower one is used.
+   *
+   * Since: 1.4
+   */
+  props[PROP_MAX_FRAME_RATE] =
+    g_param_spec_uint ("max-frame-rate", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAnimation:essential: (attributes org.gtk.Property.get=adw_animation_get_essential org.gtk.Property.set=adw_animation_set_essential)
+   *
+   * Whether the animation is essential.
+   *
+   * When [property@StyleManager:reduce-animation-cost] is enabled, animations
+   * that are not essential are skipped when their window is in backdrop or
+   * minimized. Essential animations keep running.
+   *
+   * Since: 1.4
+   */
+  props[PROP_ESSENTIAL] =
+    g_param_spec_boolean ("essential", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -582,7 +739,9 @@ adw_animation_get_state (AdwAnimation *self)
  * Sets [property@Animation:state] to `ADW_ANIMATION_PLAYING`.
  *
  * The animation will be automatically skipped if [property@Animation:widget] is
- * unmapped, or if [property@Gtk.Settings:gtk-enable-animations] is `FALSE`.
+ * unmapped, or if [property@Gtk.Settings:gtk-enable-animations] is `FALSE`. If
+ * [property@StyleManager:reduce-animation-cost] is enabled, non-essential
+ * animations are also skipped while their window is in backdrop or minimized.
  *
  * As such, it's not guaranteed that the animation will actually run. For
  * example, when using [func@GLib.idle_add] and starting an animation
@@ -636,7 +795,7 @@ adw_animation_pause (AdwAnimation *self)
 
   stop_animation (self);
 
-  priv->paused_time = gdk_frame_clock_get_frame_time (gtk_widget_get_frame_clock (priv->widget)) / 1000;
+  priv->paused_time = adw_animation_scheduler_get_frame_time (gtk_widget_get_frame_clock (priv->widget)) / 1000;
 
   g_object_thaw_notify (G_OBJECT (self));
 
@@ -822,3 +981,173 @@ adw_animation_set_follow_enable_animations_setting (AdwAnimation *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_FOLLOW_ENABLE_ANIMATIONS_SETTING]);
 }
+
+/**
+ * adw_animation_get_quiet: (attributes org.gtk.Method.get_property=quiet)
+ * @self: an animation
+ *
+ * Gets whether @self skips per-frame change notifications.
+ *
+ * Returns: whether @self is quiet
+ *
+ * Since: 1.4
+ */
+gboolean
+adw_animation_get_quiet (AdwAnimation *self)
+{
+  AdwAnimationPrivate *priv;
+
+  g_return_val_if_fail (ADW_IS_ANIMATION (self), FALSE);
+
+  priv = adw_animation_get_instance_private (self);
+
+  return priv->quiet;
+}
+
+/**
+ * adw_animation_set_quiet: (attributes org.gtk.Method.set_property=quiet)
+ * @self: an animation
+ * @quiet: whether to skip per-frame change notifications
+ *
+ * Sets whether @self skips per-frame change notifications.
+ *
+ * If set to `TRUE`, [property@Animation:value] is not notified on every
+ * frame, and neither are per-frame properties of subclasses, such as
+ * [property@SpringAnimation:velocity]. The values can still be read at any
+ * time, and [property@Animation:target] still receives every value.
+ *
+ * This can be useful when running many animations at once and only the
+ * target needs the values.
+ *
+ * Since: 1.4
+ */
+void
+adw_animation_set_quiet (AdwAnimation *self,
+                         gboolean      quiet)
+{
+  AdwAnimationPrivate *priv;
+
+  g_return_if_fail (ADW_IS_ANIMATION (self));
+
+  priv = adw_animation_get_instance_private (self);
+
+  quiet = !!quiet;
+
+  if (quiet == priv->quiet)
+    return;
+
+  priv->quiet = quiet;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_QUIET]);
+}
+
+/**
+ * adw_animation_get_max_frame_rate: (attributes org.gtk.Method.get_property=max-frame-rate)
+ * @self: an animation
+ *
+ * Gets the maximum rate at which @self is updated.
+ *
+ * Returns: the maximum frame rate, or 0 if unlimited
+ *
+ * Since: 1.4
+ */
+guint
+adw_animation_get_max_frame_rate (AdwAnimation *self)
+{
+  AdwAnimationPrivate *priv;
+
+  g_return_val_if_fail (ADW_IS_ANIMATION (self), 0);
+
+  priv = adw_animation_get_instance_private (self);
+
+  return priv->max_frame_rate;
+}
+
+/**
+ * adw_animation_set_max_frame_rate: (attributes org.gtk.Method.set_property=max-frame-rate)
+ * @self: an animation
+ * @frame_rate: the maximum frame rate, or 0
+ *
+ * Sets the maximum rate at which @self is updated, in frames per second.
+ *
+ * Frames in between are skipped without computing a new value or updating
+ * [property@Animation:target].
+ *
+ * If set to 0, the animation is updated on every frame, unless
+ * [property@StyleManager:max-animation-frame-rate] is set. If both are set, the
+ * lower one is used.
+ *
+ * Since: 1.4
+ */
+void
+adw_animation_set_max_frame_rate (AdwAnimation *self,
+                                  guint         frame_rate)
+{
+  AdwAnimationPrivate *priv;
+
+  g_return_if_fail (ADW_IS_ANIMATION (self));
+
+  priv = adw_animation_get_instance_private (self);
+
+  if (frame_rate == priv->max_frame_rate)
+    return;
+
+  priv->max_frame_rate = frame_rate;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_FRAME_RATE]);
+}
+
+/**
+ * adw_animation_get_essential: (attributes org.gtk.Method.get_property=essential)
+ * @self: an animation
+ *
+ * Gets whether @self is essential.
+ *
+ * Returns: whether @self is essential
+ *
+ * Since: 1.4
+ */
+gboolean
+adw_animation_get_essential (AdwAnimation *self)
+{
+  AdwAnimationPrivate *priv;
+
+  g_return_val_if_fail (ADW_IS_ANIMATION (self), FALSE);
+
+  priv = adw_animation_get_instance_private (self);
+
+  return priv->essential;
+}
+
+/**
+ * adw_animation_set_essential: (attributes org.gtk.Method.set_property=essential)
+ * @self: an animation
+ * @essential: whether @self is essential
+ *
+ * Sets whether @self is essential.
+ *
+ * When [property@StyleManager:reduce-animation-cost] is enabled, animations
+ * that are not essential are skipped when their window is in backdrop or
+ * minimized. Essential animations keep running.
+ *
+ * Since: 1.4
+ */
+void
+adw_animation_set_essential (AdwAnimation *self,
+                             gboolean      essential)
+{
+  AdwAnimationPrivate *priv;
+
+  g_return_if_fail (ADW_IS_ANIMATION (self));
+
+  priv = adw_animation_get_instance_private (self);
+
+  essential = !!essential;
+
+  if (essential == priv->essential)
+    return;
+
+  priv->essential = essential;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ESSENTIAL]);
+}
@@ -74,4 +74,22 @@ ADW_AVAILABLE_IN_1_3
 void     adw_animation_set_follow_enable_animations_setting (AdwAnimation *self,
                                                              gboolean      setting);
 
+ADW_AVAILABLE_IN_1_4
+gboolean adw_animation_get_quiet (AdwAnimation *self);
+ADW_AVAILABLE_IN_1_4
+void     adw_animation_set_quiet (AdwAnimation *self,
+                                  gboolean      quiet);
+
+ADW_AVAILABLE_IN_1_4
+guint adw_animation_get_max_frame_rate (AdwAnimation *self);
+ADW_AVAILABLE_IN_1_4
+void  adw_animation_set_max_frame_rate (AdwAnimation *self,
+                                        guint         frame_rate);
+
+ADW_AVAILABLE_IN_1_4
+gboolean adw_animation_get_essential (AdwAnimation *self);
+ADW_AVAILABLE_IN_1_4
+void     adw_animation_set_essential (AdwAnimation *self,
+                                      gboolean      essential);
+
 G_END_DECLS
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _AdwCubicBezier AdwCubicBezier;
+
+AdwCubicBezier *adw_cubic_bezier_get   (double x1,
+                                        double y1,
+                                        double x2,
+                                        double y2);
+AdwCubicBezier *adw_cubic_bezier_ref   (AdwCubicBezier *self);
+void            adw_cubic_bezier_unref (AdwCubicBezier *self);
+
+void adw_cubic_bezier_get_control_points (AdwCubicBezier *self,
+                                          double         *x1,
+                                          double         *y1,
+                                          double         *x2,
+                                          double         *y2);
+
+double adw_cubic_bezier_ease (AdwCubicBezier *self,
+                              double          progress);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (AdwCubicBezier, adw_cubic_bezier_unref)
+
+G_END_DECLS
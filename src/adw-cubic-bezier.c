@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-cubic-bezier-private.h"
+
+#include <math.h>
+
+/*
+ * A CSS-style cubic-bezier() easing curve, going from (0, 0) to (1, 1) with
+ * the control points (x1, y1) and (x2, y2).
+ *
+ * Evaluating the curve for a given progress means finding the curve parameter
+ * for which the x coordinate matches the progress. Instead of solving that on
+ * every frame, the parameter is sampled at evenly spaced progress values once
+ * per curve, and then linearly interpolated and refined with a single Newton
+ * step.
+ *
+ * Curves are interned: all animations using the same control points share one
+ * table. Like the rest of the animation code, they are only meant to be used
+ * from the main thread.
+ */
+
+#define N_SAMPLES 256
+#define NEWTON_ITERATIONS 8
+#define BISECTION_ITERATIONS 64
+#define SOLVE_EPSILON 1e-12
+
+struct _AdwCubicBezier
+{
+  double x1;
+  double y1;
+  double x2;
+  double y2;
+
+  guint ref_count;
+
+  double samples[N_SAMPLES];
+};
+
+static GHashTable *curves = NULL;
+
+static guint
+curve_hash (gconstpointer data)
+{
+  const AdwCubicBezier *self = data;
+
+  return g_double_hash (&self->x1) ^
+         (g_double_hash (&self->y1) << 1) ^
+         (g_double_hash (&self->x2) << 2) ^
+         (g_double_hash (&self->y2) << 3);
+}
+
+static gboolean
+curve_equal (gconstpointer a,
+             gconstpointer b)
+{
+  const AdwCubicBezier *self = a;
+  const AdwCubicBezier *other = b;
+
+  return g_double_equal (&self->x1, &other->x1) &&
+         g_double_equal (&self->y1, &other->y1) &&
+         g_double_equal (&self->x2, &other->x2) &&
+         g_double_equal (&self->y2, &other->y2);
+}
+
+static inline double
+bezier (double p1,
+        double p2,
+        double t)
+{
+  double u = 1 - t;
+
+  return 3 * u * u * t * p1 + 3 * u * t * t * p2 + t * t * t;
+}
+
+static inline double
+bezier_derivative (double p1,
+                   double p2,
+                   double t)
+{
+  double u = 1 - t;
+
+  return 3 * u * u * p1 + 6 * u * t * (p2 - p1) + 3 * t * t * (1 - p2);
+}
+
+/* x is monotonic in t since x1 and x2 are in [0, 1], so Newton's method
+ * converges quickly in most cases, with bisection as a fallback for flat
+ * parts of the curve */
+static double
+solve_x (AdwCubicBezier *self,
+         double          x)
+{
+  double t = x, lo = 0, hi = 1;
+  int i;
+
+  for (i = 0; i < NEWTON_ITERATIONS; i++) {
+    double error = bezier (self->x1, self->x2, t) - x;
+    double derivative = bezier_derivative (self->x1, self->x2, t);
+
+    if (ABS (error) < SOLVE_EPSILON)
+      return t;
+
+    if (ABS (derivative) < 1e-6)
+      break;
+
+    t -= error / derivative;
+  }
+
+  t = x;
+
+  for (i = 0; i < BISECTION_ITERATIONS; i++) {
+    double value = bezier (self->x1, self->x2, t);
+
+    if (ABS (value - x) < SOLVE_EPSILON)
+      break;
+
+    if (value < x)
+      lo = t;
+    else
+      hi = t;
+
+    t = (lo + hi) / 2;
+  }
+
+  return t;
+}
+
+/*
+ * adw_cubic_bezier_get:
+ * @x1: the x coordinate of the first control point, in the [0, 1] range
+ * @y1: the y coordinate of the first control point, must be finite
+ * @x2: the x coordinate of the second control point, in the [0, 1] range
+ * @y2: the y coordinate of the second control point, must be finite
+ *
+ * Gets the curve with the given control points, creating and sampling it if no
+ * other user has it yet.
+ *
+ * Returns: (transfer full): the curve
+ */
+AdwCubicBezier *
+adw_cubic_bezier_get (double x1,
+                      double y1,
+                      double x2,
+                      double y2)
+{
+  AdwCubicBezier key, *self;
+  int i;
+
+  g_return_val_if_fail (x1 >= 0 && x1 <= 1, NULL);
+  g_return_val_if_fail (x2 >= 0 && x2 <= 1, NULL);
+  g_return_val_if_fail (isfinite (y1) && isfinite (y2), NULL);
+
+  /* Curves are hashed by the bit patterns of their control points, so make sure
+   * -0 and 0 end up being the same curve */
+  if (x1 == 0)
+    x1 = 0;
+  if (y1 == 0)
+    y1 = 0;
+  if (x2 == 0)
+    x2 = 0;
+  if (y2 == 0)
+    y2 = 0;
+
+  key.x1 = x1;
+  key.y1 = y1;
+  key.x2 = x2;
+  key.y2 = y2;
+
+  if (G_UNLIKELY (!curves))
+    curves = g_hash_table_new (curve_hash, curve_equal);
+
+  self = g_hash_table_lookup (curves, &key);
+
+  if (self)
+    return adw_cubic_bezier_ref (self);
+
+  self = g_new (AdwCubicBezier, 1);
+  self->x1 = x1;
+  self->y1 = y1;
+  self->x2 = x2;
+  self->y2 = y2;
+  self->ref_count = 1;
+
+  for (i = 0; i < N_SAMPLES; i++)
+    self->samples[i] = solve_x (self, (double) i / (N_SAMPLES - 1));
+
+  g_hash_table_add (curves, self);
+
+  return self;
+}
+
+/*
+ * adw_cubic_bezier_ref:
+ * @self: a curve
+ *
+ * Increases the reference count of @self.
+ *
+ * Returns: (transfer full): @self
+ */
+AdwCubicBezier *
+adw_cubic_bezier_ref (AdwCubicBezier *self)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+
+  self->ref_count++;
+
+  return self;
+}
+
+/*
+ * adw_cubic_bezier_unref:
+ * @self: a curve
+ *
+ * Decreases the reference count of @self.
+ *
+ * If the last reference is dropped, the curve is removed from the interned
+ * curves and freed.
+ */
+void
+adw_cubic_bezier_unref (AdwCubicBezier *self)
+{
+  g_return_if_fail (self != NULL);
+  g_return_if_fail (self->ref_count > 0);
+
+  if (--self->ref_count > 0)
+    return;
+
+  g_hash_table_remove (curves, self);
+
+  g_free (self);
+}
+
+/*
+ * adw_cubic_bezier_get_control_points:
+ * @self: a curve
+ * @x1: (out) (optional): return location for the x coordinate of the first
+ *   control point
+ * @y1: (out) (optional): return location for the y coordinate of the first
+ *   control point
+ * @x2: (out) (optional): return location for the x coordinate of the second
+ *   control point
+ * @y2: (out) (optional): return location for the y coordinate of the second
+ *   control point
+ *
+ * Gets the control points of @self.
+ */
+void
+adw_cubic_bezier_get_control_points (AdwCubicBezier *self,
+                                     double         *x1,
+                                     double         *y1,
+                                     double         *x2,
+                                     double         *y2)
+{
+  g_return_if_fail (self != NULL);
+
+  if (x1)
+    *x1 = self->x1;
+  if (y1)
+    *y1 = self->y1;
+  if (x2)
+    *x2 = self->x2;
+  if (y2)
+    *y2 = self->y2;
+}
+
+/*
+ * adw_cubic_bezier_ease:
+ * @self: a curve
+ * @progress: the progress, in the [0, 1] range
+ *
+ * Computes the value of @self at @progress.
+ *
+ * Returns: the eased value
+ */
+double
+adw_cubic_bezier_ease (AdwCubicBezier *self,
+                       double          progress)
+{
+  double position, fraction, t, lo, hi, derivative;
+  int i;
+
+  if (progress <= 0)
+    return 0;
+
+  if (progress >= 1)
+    return 1;
+
+  position = progress * (N_SAMPLES - 1);
+  i = MIN ((int) position, N_SAMPLES - 2);
+  fraction = position - i;
+
+  lo = self->samples[i];
+  hi = self->samples[i + 1];
+  t = lo + (hi - lo) * fraction;
+
+  /* One Newton step brings the interpolated parameter very close to the
+   * exact one, as long as it stays within the sampled interval */
+  derivative = bezier_derivative (self->x1, self->x2, t);
+
+  if (ABS (derivative) > 1e-6) {
+    double refined = t - (bezier (self->x1, self->x2, t) - progress) / derivative;
+
+    if (refined >= lo && refined <= hi)
+      t = refined;
+  }
+
+  return bezier (self->y1, self->y2, t);
+}
@@ -54,7 +54,12 @@ typedef enum {
 } AdwEasing;
 
 ADW_AVAILABLE_IN_ALL
-double adw_easing_ease (AdwEasing self,
-                        double    value);
+double adw_easing_ease   (AdwEasing     self,
+                          double        value);
+ADW_AVAILABLE_IN_1_4
+void   adw_easing_ease_n (AdwEasing     self,
+                          const double *values,
+                          double       *results,
+                          gsize         n_values);
 
 G_END_DECLS
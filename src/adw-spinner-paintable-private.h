@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-version.h"
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_SPINNER_PAINTABLE (adw_spinner_paintable_get_type())
+
+G_DECLARE_FINAL_TYPE (AdwSpinnerPaintable, adw_spinner_paintable, ADW, SPINNER_PAINTABLE, GObject)
+
+GdkPaintable *adw_spinner_paintable_new_for_widget (GtkWidget *widget) G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
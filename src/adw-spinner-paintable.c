@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-spinner-paintable-private.h"
+
+#include "adw-animation-scheduler-private.h"
+#include "adw-style-manager-private.h"
+
+#include <math.h>
+
+#define SPINNER_ICON_NAME "process-working-symbolic"
+#define SPINNER_SIZE 16
+#define SPINNER_PERIOD (G_USEC_PER_SEC)
+
+/*
+ * A spinner that is shared by every widget on the same frame clock.
+ *
+ * Unlike GtkSpinner, which runs a separate CSS animation for each instance,
+ * all users of this paintable display the same phase and are redrawn from a
+ * single animation scheduler entry. The entry only exists while at least one
+ * widget holds a reference, so widgets should drop it as soon as their spinner
+ * isn't visible anymore.
+ *
+ * Like other animations, the spinner stops on its current frame when
+ * animations are disabled, or when the window is in backdrop or minimized with
+ * AdwStyleManager:reduce-animation-cost enabled.
+ */
+
+struct _AdwSpinnerPaintable
+{
+  GObject parent_instance;
+
+  GdkFrameClock *clock;
+  AdwAnimationSchedulerEntry *entry;
+  GdkPaintable *icon;
+  double phase;
+
+  GdkDisplay *display;
+  GdkSurface *surface;
+  AdwStyleManager *style_manager;
+};
+
+static void adw_spinner_paintable_paintable_init (GdkPaintableInterface *iface);
+static void adw_spinner_paintable_symbolic_paintable_init (GtkSymbolicPaintableInterface *iface);
+
+G_DEFINE_FINAL_TYPE_WITH_CODE (AdwSpinnerPaintable, adw_spinner_paintable, G_TYPE_OBJECT,
+                               G_IMPLEMENT_INTERFACE (GDK_TYPE_PAINTABLE, adw_spinner_paintable_paintable_init)
+                               G_IMPLEMENT_INTERFACE (GTK_TYPE_SYMBOLIC_PAINTABLE, adw_spinner_paintable_symbolic_paintable_init))
+
+static void
+tick_cb (gint64   frame_time,
+         gpointer user_data)
+{
+  AdwSpinnerPaintable *self = ADW_SPINNER_PAINTABLE (user_data);
+
+  self->phase = fmod ((double) frame_time / SPINNER_PERIOD, 1);
+
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+static gboolean
+should_animate (AdwSpinnerPaintable *self)
+{
+  gboolean enable_animations = TRUE;
+  GdkToplevelState state;
+
+  g_object_get (gtk_settings_get_for_display (self->display),
+                "gtk-enable-animations", &enable_animations,
+                NULL);
+
+  if (!enable_animations)
+    return FALSE;
+
+  if (!GDK_IS_TOPLEVEL (self->surface) ||
+      !adw_style_manager_get_effective_reduce_animation_cost (self->style_manager))
+    return TRUE;
+
+  state = gdk_toplevel_get_state (GDK_TOPLEVEL (self->surface));
+
+  return (state & GDK_TOPLEVEL_STATE_FOCUSED) &&
+         !(state & GDK_TOPLEVEL_STATE_MINIMIZED);
+}
+
+static void
+update_running (AdwSpinnerPaintable *self)
+{
+  gboolean animate = should_animate (self);
+
+  if (animate == !!self->entry)
+    return;
+
+  if (animate)
+    self->entry = adw_animation_scheduler_add (self->clock, tick_cb, self);
+  else
+    g_clear_pointer (&self->entry, adw_animation_scheduler_remove);
+}
+
+static void
+update_icon (AdwSpinnerPaintable *self)
+{
+  GtkIconTheme *theme = gtk_icon_theme_get_for_display (self->display);
+  int scale = self->surface ? gdk_surface_get_scale_factor (self->surface) : 1;
+
+  g_clear_object (&self->icon);
+  self->icon = GDK_PAINTABLE (gtk_icon_theme_lookup_icon (theme,
+                                                          SPINNER_ICON_NAME,
+                                                          NULL,
+                                                          SPINNER_SIZE,
+                                                          scale,
+                                                          GTK_TEXT_DIR_NONE,
+                                                          0));
+}
+
+static void
+icon_changed_cb (AdwSpinnerPaintable *self)
+{
+  update_icon (self);
+
+  gdk_paintable_invalidate_size (GDK_PAINTABLE (self));
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+static void
+adw_spinner_paintable_finalize (GObject *object)
+{
+  AdwSpinnerPaintable *self = ADW_SPINNER_PAINTABLE (object);
+
+  g_clear_pointer (&self->entry, adw_animation_scheduler_remove);
+
+  g_object_set_data (G_OBJECT (self->clock), "adw-spinner-paintable", NULL);
+  g_object_unref (self->clock);
+
+  g_clear_object (&self->surface);
+  g_object_unref (self->icon);
+
+  G_OBJECT_CLASS (adw_spinner_paintable_parent_class)->finalize (object);
+}
+
+static void
+adw_spinner_paintable_class_init (AdwSpinnerPaintableClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = adw_spinner_paintable_finalize;
+}
+
+static void
+adw_spinner_paintable_init (AdwSpinnerPaintable *self)
+{
+}
+
+static void
+adw_spinner_paintable_snapshot_symbolic (GtkSymbolicPaintable *paintable,
+                                         GdkSnapshot          *snapshot,
+                                         double                width,
+                                         double                height,
+                                         const GdkRGBA        *colors,
+                                         gsize                 n_colors)
+{
+  AdwSpinnerPaintable *self = ADW_SPINNER_PAINTABLE (paintable);
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (width / 2, height / 2));
+  gtk_snapshot_rotate (snapshot, 360 * self->phase);
+  gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (-width / 2, -height / 2));
+
+  gtk_symbolic_paintable_snapshot_symbolic (GTK_SYMBOLIC_PAINTABLE (self->icon),
+                                            snapshot, width, height,
+                                            colors, n_colors);
+
+  gtk_snapshot_restore (snapshot);
+}
+
+static void
+adw_spinner_paintable_snapshot (GdkPaintable *paintable,
+                                GdkSnapshot  *snapshot,
+                                double        width,
+                                double        height)
+{
+  adw_spinner_paintable_snapshot_symbolic (GTK_SYMBOLIC_PAINTABLE (paintable),
+                                           snapshot, width, height, NULL, 0);
+}
+
+static int
+adw_spinner_paintable_get_intrinsic_width (GdkPaintable *paintable)
+{
+  AdwSpinnerPaintable *self = ADW_SPINNER_PAINTABLE (paintable);
+
+  return gdk_paintable_get_intrinsic_width (self->icon);
+}
+
+static int
+adw_spinner_paintable_get_intrinsic_height (GdkPaintable *paintable)
+{
+  AdwSpinnerPaintable *self = ADW_SPINNER_PAINTABLE (paintable);
+
+  return gdk_paintable_get_intrinsic_height (self->icon);
+}
+
+static void
+adw_spinner_paintable_paintable_init (GdkPaintableInterface *iface)
+{
+  iface->snapshot = adw_spinner_paintable_snapshot;
+  iface->get_intrinsic_width = adw_spinner_paintable_get_intrinsic_width;
+  iface->get_intrinsic_height = adw_spinner_paintable_get_intrinsic_height;
+}
+
+static void
+adw_spinner_paintable_symbolic_paintable_init (GtkSymbolicPaintableInterface *iface)
+{
+  iface->snapshot_symbolic = adw_spinner_paintable_snapshot_symbolic;
+}
+
+/*
+ * adw_spinner_paintable_new_for_widget:
+ * @widget: a mapped widget
+ *
+ * Gets the spinner shared by all widgets on the frame clock of @widget.
+ *
+ * The spinner keeps animating for as long as any reference to it is held, unless
+ * animations are disabled or reduced, see the description above.
+ *
+ * Returns: (transfer full): the shared spinner
+ */
+GdkPaintable *
+adw_spinner_paintable_new_for_widget (GtkWidget *widget)
+{
+  AdwSpinnerPaintable *self;
+  GdkFrameClock *clock;
+  GtkRoot *root;
+
+  g_return_val_if_fail (GTK_IS_WIDGET (widget), NULL);
+
+  clock = gtk_widget_get_frame_clock (widget);
+
+  g_return_val_if_fail (clock != NULL, NULL);
+
+  self = g_object_get_data (G_OBJECT (clock), "adw-spinner-paintable");
+
+  if (self)
+    return g_object_ref (GDK_PAINTABLE (self));
+
+  root = gtk_widget_get_root (widget);
+
+  self = g_object_new (ADW_TYPE_SPINNER_PAINTABLE, NULL);
+  self->clock = g_object_ref (clock);
+  self->display = gtk_widget_get_display (widget);
+  self->style_manager = adw_style_manager_get_for_display (self->display);
+
+  /* The frame clock belongs to the toplevel surface */
+  if (GTK_IS_NATIVE (root) && gtk_native_get_surface (GTK_NATIVE (root)))
+    self->surface = g_object_ref (gtk_native_get_surface (GTK_NATIVE (root)));
+
+  update_icon (self);
+
+  g_signal_connect_object (gtk_icon_theme_get_for_display (self->display), "changed",
+                           G_CALLBACK (icon_changed_cb), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (gtk_settings_get_for_display (self->display), "notify::gtk-enable-animations",
+                           G_CALLBACK (update_running), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (self->style_manager, "notify::reduce-animation-cost",
+                           G_CALLBACK (update_running), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (adw_style_manager_get_default (), "notify::reduce-animation-cost",
+                           G_CALLBACK (update_running), self, G_CONNECT_SWAPPED);
+
+  if (self->surface) {
+    g_signal_connect_object (self->surface, "notify::scale-factor",
+                             G_CALLBACK (icon_changed_cb), self, G_CONNECT_SWAPPED);
+    g_signal_connect_object (self->surface, "notify::state",
+                             G_CALLBACK (update_running), self, G_CONNECT_SWAPPED);
+  }
+
+  update_running (self);
+
+  if (self->entry)
+    self->phase = fmod ((double) adw_animation_scheduler_get_frame_time (clock) / SPINNER_PERIOD, 1);
+
+  g_object_set_data (G_OBJECT (clock), "adw-spinner-paintable", self);
+
+  return GDK_PAINTABLE (self);
+}
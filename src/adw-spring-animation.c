@@ -7,13 +7,13 @@
 #include "config.h"
 
 #include "adw-spring-animation.h"
-#include "adw-spring-params.h"
+#include "adw-spring-params-private.h"
 
 #include "adw-animation-private.h"
 #include "adw-animation-util.h"
 
-#define DELTA 0.001
 #define MAX_ITERATIONS 20000
+#define DURATION_CACHE_SIZE 64
 
 /**
  * AdwSpringAnimation:
@@ -62,6 +62,8 @@ struct _AdwSpringAnimation
 
   double initial_velocity;
   double velocity;
+  guint velocity_time; /*ms*/
+  gboolean velocity_valid;
   double epsilon;
   gboolean clamp;
 
@@ -90,156 +92,347 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
-/* Based on RBBSpringAnimation from RBBAnimation, MIT license.
- * https://github.com/robb/RBBAnimation/blob/master/RBBAnimation/RBBSpringAnimation.m
+/*
+ * A spring resting at 0, starting at @x0 with velocity @v0.
+ */
+typedef struct {
+  AdwSpringParams *params;
+  AdwSpringRegime regime;
+  double beta;
+  double omega;
+  double x0;
+  double v0;
+} SpringSystem;
+
+static void
+spring_system_init (SpringSystem    *system,
+                    AdwSpringParams *spring_params,
+                    double           x0,
+                    double           v0)
+{
+  system->params = spring_params;
+  system->regime = adw_spring_params_get_regime (spring_params);
+  system->beta = adw_spring_params_get_beta (spring_params);
+  system->omega = adw_spring_params_get_omega (spring_params);
+  system->x0 = x0;
+  system->v0 = v0;
+}
+
+static inline double
+spring_system_offset (const SpringSystem *system,
+                      double              t,
+                      double             *velocity)
+{
+  return adw_spring_params_oscillate (system->params, system->x0, system->v0, t, velocity);
+}
+
+/*
+ * Both the offset and the velocity of a spring have the form
+ * envelope * (p * c(t) + q * s(t)), where c and s are cos and sin for
+ * underdamped springs, cosh and sinh for overdamped ones, and 1 and t for
+ * critically damped ones.
  *
- * @offset: Starting value of the spring simulation. Use -1 for regular animations,
- * as the formulas are tailored to rest at 0 and the resulting evolution between 
- * -1 and 0 will be lerped to the desired range afterwards. Otherwise use 0 for in-place
- * animations which already start at equilibrium
+ * Returns the first t > 0, in seconds, at which such a function crosses 0, or
+ * -1 if it never does.
  */
 static double
-oscillate (AdwSpringAnimation *self,
-           guint               time,
-           double             *velocity)
+spring_system_first_root (const SpringSystem *system,
+                          double              p,
+                          double              q)
 {
-  double b = adw_spring_params_get_damping (self->spring_params);
-  double m = adw_spring_params_get_mass (self->spring_params);
-  double k = adw_spring_params_get_stiffness (self->spring_params);
-  double v0 = self->initial_velocity;
+  double r;
 
-  double t = time / 1000.0;
+  switch (system->regime) {
+  case ADW_SPRING_CRITICALLY_DAMPED:
+    if (G_APPROX_VALUE (q, 0, DBL_EPSILON))
+      return -1;
 
-  double beta = b / (2 * m);
-  double omega0 = sqrt (k / m);
+    r = -p / q;
 
-  double x0 = self->value_from - self->value_to;
+    return r > 0 ? r : -1;
 
-  double envelope = exp (-beta * t);
+  case ADW_SPRING_UNDERDAMPED:
+    if (G_APPROX_VALUE (q, 0, DBL_EPSILON))
+      return G_PI_2 / system->omega;
 
-  /*
-   * Solutions of the form C1*e^(lambda1*x) + C2*e^(lambda2*x)
-   * for the differential equation m*ẍ+b*ẋ+kx = 0
-   */
+    r = atan (-p / q);
 
-  /* Critically damped */
-  /* DBL_EPSILON is too small for this specific comparison, so we use
-   * FLT_EPSILON even though it's doubles */
-  if (G_APPROX_VALUE (beta, omega0, FLT_EPSILON)) {
-    if (velocity)
-      *velocity = envelope * (-beta * t * v0 - beta * beta * t * x0 + v0);
+    if (r <= 0)
+      r += G_PI;
 
-    return self->value_to + envelope * (x0 + (beta * x0 + v0) * t);
+    return r / system->omega;
+
+  case ADW_SPRING_OVERDAMPED:
+    if (G_APPROX_VALUE (q, 0, DBL_EPSILON))
+      return -1;
+
+    r = -p / q;
+
+    if (r <= 0 || r >= 1)
+      return -1;
+
+    return atanh (r) / system->omega;
+
+  default:
+    g_assert_not_reached ();
   }
+}
 
-  /* Underdamped */
-  if (beta < omega0) {
-    double omega1 = sqrt ((omega0 * omega0) - (beta * beta));
+static double
+spring_system_first_zero (const SpringSystem *system)
+{
+  double beta = system->beta;
+  double x0 = system->x0;
+  double v0 = system->v0;
 
-    if (velocity)
-      *velocity = envelope * (v0 * cos (omega1 * t) - (x0 * omega1 + (beta * beta * x0 + beta * v0) / (omega1)) * sin (omega1 * t));
+  if (system->regime == ADW_SPRING_CRITICALLY_DAMPED)
+    return spring_system_first_root (system, x0, beta * x0 + v0);
+
+  return spring_system_first_root (system, x0, (beta * x0 + v0) / system->omega);
+}
+
+static double
+spring_system_first_extremum (const SpringSystem *system)
+{
+  double beta = system->beta;
+  double omega = system->omega;
+  double x0 = system->x0;
+  double v0 = system->v0;
 
-    return self->value_to + envelope * (x0 * cos (omega1 * t) + ((beta * x0 + v0) / omega1) * sin (omega1 * t));
+  switch (system->regime) {
+  case ADW_SPRING_CRITICALLY_DAMPED:
+    return spring_system_first_root (system, v0, -beta * (v0 + beta * x0));
+
+  case ADW_SPRING_UNDERDAMPED:
+    return spring_system_first_root (system, v0, -(x0 * omega + (beta * beta * x0 + beta * v0) / omega));
+
+  case ADW_SPRING_OVERDAMPED:
+    return spring_system_first_root (system, v0, omega * x0 - (beta * beta * x0 + beta * v0) / omega);
+
+  default:
+    g_assert_not_reached ();
   }
+}
 
-  /* Overdamped */
-  if (beta > omega0) {
-    double omega2 = sqrt ((beta * beta) - (omega0 * omega0));
+static double
+oscillate (AdwSpringAnimation *self,
+           guint               time,
+           double             *velocity)
+{
+  return self->value_to +
+    adw_spring_params_oscillate (self->spring_params,
+                                 self->value_from - self->value_to,
+                                 self->initial_velocity,
+                                 time / 1000.0,
+                                 velocity);
+}
 
-    if (velocity)
-      *velocity = envelope * (v0 * coshl (omega2 * t) + (omega2 * x0 - (beta * beta * x0 + beta * v0) / omega2) * sinhl (omega2 * t));
+/*
+ * Finds the first time, in milliseconds and starting from 1, at which the
+ * spring gets within @threshold of its resting position or crosses it.
+ *
+ * Before the first zero, the offset grows until the first extremum, if there's
+ * one, and then monotonically decreases, so a bisection between the two is
+ * guaranteed to converge in at most log2 (MAX_ITERATIONS) steps.
+ */
+static guint
+get_first_zero (const SpringSystem *system,
+                double              threshold)
+{
+  double sign = system->x0 > 0 ? 1 : -1;
+  double zero, extremum;
+  guint lo = 1, hi;
+
+#define DISTANCE(t) (sign * spring_system_offset (system, (t) / 1000.0, NULL) - threshold)
+
+  if (DISTANCE (lo) <= 0)
+    return lo;
+
+  zero = spring_system_first_zero (system);
+  extremum = spring_system_first_extremum (system);
+
+  if (extremum > 0 && (zero < 0 || extremum < zero))
+    lo = MAX (lo, (guint) MIN (floor (extremum * 1000), MAX_ITERATIONS));
+
+  if (DISTANCE (lo) <= 0)
+    return lo;
+
+  if (zero > 0 && zero * 1000 < MAX_ITERATIONS)
+    hi = MAX (lo + 1, (guint) ceil (zero * 1000));
+  else
+    hi = MAX (lo + 1, MAX_ITERATIONS + 1);
 
-    return self->value_to + envelope * (x0 * coshl (omega2 * t) + ((beta * x0 + v0) / omega2) * sinhl (omega2 * t));
+  while (DISTANCE (hi) > 0) {
+    if (hi > MAX_ITERATIONS)
+      return 0;
+
+    lo = hi;
+    hi = MIN (hi * 2, MAX_ITERATIONS + 1);
   }
 
-  g_assert_not_reached ();
+  while (hi - lo > 1) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (DISTANCE (mid) > 0)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+#undef DISTANCE
+
+  return hi;
 }
 
+/*
+ * Finds the first time, in milliseconds, after which an overdamped spring
+ * stays within @threshold of its resting position.
+ *
+ * An overdamped spring has at most one extremum, after which the offset
+ * monotonically decays. Starting from there, the bracket is doubled until it
+ * contains the root and then bisected, so both loops are bounded by the width
+ * of guint.
+ */
 static guint
-get_first_zero (AdwSpringAnimation *self)
+get_settle_time (const SpringSystem *system,
+                 double              threshold)
 {
-  /* The first frame is not that important and we avoid finding the trivial 0
-   * for in-place animations. */
-  guint i = 1;
-  double y = oscillate (self, i, NULL);
+  double extremum = spring_system_first_extremum (system);
+  guint64 lo = 0, hi;
+
+#define DISTANCE(t) (ABS (spring_system_offset (system, (t) / 1000.0, NULL)) - threshold)
+
+  if (extremum > 0)
+    lo = (guint64) floor (extremum * 1000);
 
-  while ((self->value_to - self->value_from > DBL_EPSILON && self->value_to - y > self->epsilon) ||
-         (self->value_from - self->value_to > DBL_EPSILON && y - self->value_to > self->epsilon)) {
-    if (i > MAX_ITERATIONS)
+  if (DISTANCE (lo) <= 0)
+    return lo;
+
+  /* The envelope is a good lower estimate to start with */
+  hi = MAX (lo + 1, (guint64) (-log (threshold) / system->beta * 1000));
+
+  while (DISTANCE (hi) > 0) {
+    if (hi >= ADW_DURATION_INFINITE / 2)
       return 0;
 
-    y = oscillate (self, ++i, NULL);
+    lo = hi;
+    hi *= 2;
   }
 
-  return i;
+  while (hi - lo > 1) {
+    guint64 mid = lo + (hi - lo) / 2;
+
+    if (DISTANCE (mid) > 0)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+#undef DISTANCE
+
+  return (guint) hi;
+}
+
+/*
+ * Durations only depend on the spring parameters and the starting state
+ * relative to the distance to travel, so retargeting a spring mid-flight keeps
+ * hitting the same entries as long as it's scaled uniformly.
+ */
+typedef struct {
+  double damping;
+  double mass;
+  double stiffness;
+  double threshold;
+  double x0;
+  double v0;
+  gboolean clamp;
+} DurationCacheKey;
+
+typedef struct {
+  DurationCacheKey key;
+  guint duration;
+  gboolean valid;
+} DurationCacheEntry;
+
+static DurationCacheEntry duration_cache[DURATION_CACHE_SIZE];
+
+static guint
+duration_cache_key_hash (const DurationCacheKey *key)
+{
+  const guint32 *data = (const guint32 *) key;
+  guint hash = 5381;
+  gsize i;
+
+  for (i = 0; i < sizeof (DurationCacheKey) / sizeof (guint32); i++)
+    hash = (hash << 5) + hash + data[i];
+
+  return hash;
 }
 
 static guint
 calculate_duration (AdwSpringAnimation *self)
 {
-  double damping = adw_spring_params_get_damping (self->spring_params);
-  double mass = adw_spring_params_get_mass (self->spring_params);
-  double stiffness = adw_spring_params_get_stiffness (self->spring_params);
-
-  double beta = damping / (2 * mass);
-  double omega0;
-  double x0, y0;
-  double x1, y1;
-  double m;
+  SpringSystem system;
+  DurationCacheKey key;
+  DurationCacheEntry *entry;
+  double distance;
+  guint duration;
 
-  int i = 0;
+  spring_system_init (&system, self->spring_params,
+                      self->value_from - self->value_to,
+                      self->initial_velocity);
 
-  if (G_APPROX_VALUE (beta, 0, DBL_EPSILON) || beta < 0)
+  if (G_APPROX_VALUE (system.beta, 0, DBL_EPSILON) || system.beta < 0)
     return ADW_DURATION_INFINITE;
 
   if (self->clamp) {
     if (G_APPROX_VALUE (self->value_to, self->value_from, DBL_EPSILON))
       return 0;
-
-    return get_first_zero (self);
+  } else if (system.regime != ADW_SPRING_OVERDAMPED) {
+    /*
+     * For the oscillating solutions we take the value of the envelope when
+     * it's < epsilon
+     */
+    return -log (self->epsilon) / system.beta * 1000;
   }
 
-  omega0 = sqrt (stiffness / mass);
+  /* Normalize the system by the distance to travel, or by the initial
+   * velocity for in-place animations */
+  if (!G_APPROX_VALUE (system.x0, 0, DBL_EPSILON))
+    distance = ABS (system.x0);
+  else
+    distance = ABS (system.v0);
 
-  /*
-   * As first ansatz for the overdamped solution,
-   * and general estimation for the oscillating ones
-   * we take the value of the envelope when it's < epsilon
-   */
-  x0 = -log (self->epsilon) / beta;
-
-  /* DBL_EPSILON is too small for this specific comparison, so we use
-   * FLT_EPSILON even though it's doubles */
-  if (G_APPROX_VALUE (beta, omega0, FLT_EPSILON) || beta < omega0)
-    return x0 * 1000;
-
-  /*
-   * Since the overdamped solution decays way slower than the envelope
-   * we need to use the value of the oscillation itself.
-   * Newton's root finding method is a good candidate in this particular case:
-   * https://en.wikipedia.org/wiki/Newton%27s_method
-   */
-  y0 = oscillate (self, x0 * 1000, NULL);
-  m = (oscillate (self, (x0 + DELTA) * 1000, NULL) - y0) / DELTA;
+  if (G_APPROX_VALUE (distance, 0, DBL_EPSILON))
+    return 0;
 
-  x1 = (self->value_to - y0 + m * x0) / m;
-  y1 = oscillate (self, x1 * 1000, NULL);
+  system.x0 /= distance;
+  system.v0 /= distance;
 
-  while (ABS (self->value_to - y1) > self->epsilon) {
-    if (i>1000)
-      return 0;
+  memset (&key, 0, sizeof (DurationCacheKey));
+  key.damping = adw_spring_params_get_damping (self->spring_params);
+  key.mass = adw_spring_params_get_mass (self->spring_params);
+  key.stiffness = adw_spring_params_get_stiffness (self->spring_params);
+  key.threshold = self->epsilon / distance;
+  key.x0 = system.x0;
+  key.v0 = system.v0;
+  key.clamp = self->clamp;
 
-    x0 = x1;
-    y0 = y1;
+  entry = &duration_cache[duration_cache_key_hash (&key) % DURATION_CACHE_SIZE];
 
-    m = (oscillate (self, (x0 + DELTA) * 1000, NULL) - y0) / DELTA;
+  if (entry->valid && !memcmp (&entry->key, &key, sizeof (DurationCacheKey)))
+    return entry->duration;
 
-    x1 = (self->value_to - y0 + m * x0) / m;
-    y1 = oscillate (self, x1 * 1000, NULL);
-    i++;
-  }
+  if (self->clamp)
+    duration = get_first_zero (&system, key.threshold);
+  else
+    duration = get_settle_time (&system, key.threshold);
+
+  entry->key = key;
+  entry->duration = duration;
+  entry->valid = TRUE;
 
-  return x1 * 1000;
+  return duration;
 }
 
 static void
@@ -262,6 +455,44 @@ adw_spring_animation_estimate_duration (AdwAnimation *animation)
   return self->estimated_duration;
 }
 
+static double
+sample (AdwSpringAnimation *self,
+        guint               t,
+        double             *velocity)
+{
+  double value;
+
+  if (t >= self->estimated_duration) {
+    if (velocity)
+      *velocity = 0;
+
+    return self->value_to;
+  }
+
+  if (adw_spring_params_sample_response (self->spring_params,
+                                         self->value_from - self->value_to,
+                                         self->initial_velocity,
+                                         t / 1000.0,
+                                         self->epsilon,
+                                         &value,
+                                         velocity))
+    return value + self->value_to;
+
+  return oscillate (self, t, velocity);
+}
+
+/* The velocity skipped in quiet mode depends on the current spring, so it has to
+ * be computed before anything that changes the motion */
+static void
+ensure_velocity (AdwSpringAnimation *self)
+{
+  if (self->velocity_valid)
+    return;
+
+  sample (self, self->velocity_time, &self->velocity);
+  self->velocity_valid = TRUE;
+}
+
 static double
 adw_spring_animation_real_calculate_value (AdwAnimation *animation,
                                            guint         t)
@@ -269,14 +500,18 @@ adw_spring_animation_real_calculate_value (AdwAnimation *animation,
   AdwSpringAnimation *self = ADW_SPRING_ANIMATION (animation);
   double value;
 
-  if (t >= self->estimated_duration) {
-    self->velocity = 0;
-    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_VELOCITY]);
+  /* In quiet mode, nobody is listening for velocity changes, so only remember
+   * the time and compute the velocity if it's actually requested */
+  if (adw_animation_get_quiet (animation)) {
+    self->velocity_time = t;
+    self->velocity_valid = FALSE;
 
-    return self->value_to;
+    return sample (self, t, NULL);
   }
 
-  value = oscillate (self, t, &self->velocity);
+  value = sample (self, t, &self->velocity);
+  self->velocity_valid = TRUE;
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_VELOCITY]);
 
   return value;
@@ -511,6 +746,10 @@ adw_spring_animation_class_init (AdwSpringAnimationClass *klass)
    * AdwSpringAnimation:velocity: (attributes org.gtk.Property.get=adw_spring_animation_get_velocity)
    *
    * Current velocity of the animation.
+   *
+   * If [property@Animation:quiet] is set to `TRUE`, this property is not
+   * notified on every frame, and the velocity is only computed when it's
+   * read.
    */
   props[PROP_VELOCITY] =
     g_param_spec_double ("velocity", NULL, NULL,
@@ -526,6 +765,7 @@ static void
 adw_spring_animation_init (AdwSpringAnimation *self)
 {
   self->epsilon = 0.001;
+  self->velocity_valid = TRUE;
 }
 
 /**
@@ -605,6 +845,8 @@ adw_spring_animation_set_value_from (AdwSpringAnimation *self,
   if (G_APPROX_VALUE (self->value_from, value, DBL_EPSILON))
     return;
 
+  ensure_velocity (self);
+
   self->value_from = value;
 
   estimate_duration (self);
@@ -647,6 +889,8 @@ adw_spring_animation_set_value_to (AdwSpringAnimation *self,
   if (G_APPROX_VALUE (self->value_to, value, DBL_EPSILON))
     return;
 
+  ensure_velocity (self);
+
   self->value_to = value;
 
   estimate_duration (self);
@@ -687,6 +931,8 @@ adw_spring_animation_set_spring_params (AdwSpringAnimation *self,
   if (self->spring_params == spring_params)
     return;
 
+  ensure_velocity (self);
+
   g_clear_pointer (&self->spring_params, adw_spring_params_unref);
   self->spring_params = adw_spring_params_ref (spring_params);
 
@@ -729,6 +975,8 @@ adw_spring_animation_set_initial_velocity (AdwSpringAnimation *self,
   if (G_APPROX_VALUE (self->initial_velocity, velocity, DBL_EPSILON))
     return;
 
+  ensure_velocity (self);
+
   self->initial_velocity = velocity;
 
   estimate_duration (self);
@@ -780,6 +1028,8 @@ adw_spring_animation_set_epsilon (AdwSpringAnimation *self,
   if (G_APPROX_VALUE (self->epsilon, epsilon, DBL_EPSILON))
     return;
 
+  ensure_velocity (self);
+
   self->epsilon = epsilon;
 
   estimate_duration (self);
@@ -825,6 +1075,8 @@ adw_spring_animation_set_clamp (AdwSpringAnimation *self,
   if (self->clamp == clamp)
     return;
 
+  ensure_velocity (self);
+
   self->clamp = clamp;
 
   estimate_duration (self);
@@ -910,6 +1162,9 @@ adw_spring_animation_get_estimated_duration (AdwSpringAnimation *self)
  *
  * Gets the current velocity of @self.
  *
+ * If [property@Animation:quiet] is set to `TRUE`, the velocity is computed on
+ * demand, so this is still cheap to call on every frame.
+ *
  * Returns: the current velocity
  */
 double
@@ -917,5 +1172,7 @@ adw_spring_animation_get_velocity (AdwSpringAnimation *self)
 {
   g_return_val_if_fail (ADW_IS_SPRING_ANIMATION (self), 0.0);
 
+  ensure_velocity (self);
+
   return self->velocity;
 }
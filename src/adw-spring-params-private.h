@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-spring-params.h"
+
+G_BEGIN_DECLS
+
+typedef enum {
+  ADW_SPRING_CRITICALLY_DAMPED,
+  ADW_SPRING_UNDERDAMPED,
+  ADW_SPRING_OVERDAMPED,
+} AdwSpringRegime;
+
+AdwSpringRegime adw_spring_params_get_regime (AdwSpringParams *self);
+double          adw_spring_params_get_beta   (AdwSpringParams *self);
+double          adw_spring_params_get_omega  (AdwSpringParams *self);
+
+double adw_spring_params_oscillate (AdwSpringParams *self,
+                                    double           x0,
+                                    double           v0,
+                                    double           t,
+                                    double          *velocity);
+
+gboolean adw_spring_params_sample_response (AdwSpringParams *self,
+                                            double           x0,
+                                            double           v0,
+                                            double           t,
+                                            double           max_error,
+                                            double          *offset,
+                                            double          *velocity);
+
+G_END_DECLS
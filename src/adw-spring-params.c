@@ -6,7 +6,7 @@
 
 #include "config.h"
 
-#include "adw-spring-params.h"
+#include "adw-spring-params-private.h"
 
 #include <math.h>
 
@@ -48,6 +48,48 @@ G_DEFINE_BOXED_TYPE (AdwSpringParams, adw_spring_params,
  * As such
  */
 
+/*
+ * The unit step (x0 = 1, v0 = 0) and unit impulse (x0 = 0, v0 = 1) responses
+ * of the spring, along with their velocities, sampled at a fixed step. Since
+ * the spring equation is linear, any other response is a linear combination
+ * of these two.
+ *
+ * Values between samples are reconstructed with cubic Hermite interpolation,
+ * using the sampled velocities as derivatives for positions, and
+ * accelerations derived from the spring equation as derivatives for
+ * velocities.
+ *
+ * Every response of the spring is a combination of exponentials e^(λt) with
+ * |λ| <= Λ, so the interpolation error for a response with amplitude A is
+ * bounded by A * (hΛ)^4 / 384, where h is the step. The step is picked to keep
+ * that bound at RESPONSE_TABLE_TOLERANCE for unit amplitude, limited to
+ * [RESPONSE_TABLE_MIN_STEP, RESPONSE_TABLE_MAX_STEP].
+ */
+typedef struct
+{
+  double x_step;
+  double v_step;
+  double x_impulse;
+  double v_impulse;
+} ResponseSample;
+
+typedef struct
+{
+  double step;
+  guint n_samples;
+
+  /* Error bounds for the step and impulse response with unit amplitude */
+  double step_error;
+  double impulse_error;
+
+  ResponseSample samples[];
+} ResponseTable;
+
+#define RESPONSE_TABLE_TOLERANCE 1e-8
+#define RESPONSE_TABLE_MIN_STEP 0.0005 /* s */
+#define RESPONSE_TABLE_MAX_STEP 0.008 /* s */
+#define RESPONSE_TABLE_MAX_SAMPLES 2048
+
 struct _AdwSpringParams
 {
   gatomicrefcount ref_count;
@@ -55,8 +97,96 @@ struct _AdwSpringParams
   double damping;
   double mass;
   double stiffness;
+
+  AdwSpringRegime regime;
+  double beta;
+  double omega0;
+  double omega;
+
+  ResponseTable *response_table;
 };
 
+static ResponseTable *
+build_response_table (AdwSpringParams *self)
+{
+  ResponseTable *table;
+  double lambda, step_amplitude, impulse_amplitude, decay;
+  double step, error, duration;
+  guint i, n_samples;
+
+  switch (self->regime) {
+  case ADW_SPRING_CRITICALLY_DAMPED:
+    lambda = self->beta;
+    step_amplitude = 5;
+    impulse_amplitude = 4 / self->beta;
+    decay = self->beta;
+    break;
+
+  case ADW_SPRING_UNDERDAMPED:
+    lambda = self->omega0;
+    step_amplitude = self->omega0 / self->omega;
+    impulse_amplitude = 1 / self->omega;
+    decay = self->beta;
+    break;
+
+  case ADW_SPRING_OVERDAMPED:
+    lambda = self->beta + self->omega;
+    step_amplitude = self->beta / self->omega;
+    impulse_amplitude = 1 / self->omega;
+    decay = self->beta - self->omega;
+    break;
+
+  default:
+    g_assert_not_reached ();
+  }
+
+  step = pow (384 * RESPONSE_TABLE_TOLERANCE, 0.25) / lambda;
+  step = CLAMP (step, RESPONSE_TABLE_MIN_STEP, RESPONSE_TABLE_MAX_STEP);
+
+  /* Cover the time it takes for the responses to become negligible */
+  if (decay > 0)
+    duration = (log (MAX (step_amplitude, 1)) - log (RESPONSE_TABLE_TOLERANCE)) / decay;
+  else
+    duration = G_MAXDOUBLE;
+
+  n_samples = (guint) MIN (ceil (duration / step) + 2, RESPONSE_TABLE_MAX_SAMPLES);
+
+  table = g_malloc (sizeof (ResponseTable) + n_samples * sizeof (ResponseSample));
+  table->step = step;
+  table->n_samples = n_samples;
+
+  error = pow (step * lambda, 4) / 384;
+  table->step_error = error * step_amplitude;
+  table->impulse_error = error * impulse_amplitude;
+
+  for (i = 0; i < n_samples; i++) {
+    ResponseSample *sample = &table->samples[i];
+    double t = i * step;
+
+    sample->x_step = adw_spring_params_oscillate (self, 1, 0, t, &sample->v_step);
+    sample->x_impulse = adw_spring_params_oscillate (self, 0, 1, t, &sample->v_impulse);
+  }
+
+  return table;
+}
+
+static inline double
+hermite (double s,
+         double h,
+         double p0,
+         double m0,
+         double p1,
+         double m1)
+{
+  double s2 = s * s;
+  double s3 = s2 * s;
+
+  return (2 * s3 - 3 * s2 + 1) * p0 +
+         (s3 - 2 * s2 + s) * h * m0 +
+         (-2 * s3 + 3 * s2) * p1 +
+         (s3 - s2) * h * m1;
+}
+
 /**
  * adw_spring_params_new:
  * @damping_ratio: the damping ratio of the spring
@@ -128,6 +258,22 @@ adw_spring_params_new_full (double damping,
   self->mass = mass;
   self->stiffness = stiffness;
 
+  self->beta = damping / (2 * mass);
+  self->omega0 = sqrt (stiffness / mass);
+
+  /* DBL_EPSILON is too small for this specific comparison, so we use
+   * FLT_EPSILON even though it's doubles */
+  if (G_APPROX_VALUE (self->beta, self->omega0, FLT_EPSILON)) {
+    self->regime = ADW_SPRING_CRITICALLY_DAMPED;
+    self->omega = 0;
+  } else if (self->beta < self->omega0) {
+    self->regime = ADW_SPRING_UNDERDAMPED;
+    self->omega = sqrt ((self->omega0 * self->omega0) - (self->beta * self->beta));
+  } else {
+    self->regime = ADW_SPRING_OVERDAMPED;
+    self->omega = sqrt ((self->beta * self->beta) - (self->omega0 * self->omega0));
+  }
+
   return self;
 }
 
@@ -162,8 +308,10 @@ adw_spring_params_unref (AdwSpringParams *self)
 {
   g_return_if_fail (self != NULL);
 
-  if (g_atomic_ref_count_dec (&self->ref_count))
+  if (g_atomic_ref_count_dec (&self->ref_count)) {
+    g_free (self->response_table);
     g_free (self);
+  }
 }
 
 /**
@@ -233,3 +381,154 @@ adw_spring_params_get_stiffness (AdwSpringParams *self)
 
   return self->stiffness;
 }
+
+AdwSpringRegime
+adw_spring_params_get_regime (AdwSpringParams *self)
+{
+  g_return_val_if_fail (self != NULL, ADW_SPRING_CRITICALLY_DAMPED);
+
+  return self->regime;
+}
+
+double
+adw_spring_params_get_beta (AdwSpringParams *self)
+{
+  g_return_val_if_fail (self != NULL, 0.0);
+
+  return self->beta;
+}
+
+/*
+ * Returns the angular frequency of the damped oscillation for underdamped
+ * springs, the difference between the two decay rates for overdamped ones,
+ * and 0 for critically damped springs.
+ */
+double
+adw_spring_params_get_omega (AdwSpringParams *self)
+{
+  g_return_val_if_fail (self != NULL, 0.0);
+
+  return self->omega;
+}
+
+/* Based on RBBSpringAnimation from RBBAnimation, MIT license.
+ * https://github.com/robb/RBBAnimation/blob/master/RBBAnimation/RBBSpringAnimation.m
+ *
+ * Returns the offset from the resting position at @t seconds for a spring
+ * starting at @x0 with velocity @v0.
+ */
+double
+adw_spring_params_oscillate (AdwSpringParams *self,
+                             double           x0,
+                             double           v0,
+                             double           t,
+                             double          *velocity)
+{
+  double beta = self->beta;
+  double omega = self->omega;
+  double envelope;
+
+  /*
+   * Solutions of the form C1*e^(lambda1*x) + C2*e^(lambda2*x)
+   * for the differential equation m*ẍ+b*ẋ+kx = 0
+   */
+
+  switch (self->regime) {
+  case ADW_SPRING_CRITICALLY_DAMPED:
+    envelope = exp (-beta * t);
+
+    if (velocity)
+      *velocity = envelope * (-beta * t * v0 - beta * beta * t * x0 + v0);
+
+    return envelope * (x0 + (beta * x0 + v0) * t);
+
+  case ADW_SPRING_UNDERDAMPED:
+    envelope = exp (-beta * t);
+
+    if (velocity)
+      *velocity = envelope * (v0 * cos (omega * t) - (x0 * omega + (beta * beta * x0 + beta * v0) / (omega)) * sin (omega * t));
+
+    return envelope * (x0 * cos (omega * t) + ((beta * x0 + v0) / omega) * sin (omega * t));
+
+  case ADW_SPRING_OVERDAMPED:
+    {
+      /* Expanding cosh and sinh avoids multiplying an underflowing envelope
+       * by an overflowing cosh for strongly overdamped springs */
+      double c = (beta * x0 + v0) / omega;
+      double slow = (x0 + c) / 2 * exp ((omega - beta) * t);
+      double fast = (x0 - c) / 2 * exp (-(omega + beta) * t);
+
+      if (velocity)
+        *velocity = (omega - beta) * slow - (omega + beta) * fast;
+
+      return slow + fast;
+    }
+
+  default:
+    g_assert_not_reached ();
+  }
+}
+
+/*
+ * Same as adw_spring_params_oscillate(), but interpolates the response from
+ * a table built the first time it's needed instead of evaluating it exactly.
+ *
+ * Returns %FALSE if @t is past the end of the table, or if the interpolation
+ * error bound for this response is larger than @max_error. In that case
+ * adw_spring_params_oscillate() must be used instead.
+ */
+gboolean
+adw_spring_params_sample_response (AdwSpringParams *self,
+                                   double           x0,
+                                   double           v0,
+                                   double           t,
+                                   double           max_error,
+                                   double          *offset,
+                                   double          *velocity)
+{
+  ResponseTable *table;
+  ResponseSample *a, *b;
+  double x_a, v_a, x_b, v_b;
+  double omega0_sq, s;
+  guint i;
+
+  g_return_val_if_fail (self != NULL, FALSE);
+
+  if (g_once_init_enter (&self->response_table)) {
+    ResponseTable *new_table = build_response_table (self);
+
+    g_once_init_leave (&self->response_table, new_table);
+  }
+
+  table = self->response_table;
+
+  if (t < 0 || t / table->step >= table->n_samples - 1)
+    return FALSE;
+
+  if (ABS (x0) * table->step_error + ABS (v0) * table->impulse_error > max_error)
+    return FALSE;
+
+  i = (guint) (t / table->step);
+  s = t / table->step - i;
+
+  a = &table->samples[i];
+  b = &table->samples[i + 1];
+
+  x_a = x0 * a->x_step + v0 * a->x_impulse;
+  v_a = x0 * a->v_step + v0 * a->v_impulse;
+  x_b = x0 * b->x_step + v0 * b->x_impulse;
+  v_b = x0 * b->v_step + v0 * b->v_impulse;
+
+  *offset = hermite (s, table->step, x_a, v_a, x_b, v_b);
+
+  if (velocity) {
+    omega0_sq = self->omega0 * self->omega0;
+
+    /* ẍ = -2βẋ - ω0²x */
+    *velocity = hermite (s, table->step,
+                         v_a, -2 * self->beta * v_a - omega0_sq * x_a,
+                         v_b, -2 * self->beta * v_b - omega0_sq * x_b);
+  }
+
+  return TRUE;
+}
@@ -18,4 +18,7 @@ G_BEGIN_DECLS
 
 void adw_style_manager_ensure (void);
 
+guint    adw_style_manager_get_effective_max_animation_frame_rate (AdwStyleManager *self);
+gboolean adw_style_manager_get_effective_reduce_animation_cost    (AdwStyleManager *self);
+
 G_END_DECLS
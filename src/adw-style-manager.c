@@ -59,6 +59,9 @@ struct _AdwStyleManager
 
   GtkCssProvider *animations_provider;
   guint animation_timeout_id;
+
+  guint max_animation_frame_rate;
+  gboolean reduce_animation_cost;
 };
 
 G_DEFINE_FINAL_TYPE (AdwStyleManager, adw_style_manager, G_TYPE_OBJECT);
@@ -70,6 +73,8 @@ enum {
   PROP_SYSTEM_SUPPORTS_COLOR_SCHEMES,
   PROP_DARK,
   PROP_HIGH_CONTRAST,
+  PROP_MAX_ANIMATION_FRAME_RATE,
+  PROP_REDUCE_ANIMATION_COST,
   LAST_PROP,
 };
 
@@ -339,6 +344,14 @@ adw_style_manager_get_property (GObject    *object,
     g_value_set_boolean (value, adw_style_manager_get_high_contrast (self));
     break;
 
+  case PROP_MAX_ANIMATION_FRAME_RATE:
+    g_value_set_uint (value, adw_style_manager_get_max_animation_frame_rate (self));
+    break;
+
+  case PROP_REDUCE_ANIMATION_COST:
+    g_value_set_boolean (value, adw_style_manager_get_reduce_animation_cost (self));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -361,6 +374,14 @@ adw_style_manager_set_property (GObject      *object,
     adw_style_manager_set_color_scheme (self, g_value_get_enum (value));
     break;
 
+  case PROP_MAX_ANIMATION_FRAME_RATE:
+    adw_style_manager_set_max_animation_frame_rate (self, g_value_get_uint (value));
+    break;
+
+  case PROP_REDUCE_ANIMATION_COST:
+    adw_style_manager_set_reduce_animation_cost (self, g_value_get_boolean (value));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -471,6 +492,47 @@ adw_style_manager_class_init (AdwStyleManagerClass *klass)
                           FALSE,
                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdwStyleManager:max-animation-frame-rate: (attributes org.gtk.Property.get=adw_style_manager_get_max_animation_frame_rate org.gtk.Property.set=adw_style_manager_set_max_animation_frame_rate)
+   *
+   * The maximum rate at which animations are updated, in frames per second.
+   *
+   * Frames in between are skipped without computing new animation values. This
+   * can be used to reduce CPU usage on systems where rendering is expensive,
+   * such as with software rendering.
+   *
+   * If set to 0, animations are updated on every frame.
+   *
+   * The limit set on the default style manager applies to all displays. If both
+   * the default and a per-[class@Gdk.Display] style manager have a limit, the
+   * lower one is used. Individual animations can set a lower limit via
+   * [property@Animation:max-frame-rate].
+   *
+   * Since: 1.4
+   */
+  props[PROP_MAX_ANIMATION_FRAME_RATE] =
+    g_param_spec_uint ("max-animation-frame-rate", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwStyleManager:reduce-animation-cost: (attributes org.gtk.Property.get=adw_style_manager_get_reduce_animation_cost org.gtk.Property.set=adw_style_manager_set_reduce_animation_cost)
+   *
+   * Whether to skip non-essential animations in inactive windows.
+   *
+   * If set to `TRUE`, animations that don't have
+   * [property@Animation:essential] set are skipped when their window is in
+   * backdrop or minimized, same as they are when their widget is unmapped.
+   *
+   * Setting it on the default style manager applies it to all displays.
+   *
+   * Since: 1.4
+   */
+  props[PROP_REDUCE_ANIMATION_COST] =
+    g_param_spec_boolean ("reduce-animation-cost", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 }
 
@@ -715,3 +777,130 @@ adw_style_manager_get_high_contrast (AdwStyleManager *self)
 
   return adw_settings_get_high_contrast (self->settings);
 }
+
+/**
+ * adw_style_manager_get_max_animation_frame_rate: (attributes org.gtk.Method.get_property=max-animation-frame-rate)
+ * @self: a style manager
+ *
+ * Gets the maximum rate at which animations are updated.
+ *
+ * Returns: the maximum frame rate, or 0 if unlimited
+ *
+ * Since: 1.4
+ */
+guint
+adw_style_manager_get_max_animation_frame_rate (AdwStyleManager *self)
+{
+  g_return_val_if_fail (ADW_IS_STYLE_MANAGER (self), 0);
+
+  return self->max_animation_frame_rate;
+}
+
+/**
+ * adw_style_manager_set_max_animation_frame_rate: (attributes org.gtk.Method.set_property=max-animation-frame-rate)
+ * @self: a style manager
+ * @frame_rate: the maximum frame rate, or 0
+ *
+ * Sets the maximum rate at which animations are updated, in frames per second.
+ *
+ * Frames in between are skipped without computing new animation values. This
+ * can be used to reduce CPU usage on systems where rendering is expensive,
+ * such as with software rendering.
+ *
+ * If set to 0, animations are updated on every frame.
+ *
+ * The limit set on the default style manager applies to all displays. If both
+ * the default and a per-[class@Gdk.Display] style manager have a limit, the
+ * lower one is used. Individual animations can set a lower limit via
+ * [property@Animation:max-frame-rate].
+ *
+ * Since: 1.4
+ */
+void
+adw_style_manager_set_max_animation_frame_rate (AdwStyleManager *self,
+                                                guint            frame_rate)
+{
+  g_return_if_fail (ADW_IS_STYLE_MANAGER (self));
+
+  if (frame_rate == self->max_animation_frame_rate)
+    return;
+
+  self->max_animation_frame_rate = frame_rate;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_ANIMATION_FRAME_RATE]);
+}
+
+/**
+ * adw_style_manager_get_reduce_animation_cost: (attributes org.gtk.Method.get_property=reduce-animation-cost)
+ * @self: a style manager
+ *
+ * Gets whether to skip non-essential animations in inactive windows.
+ *
+ * Returns: whether to reduce animation cost
+ *
+ * Since: 1.4
+ */
+gboolean
+adw_style_manager_get_reduce_animation_cost (AdwStyleManager *self)
+{
+  g_return_val_if_fail (ADW_IS_STYLE_MANAGER (self), FALSE);
+
+  return self->reduce_animation_cost;
+}
+
+/**
+ * adw_style_manager_set_reduce_animation_cost: (attributes org.gtk.Method.set_property=reduce-animation-cost)
+ * @self: a style manager
+ * @reduce_animation_cost: whether to reduce animation cost
+ *
+ * Sets whether to skip non-essential animations in inactive windows.
+ *
+ * If set to `TRUE`, animations that don't have
+ * [property@Animation:essential] set are skipped when their window is in
+ * backdrop or minimized, same as they are when their widget is unmapped.
+ *
+ * Setting it on the default style manager applies it to all displays.
+ *
+ * Since: 1.4
+ */
+void
+adw_style_manager_set_reduce_animation_cost (AdwStyleManager *self,
+                                             gboolean         reduce_animation_cost)
+{
+  g_return_if_fail (ADW_IS_STYLE_MANAGER (self));
+
+  reduce_animation_cost = !!reduce_animation_cost;
+
+  if (reduce_animation_cost == self->reduce_animation_cost)
+    return;
+
+  self->reduce_animation_cost = reduce_animation_cost;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_REDUCE_ANIMATION_COST]);
+}
+
+/*
+ * Resolves the frame rate limit for animations on @self's display, taking the
+ * default style manager into account. Returns 0 if there's no limit.
+ */
+guint
+adw_style_manager_get_effective_max_animation_frame_rate (AdwStyleManager *self)
+{
+  guint rate = self->max_animation_frame_rate;
+
+  if (self->display && default_instance->max_animation_frame_rate > 0) {
+    if (rate == 0 || default_instance->max_animation_frame_rate < rate)
+      rate = default_instance->max_animation_frame_rate;
+  }
+
+  return rate;
+}
+
+gboolean
+adw_style_manager_get_effective_reduce_animation_cost (AdwStyleManager *self)
+{
+  if (self->reduce_animation_cost)
+    return TRUE;
+
+  return self->display && default_instance->reduce_animation_cost;
+}
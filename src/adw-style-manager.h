@@ -54,4 +54,16 @@ gboolean adw_style_manager_get_dark          (AdwStyleManager *self);
 ADW_AVAILABLE_IN_ALL
 gboolean adw_style_manager_get_high_contrast (AdwStyleManager *self);
 
+ADW_AVAILABLE_IN_1_4
+guint adw_style_manager_get_max_animation_frame_rate (AdwStyleManager *self);
+ADW_AVAILABLE_IN_1_4
+void  adw_style_manager_set_max_animation_frame_rate (AdwStyleManager *self,
+                                                      guint            frame_rate);
+
+ADW_AVAILABLE_IN_1_4
+gboolean adw_style_manager_get_reduce_animation_cost (AdwStyleManager *self);
+ADW_AVAILABLE_IN_1_4
+void     adw_style_manager_set_reduce_animation_cost (AdwStyleManager *self,
+                                                      gboolean         reduce_animation_cost);
+
 G_END_DECLS
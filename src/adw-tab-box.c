@@ -37,6 +37,8 @@
 
 #define MAX_TAB_WIDTH_NON_EXPAND 220
 
+#define MAX_RECYCLED_TABS 8
+
 #define FADE_OFFSET 6.0f
 #define FADE_WIDTH 36.0f
 
@@ -66,6 +68,8 @@ typedef struct {
   GtkWidget *container;
   GtkWidget *separator;
 
+  guint slot; /* Index in self->tabs */
+
   int final_pos;
   int final_width;
 
@@ -86,6 +90,12 @@ typedef struct {
   gulong notify_needs_attention_id;
 } TabInfo;
 
+typedef struct {
+  GtkWidget *container;
+  AdwTab *tab;
+  GtkWidget *separator;
+} TabWidgets;
+
 struct _AdwTabBox
 {
   GtkWidget parent_instance;
@@ -100,9 +110,18 @@ struct _AdwTabBox
   GtkEventController *view_drop_target;
   GtkGesture *drag_gesture;
 
-  GList *tabs;
+  /* Tabs are stored in order, each knows its own index and can be looked up
+   * by its page, so that finding a tab doesn't need to walk all of them */
+  GPtrArray *tabs;
+  GHashTable *page_tabs;
   int n_tabs;
 
+  /* Only tabs near the visible range have widgets, the rest only have their
+   * geometry. Widgets of tabs that scroll away are kept for reuse. */
+  int n_live_tabs;
+  GArray *recycled_tabs;
+  int tab_natural_width;
+
   GtkWidget *context_menu;
 
   int allocated_width;
@@ -194,15 +213,6 @@ static guint signals[SIGNAL_LAST_SIGNAL];
 
 /* Helpers */
 
-static void
-remove_and_free_tab_info (TabInfo *info)
-{
-  gtk_widget_unparent (GTK_WIDGET (info->container));
-  gtk_widget_unparent (GTK_WIDGET (info->separator));
-
-  g_free (info);
-}
-
 static inline int
 get_tab_position (AdwTabBox *self,
                   TabInfo   *info,
@@ -214,11 +224,83 @@ get_tab_position (AdwTabBox *self,
   return final ? info->final_pos : info->pos;
 }
 
+static inline TabInfo *
+get_nth_tab (AdwTabBox *self,
+             guint      index)
+{
+  return g_ptr_array_index (self->tabs, index);
+}
+
+static void
+update_tab_slots (AdwTabBox *self,
+                  guint      from,
+                  guint      to)
+{
+  guint i;
+
+  for (i = from; i < to; i++)
+    get_nth_tab (self, i)->slot = i;
+}
+
+static void
+insert_tab (AdwTabBox *self,
+            TabInfo   *info,
+            guint      index)
+{
+  g_ptr_array_insert (self->tabs, index, info);
+  update_tab_slots (self, index, self->tabs->len);
+
+  if (info->page)
+    g_hash_table_insert (self->page_tabs, info->page, info);
+}
+
+static void
+remove_tab (AdwTabBox *self,
+            TabInfo   *info)
+{
+  guint index = info->slot;
+
+  g_assert (get_nth_tab (self, index) == info);
+
+  if (info->page && g_hash_table_lookup (self->page_tabs, info->page) == info)
+    g_hash_table_remove (self->page_tabs, info->page);
+
+  g_ptr_array_remove_index (self->tabs, index);
+  update_tab_slots (self, index, self->tabs->len);
+}
+
+static void
+move_tab (AdwTabBox *self,
+          TabInfo   *info,
+          guint      index)
+{
+  guint old_index = info->slot;
+
+  g_ptr_array_remove_index (self->tabs, old_index);
+  g_ptr_array_insert (self->tabs, index, info);
+  update_tab_slots (self, MIN (old_index, index), MAX (old_index, index) + 1);
+}
+
+static void
+set_tab_page (AdwTabBox  *self,
+              TabInfo    *info,
+              AdwTabPage *page)
+{
+  if (info->page && g_hash_table_lookup (self->page_tabs, info->page) == info)
+    g_hash_table_remove (self->page_tabs, info->page);
+
+  info->page = page;
+
+  if (info->page)
+    g_hash_table_insert (self->page_tabs, info->page, info);
+}
+
 static inline TabInfo *
 find_tab_info_at (AdwTabBox *self,
                   double     x)
 {
-  GList *l;
+  gboolean is_rtl;
+  guint lower, upper, i;
 
   if (self->reordered_tab) {
     int pos = get_tab_position (self, self->reordered_tab, FALSE);
@@ -228,29 +310,32 @@ find_tab_info_at (AdwTabBox *self,
       return self->reordered_tab;
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  is_rtl = gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL;
 
-    if (info != self->reordered_tab &&
-        (G_APPROX_VALUE (info->pos, x, DBL_EPSILON) || info->pos < x) &&
-        x < info->pos + info->width)
-      return info;
-  }
+  /* Tab positions are running sums of the widths, shifted by at most the width
+   * of the reordered tab, so they stay sorted. Find the last tab that starts
+   * before x, it's the only one that can contain it along with its neighbors */
+  lower = 0;
+  upper = self->tabs->len;
 
-  return NULL;
-}
+  while (lower < upper) {
+    guint mid = lower + (upper - lower) / 2;
+    TabInfo *info = get_nth_tab (self, mid);
+    gboolean before = G_APPROX_VALUE (info->pos, x, DBL_EPSILON) || info->pos < x;
 
-static inline GList *
-find_link_for_page (AdwTabBox  *self,
-                    AdwTabPage *page)
-{
-  GList *l;
+    if (before != is_rtl)
+      lower = mid + 1;
+    else
+      upper = mid;
+  }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = lower > 1 ? lower - 2 : 0; i <= lower + 1 && i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    if (info->page == page)
-      return l;
+    if (info != self->reordered_tab &&
+        (G_APPROX_VALUE (info->pos, x, DBL_EPSILON) || info->pos < x) &&
+        x < info->pos + info->width)
+      return info;
   }
 
   return NULL;
@@ -260,28 +345,32 @@ static inline TabInfo *
 find_info_for_page (AdwTabBox  *self,
                     AdwTabPage *page)
 {
-  GList *l = find_link_for_page (self, page);
-
-  return l ? l->data : NULL;
+  return g_hash_table_lookup (self->page_tabs, page);
 }
 
-static GList *
+/* Returns the index in self->tabs to insert a tab for the page at @position
+ * at, skipping closing tabs */
+static guint
 find_nth_alive_tab (AdwTabBox *self,
                     guint      position)
 {
-  GList *l;
+  guint i;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  /* No tabs are closing, so every tab has a page */
+  if (g_hash_table_size (self->page_tabs) == self->tabs->len)
+    return MIN (position, self->tabs->len);
+
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (!info->page)
         continue;
 
     if (!position--)
-        return l;
+        return i;
   }
 
-  return NULL;
+  return self->tabs->len;
 }
 
 static inline int
@@ -299,7 +388,7 @@ get_base_tab_width (AdwTabBox *self,
   double max_progress = 0;
   double n = 0;
   double used_width;
-  GList *l;
+  guint i;
   int ret;
   int end_padding = 0;
 
@@ -310,8 +399,8 @@ get_base_tab_width (AdwTabBox *self,
     if (!target_end_padding)
       end_padding = self->final_end_padding;
   } else {
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       max_progress = MAX (max_progress, info->appear_progress);
       n += info->appear_progress;
@@ -331,6 +420,19 @@ get_base_tab_width (AdwTabBox *self,
   return ret;
 }
 
+static int
+get_tab_natural_width (AdwTabBox *self,
+                       TabInfo   *info)
+{
+  /* All tabs have the same natural width, so tabs without widgets can reuse
+   * the last measured one */
+  if (info->container)
+    gtk_widget_measure (info->container, GTK_ORIENTATION_HORIZONTAL, -1,
+                        NULL, &self->tab_natural_width, NULL, NULL);
+
+  return self->tab_natural_width;
+}
+
 static int
 predict_tab_width (AdwTabBox *self,
                    TabInfo   *info,
@@ -351,8 +453,7 @@ predict_tab_width (AdwTabBox *self,
   width -= SPACING * (n + 1) + self->end_padding;
 
   /* Tabs have 0 minimum width, we need natural width instead */
-  gtk_widget_measure (GTK_WIDGET (info->container), GTK_ORIENTATION_HORIZONTAL, -1,
-                      NULL, &min, NULL, NULL);
+  min = get_tab_natural_width (self, info);
 
   if (self->expand_tabs)
     return MAX ((int) floor (width / (double) n), min);
@@ -421,7 +522,7 @@ is_touchscreen (GtkGesture *gesture)
 static void
 update_separators (AdwTabBox *self)
 {
-  GList *l;
+  guint i;
   GtkStateFlags mask = GTK_STATE_FLAG_PRELIGHT |
                        GTK_STATE_FLAG_ACTIVE |
                        GTK_STATE_FLAG_SELECTED;
@@ -432,15 +533,13 @@ update_separators (AdwTabBox *self)
   if (!self->pinned) {
     AdwTabBox *box = adw_tab_bar_get_pinned_tab_box (self->tab_bar);
 
-    l = g_list_last (box->tabs);
-
-    if (l) {
-      last_pinned_tab = l->data;
+    if (box->tabs->len) {
+      last_pinned_tab = get_nth_tab (box, box->tabs->len - 1);
 
       if (last_pinned_tab->end_reorder_offset < 0) {
         last_pinned_tab = box->reordered_tab;
-      } else if (l->prev && last_pinned_tab == box->reordered_tab) {
-        TabInfo *prev = l->prev->data;
+      } else if (box->tabs->len > 1 && last_pinned_tab == box->reordered_tab) {
+        TabInfo *prev = get_nth_tab (box, box->tabs->len - 2);
 
         if (prev->end_reorder_offset > 0)
           last_pinned_tab = prev;
@@ -448,20 +547,23 @@ update_separators (AdwTabBox *self)
     }
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     TabInfo *prev = NULL;
     TabInfo *prev_prev = NULL;
     TabInfo *visually_prev = NULL;
     GtkStateFlags flags;
 
-    if (l->prev)
-      prev = l->prev->data;
+    if (!info->separator)
+      continue;
+
+    if (i > 0)
+      prev = get_nth_tab (self, i - 1);
     else if (!self->pinned)
       prev = last_pinned_tab;
 
-    if (l->prev && l->prev->prev)
-      prev_prev = l->prev->prev->data;
+    if (i > 1)
+      prev_prev = get_nth_tab (self, i - 2);
     else if (!self->pinned)
       prev_prev = last_pinned_tab;
 
@@ -487,7 +589,7 @@ update_separators (AdwTabBox *self)
 
     flags = gtk_widget_get_state_flags (GTK_WIDGET (info->tab));
 
-    if (visually_prev)
+    if (visually_prev && visually_prev->tab)
       flags |= gtk_widget_get_state_flags (GTK_WIDGET (visually_prev->tab));
 
     if ((flags & mask) || !visually_prev)
@@ -505,6 +607,288 @@ update_separators (AdwTabBox *self)
   }
 }
 
+/* Tab widgets */
+
+static gboolean
+extra_drag_drop_cb (AdwTab    *tab,
+                    GValue    *value,
+                    AdwTabBox *self)
+{
+  gboolean ret = GDK_EVENT_PROPAGATE;
+  AdwTabPage *page = adw_tab_get_page (tab);
+
+  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_DROP], 0, page, value, &ret);
+
+  return ret;
+}
+
+static GdkDragAction
+extra_drag_value_cb (AdwTab    *tab,
+                     GValue    *value,
+                     AdwTabBox *self)
+{
+  GdkDragAction preferred_action;
+  AdwTabPage *page = adw_tab_get_page (tab);
+
+  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_VALUE], 0, page, value, &preferred_action);
+
+  return preferred_action;
+}
+
+static void
+measure_tab (AdwGizmo       *widget,
+             GtkOrientation  orientation,
+             int             for_size,
+             int            *minimum,
+             int            *natural,
+             int            *minimum_baseline,
+             int            *natural_baseline)
+{
+  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
+
+  gtk_widget_measure (child, orientation, for_size,
+                      minimum, natural,
+                      minimum_baseline,  natural_baseline);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL && minimum)
+    *minimum = 0;
+}
+
+static void
+allocate_tab (AdwGizmo *widget,
+              int       width,
+              int       height,
+              int       baseline)
+{
+  TabInfo *info = g_object_get_data (G_OBJECT (widget), "info");
+  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
+  int allocated_width = gtk_widget_get_allocated_width (GTK_WIDGET (widget));
+  int width_diff = MAX (0, info->final_width - allocated_width);
+
+  gtk_widget_allocate (child, width + width_diff, height, baseline,
+                       gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (-width_diff / 2, 0)));
+}
+
+static void
+state_flags_changed_cb (GtkWidget     *tab,
+                        GtkStateFlags  previous,
+                        AdwTabBox     *self)
+{
+  GtkStateFlags flags = gtk_widget_get_state_flags (tab);
+  GtkStateFlags mask = GTK_STATE_FLAG_PRELIGHT |
+                       GTK_STATE_FLAG_ACTIVE |
+                       GTK_STATE_FLAG_SELECTED;
+
+  if ((flags ^ previous) & mask)
+    update_separators (self);
+}
+
+static void
+create_tab_widgets (AdwTabBox  *self,
+                    TabWidgets *widgets)
+{
+  widgets->container = adw_gizmo_new ("tabboxchild", measure_tab, allocate_tab,
+                                      NULL, NULL,
+                                      (AdwGizmoFocusFunc) adw_widget_focus_child,
+                                      (AdwGizmoGrabFocusFunc) adw_widget_grab_focus_self);
+  widgets->tab = adw_tab_new (self->view, self->pinned);
+
+  gtk_widget_set_overflow (widgets->container, GTK_OVERFLOW_HIDDEN);
+  gtk_widget_set_focusable (widgets->container, TRUE);
+
+  widgets->separator = gtk_separator_new (GTK_ORIENTATION_VERTICAL);
+  gtk_widget_set_can_target (widgets->separator, FALSE);
+
+  gtk_widget_set_parent (GTK_WIDGET (widgets->tab), widgets->container);
+
+  g_signal_connect_object (widgets->tab, "extra-drag-drop", G_CALLBACK (extra_drag_drop_cb), self, 0);
+  g_signal_connect_object (widgets->tab, "extra-drag-value", G_CALLBACK (extra_drag_value_cb), self, 0);
+  g_signal_connect_object (widgets->tab, "state-flags-changed", G_CALLBACK (state_flags_changed_cb), self, 0);
+}
+
+static void
+tab_widgets_clear (TabWidgets *widgets)
+{
+  gtk_widget_unparent (widgets->container);
+  gtk_widget_unparent (widgets->separator);
+}
+
+static void
+clear_recycled_tabs (AdwTabBox *self)
+{
+  guint i;
+
+  for (i = 0; i < self->recycled_tabs->len; i++)
+    tab_widgets_clear (&g_array_index (self->recycled_tabs, TabWidgets, i));
+
+  g_array_set_size (self->recycled_tabs, 0);
+}
+
+static void
+ensure_tab_widgets (AdwTabBox *self,
+                    TabInfo   *info)
+{
+  TabWidgets widgets;
+  GtkWidget *sibling;
+
+  if (info->container)
+    return;
+
+  if (self->recycled_tabs->len > 0) {
+    guint last = self->recycled_tabs->len - 1;
+
+    widgets = g_array_index (self->recycled_tabs, TabWidgets, last);
+    g_array_remove_index (self->recycled_tabs, last);
+
+    gtk_widget_set_child_visible (widgets.container, TRUE);
+    gtk_widget_set_child_visible (widgets.separator, TRUE);
+  } else {
+    create_tab_widgets (self, &widgets);
+  }
+
+  info->container = widgets.container;
+  info->tab = widgets.tab;
+  info->separator = widgets.separator;
+
+  g_object_set_data (G_OBJECT (info->container), "info", info);
+
+  adw_tab_set_page (info->tab, info->page);
+  adw_tab_set_inverted (info->tab, self->inverted);
+  adw_tab_setup_extra_drop_target (info->tab,
+                                   self->extra_drag_actions,
+                                   self->extra_drag_types,
+                                   self->extra_drag_n_types);
+  adw_tab_set_extra_drag_preload (info->tab, self->extra_drag_preload);
+
+  /* The reordered tab must stay above everything else */
+  if (self->reordered_tab && self->reordered_tab->container)
+    sibling = self->reordered_tab->separator;
+  else
+    sibling = self->needs_attention_left;
+
+  gtk_widget_insert_before (info->separator, GTK_WIDGET (self), sibling);
+  gtk_widget_insert_before (info->container, GTK_WIDGET (self), sibling);
+
+  self->n_live_tabs++;
+
+  get_tab_natural_width (self, info);
+}
+
+static void
+release_tab_widgets (AdwTabBox *self,
+                     TabInfo   *info)
+{
+  TabWidgets widgets;
+
+  if (!info->container)
+    return;
+
+  widgets.container = info->container;
+  widgets.tab = info->tab;
+  widgets.separator = info->separator;
+
+  info->container = NULL;
+  info->tab = NULL;
+  info->separator = NULL;
+
+  self->n_live_tabs--;
+
+  g_object_set_data (G_OBJECT (widgets.container), "info", NULL);
+  adw_tab_set_page (widgets.tab, NULL);
+
+  if (self->recycled_tabs->len >= MAX_RECYCLED_TABS) {
+    tab_widgets_clear (&widgets);
+
+    return;
+  }
+
+  gtk_widget_set_opacity (widgets.container, 1);
+  adw_tab_set_dragging (widgets.tab, FALSE);
+
+  gtk_widget_set_child_visible (widgets.container, FALSE);
+  gtk_widget_set_child_visible (widgets.separator, FALSE);
+
+  g_array_append_val (self->recycled_tabs, widgets);
+}
+
+static void
+remove_and_free_tab_info (TabInfo *info)
+{
+  release_tab_widgets (info->box, info);
+
+  g_free (info);
+}
+
+static gboolean
+should_keep_tab_widgets (AdwTabBox *self,
+                         TabInfo   *info)
+{
+  if (info == self->selected_tab ||
+      info == self->pressed_tab ||
+      info == self->reordered_tab ||
+      info == self->reorder_placeholder ||
+      info == self->drop_target_tab)
+    return TRUE;
+
+  return info->container &&
+         gtk_widget_get_focus_child (GTK_WIDGET (self)) == info->container;
+}
+
+/* This runs during allocation, the same way as GtkListView creates its rows,
+ * so new tabs have to be measured here before they are allocated */
+static void
+update_live_tabs (AdwTabBox *self,
+                  double     value,
+                  int        page_size)
+{
+  gboolean changed = FALSE;
+  int lower, upper;
+  guint i;
+
+  /* Keep half a page of tabs around the visible range, so that short scrolls
+   * don't need to create any widgets */
+  lower = (int) floor (value) - page_size / 2;
+  upper = (int) ceil (value) + page_size + page_size / 2;
+
+  /* Release widgets first so that they can be reused right away. Always keep
+   * at least one tab alive, it's used for measuring */
+  for (i = 0; i < self->tabs->len && self->n_live_tabs > 1; i++) {
+    TabInfo *info = get_nth_tab (self, i);
+    int pos;
+
+    if (!info->container || should_keep_tab_widgets (self, info))
+      continue;
+
+    pos = get_tab_position (self, info, FALSE);
+
+    if (pos + MAX (0, info->width) < lower || pos > upper) {
+      release_tab_widgets (self, info);
+      changed = TRUE;
+    }
+  }
+
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
+    int pos;
+
+    if (info->container)
+      continue;
+
+    pos = get_tab_position (self, info, FALSE);
+
+    if (pos + MAX (0, info->width) >= lower && pos <= upper) {
+      /* This measures the width as well */
+      ensure_tab_widgets (self, info);
+      gtk_widget_measure (info->container, GTK_ORIENTATION_VERTICAL,
+                          MAX (0, info->width), NULL, NULL, NULL, NULL);
+      changed = TRUE;
+    }
+  }
+
+  if (changed)
+    update_separators (self);
+}
+
 /* Single tab style */
 
 static void
@@ -533,12 +917,12 @@ resize_animation_value_cb (double     value,
 
   if (!self->expand_tabs) {
     int predicted_tab_width = get_base_tab_width (self, TRUE, FALSE);
-    GList *l;
+    guint i;
 
     target_end_padding = self->allocated_width - SPACING;
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       target_end_padding -= calculate_tab_width (info, predicted_tab_width) + SPACING;
     }
@@ -569,12 +953,12 @@ set_tab_resize_mode (AdwTabBox     *self,
     return;
 
   if (mode == TAB_RESIZE_FIXED_TAB_WIDTH) {
-    GList *l;
+    guint i;
 
     self->last_width = self->allocated_width;
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       if (info->appear_animation)
         info->last_width = info->final_width;
@@ -758,7 +1142,9 @@ activate_tab (AdwTabBox *self)
 
   child = adw_tab_page_get_child (self->selected_tab->page);
 
-  gtk_widget_grab_focus (child);
+  /* The factory of a lazy page may have failed to create it */
+  if (child)
+    gtk_widget_grab_focus (child);
 }
 
 /* Scrolling */
@@ -767,7 +1153,7 @@ static void
 update_visible (AdwTabBox *self)
 {
   gboolean left = FALSE, right = FALSE;
-  GList *l;
+  guint i;
   double value, page_size;
 
   if (!self->adjustment)
@@ -779,8 +1165,8 @@ update_visible (AdwTabBox *self)
   if (!self->adjustment)
       return;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     int pos;
 
     if (!info->page)
@@ -788,11 +1174,18 @@ update_visible (AdwTabBox *self)
 
     pos = get_tab_position (self, info, FALSE);
 
-    adw_tab_set_fully_visible (info->tab,
-                               (G_APPROX_VALUE (pos - SPACING, value, DBL_EPSILON) ||
-                                pos - SPACING > value) &&
-                               (G_APPROX_VALUE (pos + info->width + SPACING, value + page_size, DBL_EPSILON) ||
-                                pos + info->width + SPACING < value + page_size));
+    if (info->tab) {
+      adw_tab_set_fully_visible (info->tab,
+                                 (G_APPROX_VALUE (pos - SPACING, value, DBL_EPSILON) ||
+                                  pos - SPACING > value) &&
+                                 (G_APPROX_VALUE (pos + info->width + SPACING, value + page_size, DBL_EPSILON) ||
+                                  pos + info->width + SPACING < value + page_size));
+
+      /* Tabs that are scrolled away don't need to animate their spinners */
+      adw_tab_set_onscreen (info->tab,
+                            pos + info->width > value &&
+                            pos < value + page_size);
+    }
 
     if (!adw_tab_page_get_needs_attention (info->page))
       continue;
@@ -1040,7 +1433,7 @@ set_hadjustment (AdwTabBox     *self,
 static void
 force_end_reordering (AdwTabBox *self)
 {
-  GList *l;
+  guint i;
 
   if (self->dragging || !self->reordered_tab)
     return;
@@ -1048,8 +1441,8 @@ force_end_reordering (AdwTabBox *self)
   if (self->reorder_animation)
     adw_animation_skip (self->reorder_animation);
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (info->reorder_animation)
       adw_animation_skip (info->reorder_animation);
@@ -1059,7 +1452,7 @@ force_end_reordering (AdwTabBox *self)
 static void
 check_end_reordering (AdwTabBox *self)
 {
-  GList *l;
+  guint i;
 
   if (self->dragging || !self->reordered_tab || self->continue_reorder)
     return;
@@ -1067,15 +1460,15 @@ check_end_reordering (AdwTabBox *self)
   if (self->reorder_animation)
     return;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (info->reorder_animation)
       return;
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     info->end_reorder_offset = 0;
     info->reorder_offset = 0;
@@ -1083,8 +1476,7 @@ check_end_reordering (AdwTabBox *self)
 
   self->reordered_tab->reorder_ignore_bounds = FALSE;
 
-  self->tabs = g_list_remove (self->tabs, self->reordered_tab);
-  self->tabs = g_list_insert (self->tabs, self->reordered_tab, self->reorder_index);
+  move_tab (self, self->reordered_tab, self->reorder_index);
 
   gtk_widget_queue_allocate (GTK_WIDGET (self));
 
@@ -1097,6 +1489,8 @@ static void
 start_reordering (AdwTabBox *self,
                   TabInfo   *info)
 {
+  ensure_tab_widgets (self, info);
+
   self->reordered_tab = info;
 
   /* The reordered tab should be displayed above everything else */
@@ -1227,25 +1621,19 @@ static void
 reset_reorder_animations (AdwTabBox *self)
 {
   int i, original_index;
-  GList *l;
 
   if (!adw_get_enable_animations (GTK_WIDGET (self)))
       return;
 
-  l = find_link_for_page (self, self->reordered_tab->page);
-  original_index = g_list_position (self->tabs, l);
+  original_index = self->reordered_tab->slot;
 
   if (self->reorder_index > original_index)
-    for (i = 0; i < self->reorder_index - original_index; i++) {
-      l = l->next;
-      animate_reorder_offset (self, l->data, 0);
-    }
+    for (i = original_index + 1; i <= self->reorder_index; i++)
+      animate_reorder_offset (self, get_nth_tab (self, i), 0);
 
   if (self->reorder_index < original_index)
-    for (i = 0; i < original_index - self->reorder_index; i++) {
-      l = l->prev;
-      animate_reorder_offset (self, l->data, 0);
-    }
+    for (i = self->reorder_index; i < original_index; i++)
+      animate_reorder_offset (self, get_nth_tab (self, i), 0);
 
   update_separators (self);
 }
@@ -1255,7 +1643,6 @@ page_reordered_cb (AdwTabBox  *self,
                    AdwTabPage *page,
                    int         index)
 {
-  GList *link;
   int original_index;
   TabInfo *info, *dest_tab;
   gboolean is_rtl;
@@ -1263,6 +1650,25 @@ page_reordered_cb (AdwTabBox  *self,
   if (adw_tab_page_get_pinned (page) != self->pinned)
     return;
 
+  if (adw_tab_view_get_is_batching (self->view) && !self->dragging) {
+    self->continue_reorder = FALSE;
+    force_end_reordering (self);
+
+    if (!self->pinned)
+      index -= adw_tab_view_get_n_pinned_pages (self->view);
+
+    /* Several pages are being moved, skip the animation */
+    info = find_info_for_page (self, page);
+
+    remove_tab (self, info);
+    insert_tab (self, info, find_nth_alive_tab (self, index));
+
+    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    update_separators (self);
+
+    return;
+  }
+
   self->continue_reorder = self->reordered_tab && page == self->reordered_tab->page;
 
   if (self->continue_reorder)
@@ -1270,9 +1676,8 @@ page_reordered_cb (AdwTabBox  *self,
   else
     force_end_reordering (self);
 
-  link = find_link_for_page (self, page);
-  info = link->data;
-  original_index = g_list_position (self->tabs, link);
+  info = find_info_for_page (self, page);
+  original_index = info->slot;
 
   if (!self->continue_reorder)
     start_reordering (self, info);
@@ -1287,7 +1692,7 @@ page_reordered_cb (AdwTabBox  *self,
   if (!self->pinned)
     self->reorder_index -= adw_tab_view_get_n_pinned_pages (self->view);
 
-  dest_tab = g_list_nth_data (self->tabs, self->reorder_index);
+  dest_tab = get_nth_tab (self, self->reorder_index);
 
   if (info == self->selected_tab)
     scroll_to_tab_full (self, self->selected_tab, dest_tab->final_pos, REORDER_ANIMATION_DURATION, FALSE);
@@ -1306,16 +1711,12 @@ page_reordered_cb (AdwTabBox  *self,
     int i;
 
     if (self->reorder_index > original_index)
-      for (i = 0; i < self->reorder_index - original_index; i++) {
-        link = link->next;
-        animate_reorder_offset (self, link->data, is_rtl ? 1 : -1);
-      }
+      for (i = original_index + 1; i <= self->reorder_index; i++)
+        animate_reorder_offset (self, get_nth_tab (self, i), is_rtl ? 1 : -1);
 
     if (self->reorder_index < original_index)
-      for (i = 0; i < original_index - self->reorder_index; i++) {
-        link = link->prev;
-        animate_reorder_offset (self, link->data, is_rtl ? -1 : 1);
-      }
+      for (i = self->reorder_index; i < original_index; i++)
+        animate_reorder_offset (self, get_nth_tab (self, i), is_rtl ? -1 : 1);
   }
 
   self->continue_reorder = FALSE;
@@ -1323,15 +1724,25 @@ page_reordered_cb (AdwTabBox  *self,
   update_separators (self);
 }
 
+static inline int
+get_unshifted_center (TabInfo  *info,
+                      gboolean  is_rtl)
+{
+  if (is_rtl)
+    return info->unshifted_pos - info->final_width / 2;
+  else
+    return info->unshifted_pos + info->final_width / 2;
+}
+
 static void
 update_drag_reodering (AdwTabBox *self)
 {
   gboolean is_rtl;
-  int old_index = -1, new_index = -1;
+  int old_index, new_index = -1;
   int x;
-  int i = 0;
+  int i;
   int width;
-  GList *l;
+  guint lower, upper;
 
   if (!self->dragging)
     return;
@@ -1346,34 +1757,41 @@ update_drag_reodering (AdwTabBox *self)
 
   is_rtl = gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
-    int center;
+  old_index = self->reordered_tab->slot;
+
+  /* Unshifted positions are sorted, so look for the first tab whose center is
+   * past the start of the reordered tab, or its end for RTL */
+  lower = 0;
+  upper = self->tabs->len;
+
+  while (lower < upper) {
+    guint mid = lower + (upper - lower) / 2;
+    int center = get_unshifted_center (get_nth_tab (self, mid), is_rtl);
+    gboolean past;
 
     if (is_rtl)
-      center = info->unshifted_pos - info->final_width / 2;
+      past = x + width + SPACING > center;
     else
-      center = info->unshifted_pos + info->final_width / 2;
+      past = center > x - SPACING;
 
-    if (info == self->reordered_tab)
-      old_index = i;
-
-    if (x + width + SPACING > center && center > x - SPACING && new_index < 0)
-      new_index = i;
+    if (past)
+      upper = mid;
+    else
+      lower = mid + 1;
+  }
 
-    if (old_index >= 0 && new_index >= 0)
-      break;
+  if (lower < self->tabs->len) {
+    int center = get_unshifted_center (get_nth_tab (self, lower), is_rtl);
 
-    i++;
+    if (x + width + SPACING > center && center > x - SPACING)
+      new_index = lower;
   }
 
   if (new_index < 0)
-    new_index = g_list_length (self->tabs) - 1;
+    new_index = self->tabs->len - 1;
 
-  i = 0;
-
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     double offset = 0;
 
     if (i > old_index && i <= new_index)
@@ -1382,8 +1800,6 @@ update_drag_reodering (AdwTabBox *self)
     if (i < old_index && i >= new_index)
       offset = is_rtl ? -1 : 1;
 
-    i++;
-
     animate_reorder_offset (self, info, offset);
   }
 
@@ -1405,14 +1821,10 @@ drag_autoscroll_cb (GtkWidget     *widget,
   int autoscroll_area = 0;
 
   if (self->reordered_tab) {
-    gtk_widget_measure (self->reordered_tab->container,
-                        GTK_ORIENTATION_HORIZONTAL, -1,
-                        NULL, &tab_width, NULL, NULL);
+    tab_width = get_tab_natural_width (self, self->reordered_tab);
     x = (double) self->reorder_x - SPACING;
   } else if (self->drop_target_tab) {
-    gtk_widget_measure (self->drop_target_tab->container,
-                        GTK_ORIENTATION_HORIZONTAL, -1,
-                        NULL, &tab_width, NULL, NULL);
+    tab_width = get_tab_natural_width (self, self->drop_target_tab);
     x = (double) self->drop_target_x - tab_width / 2;
   } else {
     return G_SOURCE_CONTINUE;
@@ -1532,7 +1944,7 @@ end_drag_reodering (AdwTabBox *self)
 
   end_autoscroll (self);
 
-  dest_tab = g_list_nth_data (self->tabs, self->reorder_index);
+  dest_tab = get_nth_tab (self, self->reorder_index);
 
   if (!self->indirect_reordering) {
     int index = self->reorder_index;
@@ -1713,6 +2125,8 @@ select_page (AdwTabBox  *self,
     return;
   }
 
+  ensure_tab_widgets (self, self->selected_tab);
+
   if (adw_tab_bar_tabs_have_visible_focus (self->tab_bar))
     gtk_widget_grab_focus (self->selected_tab->container);
 
@@ -1725,32 +2139,6 @@ select_page (AdwTabBox  *self,
 
 /* Opening */
 
-static gboolean
-extra_drag_drop_cb (AdwTab    *tab,
-                    GValue    *value,
-                    AdwTabBox *self)
-{
-  gboolean ret = GDK_EVENT_PROPAGATE;
-  AdwTabPage *page = adw_tab_get_page (tab);
-
-  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_DROP], 0, page, value, &ret);
-
-  return ret;
-}
-
-static GdkDragAction
-extra_drag_value_cb (AdwTab    *tab,
-                     GValue    *value,
-                     AdwTabBox *self)
-{
-  GdkDragAction preferred_action;
-  AdwTabPage *page = adw_tab_get_page (tab);
-
-  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_VALUE], 0, page, value, &preferred_action);
-
-  return preferred_action;
-}
-
 static void
 appear_animation_value_cb (double   value,
                            TabInfo *info)
@@ -1759,6 +2147,8 @@ appear_animation_value_cb (double   value,
 
   if (GTK_IS_WIDGET (info->container))
     gtk_widget_queue_resize (info->container);
+  else
+    gtk_widget_queue_resize (GTK_WIDGET (info->box));
 }
 
 static void
@@ -1767,54 +2157,6 @@ open_animation_done_cb (TabInfo *info)
   g_clear_object (&info->appear_animation);
 }
 
-static void
-measure_tab (AdwGizmo       *widget,
-             GtkOrientation  orientation,
-             int             for_size,
-             int            *minimum,
-             int            *natural,
-             int            *minimum_baseline,
-             int            *natural_baseline)
-{
-  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
-
-  gtk_widget_measure (child, orientation, for_size,
-                      minimum, natural,
-                      minimum_baseline,  natural_baseline);
-
-  if (orientation == GTK_ORIENTATION_HORIZONTAL && minimum)
-    *minimum = 0;
-}
-
-static void
-allocate_tab (AdwGizmo *widget,
-              int       width,
-              int       height,
-              int       baseline)
-{
-  TabInfo *info = g_object_get_data (G_OBJECT (widget), "info");
-  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
-  int allocated_width = gtk_widget_get_allocated_width (GTK_WIDGET (widget));
-  int width_diff = MAX (0, info->final_width - allocated_width);
-
-  gtk_widget_allocate (child, width + width_diff, height, baseline,
-                       gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (-width_diff / 2, 0)));
-}
-
-static void
-state_flags_changed_cb (GtkWidget     *tab,
-                        GtkStateFlags  previous,
-                        AdwTabBox     *self)
-{
-  GtkStateFlags flags = gtk_widget_get_state_flags (tab);
-  GtkStateFlags mask = GTK_STATE_FLAG_PRELIGHT |
-                       GTK_STATE_FLAG_ACTIVE |
-                       GTK_STATE_FLAG_SELECTED;
-
-  if ((flags ^ previous) & mask)
-    update_separators (self);
-}
-
 static TabInfo *
 create_tab_info (AdwTabBox  *self,
                  AdwTabPage *page)
@@ -1827,34 +2169,6 @@ create_tab_info (AdwTabBox  *self,
   info->unshifted_pos = -1;
   info->pos = -1;
   info->width = -1;
-  info->container = adw_gizmo_new ("tabboxchild", measure_tab, allocate_tab,
-                                   NULL, NULL,
-                                   (AdwGizmoFocusFunc) adw_widget_focus_child,
-                                   (AdwGizmoGrabFocusFunc) adw_widget_grab_focus_self);
-  info->tab = adw_tab_new (self->view, self->pinned);
-
-  g_object_set_data (G_OBJECT (info->container), "info", info);
-  gtk_widget_set_overflow (info->container, GTK_OVERFLOW_HIDDEN);
-  gtk_widget_set_focusable (info->container, TRUE);
-
-  adw_tab_set_page (info->tab, page);
-  adw_tab_set_inverted (info->tab, self->inverted);
-  adw_tab_setup_extra_drop_target (info->tab,
-                                   self->extra_drag_actions,
-                                   self->extra_drag_types,
-                                   self->extra_drag_n_types);
-  adw_tab_set_extra_drag_preload (info->tab, self->extra_drag_preload);
-
-  info->separator = gtk_separator_new (GTK_ORIENTATION_VERTICAL);
-  gtk_widget_set_can_target (info->separator, FALSE);
-
-  gtk_widget_set_parent (GTK_WIDGET (info->tab), info->container);
-  gtk_widget_insert_before (info->separator, GTK_WIDGET (self), self->needs_attention_left);
-  gtk_widget_insert_before (info->container, GTK_WIDGET (self), self->needs_attention_left);
-
-  g_signal_connect_object (info->tab, "extra-drag-drop", G_CALLBACK (extra_drag_drop_cb), self, 0);
-  g_signal_connect_object (info->tab, "extra-drag-value", G_CALLBACK (extra_drag_value_cb), self, 0);
-  g_signal_connect_object (info->tab, "state-flags-changed", G_CALLBACK (state_flags_changed_cb), self, 0);
 
   return info;
 }
@@ -1866,7 +2180,6 @@ page_attached_cb (AdwTabBox  *self,
 {
   AdwAnimationTarget *target;
   TabInfo *info;
-  GList *l;
 
   if (adw_tab_page_get_pinned (page) != self->pinned)
     return;
@@ -1879,6 +2192,10 @@ page_attached_cb (AdwTabBox  *self,
 
   info = create_tab_info (self, page);
 
+  /* Make sure there's always a tab to measure */
+  if (!self->n_live_tabs)
+    ensure_tab_widgets (self, info);
+
   info->notify_needs_attention_id =
     g_signal_connect_object (page,
                              "notify::needs-attention",
@@ -1886,26 +2203,30 @@ page_attached_cb (AdwTabBox  *self,
                              self,
                              G_CONNECT_SWAPPED);
 
-  target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
-                                              appear_animation_value_cb,
-                                              info, NULL);
-  info->appear_animation =
-    adw_timed_animation_new (GTK_WIDGET (self), 0, 1,
-                             OPEN_ANIMATION_DURATION, target);
+  insert_tab (self, info, find_nth_alive_tab (self, position));
 
-  g_signal_connect_swapped (info->appear_animation, "done",
-                            G_CALLBACK (open_animation_done_cb), info);
+  self->n_tabs++;
 
-  l = find_nth_alive_tab (self, position);
-  self->tabs = g_list_insert_before (self->tabs, l, info);
+  if (adw_tab_view_get_is_batching (self->view)) {
+    /* Several pages are being added, skip the animation */
+    appear_animation_value_cb (1, info);
+  } else {
+    target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
+                                                appear_animation_value_cb,
+                                                info, NULL);
+    info->appear_animation =
+      adw_timed_animation_new (GTK_WIDGET (self), 0, 1,
+                               OPEN_ANIMATION_DURATION, target);
 
-  self->n_tabs++;
+    g_signal_connect_swapped (info->appear_animation, "done",
+                              G_CALLBACK (open_animation_done_cb), info);
 
-  adw_animation_play (info->appear_animation);
+    adw_animation_play (info->appear_animation);
+  }
 
   if (page == adw_tab_view_get_selected_page (self->view))
     adw_tab_box_select_page (self, page);
-  else
+  else if (!adw_tab_view_get_is_batching (self->view))
     scroll_to_tab_full (self, info, -1, OPEN_ANIMATION_DURATION, TRUE);
 
   update_separators (self);
@@ -1920,7 +2241,7 @@ close_animation_done_cb (TabInfo *info)
 
   g_clear_object (&info->appear_animation);
 
-  self->tabs = g_list_remove (self->tabs, info);
+  remove_tab (self, info);
 
   if (info->reorder_animation)
     adw_animation_skip (info->reorder_animation);
@@ -1947,26 +2268,20 @@ page_detached_cb (AdwTabBox  *self,
 {
   AdwAnimationTarget *target;
   TabInfo *info;
-  GList *page_link;
 
-  page_link = find_link_for_page (self, page);
+  info = find_info_for_page (self, page);
 
-  if (!page_link)
+  if (!info)
     return;
 
-  info = page_link->data;
-  page_link = page_link->next;
-
   force_end_reordering (self);
 
   if (self->hovering && !self->pinned) {
     gboolean is_last = TRUE;
+    guint i;
 
-    while (page_link) {
-      TabInfo *i = page_link->data;
-      page_link = page_link->next;
-
-      if (i->page) {
+    for (i = info->slot + 1; i < self->tabs->len; i++) {
+      if (get_nth_tab (self, i)->page) {
         is_last = FALSE;
         break;
       }
@@ -1980,24 +2295,33 @@ page_detached_cb (AdwTabBox  *self,
 
   g_assert (info->page);
 
-  if (gtk_widget_is_focus (info->container))
+  if (info->container && gtk_widget_is_focus (info->container))
     adw_tab_box_try_focus_selected_tab (self);
 
   if (info == self->selected_tab)
     adw_tab_box_select_page (self, NULL);
 
-  adw_tab_set_page (info->tab, NULL);
+  if (info->tab)
+    adw_tab_set_page (info->tab, NULL);
 
   if (info->notify_needs_attention_id > 0) {
     g_signal_handler_disconnect (info->page, info->notify_needs_attention_id);
     info->notify_needs_attention_id = 0;
   }
 
-  info->page = NULL;
+  set_tab_page (self, info, NULL);
 
   if (info->appear_animation)
     adw_animation_skip (info->appear_animation);
 
+  /* Several pages are being closed, skip the animation */
+  if (adw_tab_view_get_is_batching (self->view)) {
+    close_animation_done_cb (info);
+    gtk_widget_queue_resize (GTK_WIDGET (self));
+
+    return;
+  }
+
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
                                               appear_animation_value_cb,
                                               info, NULL);
@@ -2104,9 +2428,12 @@ static int
 calculate_placeholder_index (AdwTabBox *self,
                              int        x)
 {
-  int lower, upper, pos, i;
+  int lower, upper, pos, tab_width;
+  guint start, end;
   gboolean is_rtl;
-  GList *l;
+
+  if (!self->tabs->len)
+    return 0;
 
   get_visible_range (self, &lower, &upper);
 
@@ -2115,22 +2442,28 @@ calculate_placeholder_index (AdwTabBox *self,
   is_rtl = gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL;
 
   pos = (is_rtl ? self->allocated_width - SPACING : SPACING);
-  i = 0;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
-    int tab_width = predict_tab_width (self, info, TRUE) * (is_rtl ? -1 : 1);
+  /* All tabs have the same predicted width, so the tab ends form a sorted
+   * sequence and can be searched directly */
+  tab_width = predict_tab_width (self, get_nth_tab (self, 0), TRUE);
 
-    int end = pos + tab_width + calculate_tab_offset (self, info, FALSE);
+  start = 0;
+  end = self->tabs->len;
 
-    if ((x <= end && !is_rtl) || (x >= end && is_rtl))
-      break;
+  while (start < end) {
+    guint mid = start + (end - start) / 2;
+    TabInfo *info = get_nth_tab (self, mid);
+    int tab_end = mid * (tab_width + SPACING) + tab_width;
 
-    pos += tab_width + (is_rtl ? -SPACING : SPACING);
-    i++;
+    tab_end = pos + tab_end * (is_rtl ? -1 : 1) + calculate_tab_offset (self, info, FALSE);
+
+    if ((x <= tab_end && !is_rtl) || (x >= tab_end && is_rtl))
+      end = mid;
+    else
+      start = mid + 1;
   }
 
-  return i;
+  return start;
 }
 
 static void
@@ -2165,6 +2498,8 @@ insert_placeholder (AdwTabBox  *self,
 
     info = create_tab_info (self, page);
 
+    ensure_tab_widgets (self, info);
+
     gtk_widget_set_opacity (info->container, 0);
 
     adw_tab_set_dragging (info->tab, TRUE);
@@ -2186,11 +2521,11 @@ insert_placeholder (AdwTabBox  *self,
 
     index = calculate_placeholder_index (self, pos + self->placeholder_scroll_offset);
 
-    self->tabs = g_list_insert (self->tabs, info, index);
+    insert_tab (self, info, index);
     self->n_tabs++;
 
     self->reorder_placeholder = info;
-    self->reorder_index = g_list_index (self->tabs, info);
+    self->reorder_index = info->slot;
 
     animate_scroll_relative (self, self->placeholder_scroll_offset, OPEN_ANIMATION_DURATION);
   }
@@ -2243,7 +2578,7 @@ replace_placeholder (AdwTabBox  *self,
   self->can_remove_placeholder = FALSE;
 
   adw_tab_set_page (info->tab, page);
-  info->page = page;
+  set_tab_page (self, info, page);
 
   adw_animation_skip (info->appear_animation);
 
@@ -2269,7 +2604,7 @@ remove_animation_done_cb (TabInfo *info)
 
   if (!self->can_remove_placeholder) {
     adw_tab_set_page (info->tab, self->placeholder_page);
-    info->page = self->placeholder_page;
+    set_tab_page (self, info, self->placeholder_page);
 
     return;
   }
@@ -2286,7 +2621,7 @@ remove_animation_done_cb (TabInfo *info)
   if (self->pressed_tab == info)
     self->pressed_tab = NULL;
 
-  self->tabs = g_list_remove (self->tabs, info);
+  remove_tab (self, info);
 
   remove_and_free_tab_info (info);
 
@@ -2316,7 +2651,7 @@ remove_placeholder (AdwTabBox *self)
     return;
 
   adw_tab_set_page (info->tab, NULL);
-  info->page = NULL;
+  set_tab_page (self, info, NULL);
 
   if (info->appear_animation)
     adw_animation_skip (info->appear_animation);
@@ -2855,7 +3190,7 @@ do_popup (AdwTabBox *self,
     rect.y = y;
   } else {
     rect.x = info->pos;
-    rect.y = gtk_widget_get_allocated_height (GTK_WIDGET (info->container));
+    rect.y = gtk_widget_get_allocated_height (GTK_WIDGET (self));
 
     if (gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL)
       rect.x += info->width;
@@ -3056,14 +3391,11 @@ measure_tab_box (AdwTabBox      *self,
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
     int width = self->end_padding;
-    GList *l;
-
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
-      int child_width;
+    guint i;
 
-      gtk_widget_measure (info->container, orientation, -1,
-                          NULL, &child_width, NULL, NULL);
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
+      int child_width = get_tab_natural_width (self, info);
 
       if (animated)
         width += calculate_tab_width (info, child_width) + SPACING;
@@ -3078,13 +3410,16 @@ measure_tab_box (AdwTabBox      *self,
 
     min = nat = width;
   } else {
-    GList *l;
+    guint i;
     int child_min, child_nat;
 
     min = nat = 0;
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
+
+      if (!info->container)
+        continue;
 
       gtk_widget_measure (info->container, orientation, -1,
                           &child_min, &child_nat, NULL, NULL);
@@ -3144,7 +3479,7 @@ adw_tab_box_size_allocate (GtkWidget *widget,
 {
   AdwTabBox *self = ADW_TAB_BOX (widget);
   gboolean is_rtl;
-  GList *l;
+  guint i;
   GtkAllocation child_allocation;
   int pos, final_pos;
   double value;
@@ -3164,12 +3499,9 @@ adw_tab_box_size_allocate (GtkWidget *widget,
   is_rtl = gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL;
 
   if (self->pinned) {
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
-      int child_width;
-
-      gtk_widget_measure (info->container, GTK_ORIENTATION_HORIZONTAL, -1,
-                          NULL, &child_width, NULL, NULL);
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
+      int child_width = get_tab_natural_width (self, info);
 
       info->width = calculate_tab_width (info, child_width);
       info->final_width = child_width;
@@ -3178,8 +3510,8 @@ adw_tab_box_size_allocate (GtkWidget *widget,
     self->end_padding = self->allocated_width - SPACING;
     self->final_end_padding = self->end_padding;
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       info->width = calculate_tab_width (info, info->last_width);
       self->end_padding -= info->width + SPACING;
@@ -3193,8 +3525,8 @@ adw_tab_box_size_allocate (GtkWidget *widget,
     int excess = self->allocated_width - SPACING - self->end_padding;
     int final_excess = excess;
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       info->width = calculate_tab_width (info, tab_width);
       info->final_width = final_tab_width;
@@ -3204,8 +3536,8 @@ adw_tab_box_size_allocate (GtkWidget *widget,
     }
 
     /* Now spread excess width across the tabs */
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       if (excess >= 0 && final_excess >= 0)
         break;
@@ -3225,8 +3557,8 @@ adw_tab_box_size_allocate (GtkWidget *widget,
   pos = is_rtl ? self->allocated_width - SPACING : SPACING;
   final_pos = pos;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     info->unshifted_pos = final_pos;
     info->pos = pos + calculate_tab_offset (self, info, FALSE);
@@ -3262,11 +3594,16 @@ adw_tab_box_size_allocate (GtkWidget *widget,
     adw_animation_reset (self->scroll_animation);
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  update_live_tabs (self, value, width);
+
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     GtkAllocation separator_allocation;
     int separator_width;
 
+    if (!info->container)
+      continue;
+
     child_allocation.x = ((info == self->reordered_tab) ? self->reorder_window_x : info->pos) - (int) floor (value);
     child_allocation.y = 0;
     child_allocation.width = MAX (0, info->width);
@@ -3310,7 +3647,7 @@ snapshot_tabs (AdwTabBox   *self,
   int h = gtk_widget_get_height (GTK_WIDGET (self));
   int scroll_start, scroll_end;
   int reordered_pos = -1, reordered_width = -1;
-  GList *l;
+  guint i;
   gboolean is_rtl, is_clipping = FALSE;
 
   scroll_start = (int) floor (gtk_adjustment_get_value (self->adjustment));
@@ -3335,10 +3672,13 @@ snapshot_tabs (AdwTabBox   *self,
     is_clipping = TRUE;
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     int pos, width;
 
+    if (!info->container)
+      continue;
+
     pos = get_tab_position (self, info, FALSE);
     width = gtk_widget_get_allocated_width (info->container);
 
@@ -3531,6 +3871,9 @@ adw_tab_box_finalize (GObject *object)
   AdwTabBox *self = (AdwTabBox *) object;
 
   g_clear_pointer (&self->extra_drag_types, g_free);
+  g_array_unref (self->recycled_tabs);
+  g_ptr_array_unref (self->tabs);
+  g_hash_table_unref (self->page_tabs);
 
   G_OBJECT_CLASS (adw_tab_box_parent_class)->finalize (object);
 }
@@ -3720,6 +4063,9 @@ adw_tab_box_init (AdwTabBox *self)
 
   self->can_remove_placeholder = TRUE;
   self->expand_tabs = TRUE;
+  self->recycled_tabs = g_array_new (FALSE, FALSE, sizeof (TabWidgets));
+  self->tabs = g_ptr_array_new ();
+  self->page_tabs = g_hash_table_new (NULL, NULL);
 
   gtk_widget_set_overflow (GTK_WIDGET (self), GTK_OVERFLOW_HIDDEN);
 
@@ -3827,6 +4173,8 @@ adw_tab_box_set_view (AdwTabBox  *self,
     return;
 
   if (self->view) {
+    guint i;
+
     force_end_reordering (self);
     g_signal_handlers_disconnect_by_func (self->view, page_attached_cb, self);
     g_signal_handlers_disconnect_by_func (self->view, page_detached_cb, self);
@@ -3838,8 +4186,15 @@ adw_tab_box_set_view (AdwTabBox  *self,
       self->view_drop_target = NULL;
     }
 
-    g_clear_list (&self->tabs, (GDestroyNotify) remove_and_free_tab_info);
+    for (i = 0; i < self->tabs->len; i++)
+      remove_and_free_tab_info (get_nth_tab (self, i));
+
+    g_ptr_array_set_size (self->tabs, 0);
+    g_hash_table_remove_all (self->page_tabs);
     self->n_tabs = 0;
+
+    /* Recycled tabs still refer to the old view */
+    clear_recycled_tabs (self);
   }
 
   self->view = view;
@@ -3847,8 +4202,8 @@ adw_tab_box_set_view (AdwTabBox  *self,
   if (self->view) {
     int i, n_pages = adw_tab_view_get_n_pages (self->view);
 
-    for (i = n_pages - 1; i >= 0; i--)
-      page_attached_cb (self, adw_tab_view_get_nth_page (self->view, i), 0);
+    for (i = 0; i < n_pages; i++)
+      page_attached_cb (self, adw_tab_view_get_nth_page (self->view, i), i);
 
     g_signal_connect_object (self->view, "page-attached", G_CALLBACK (page_attached_cb), self, G_CONNECT_SWAPPED);
     g_signal_connect_object (self->view, "page-detached", G_CALLBACK (page_detached_cb), self, G_CONNECT_SWAPPED);
@@ -3924,7 +4279,7 @@ adw_tab_box_is_page_focused (AdwTabBox  *self,
 
   info = find_info_for_page (self, page);
 
-  return info && gtk_widget_is_focus (info->container);
+  return info && info->container && gtk_widget_is_focus (info->container);
 }
 
 void
@@ -3933,7 +4288,7 @@ adw_tab_box_setup_extra_drop_target (AdwTabBox     *self,
                                      GType         *types,
                                      gsize          n_types)
 {
-  GList *l;
+  guint i;
 
   g_return_if_fail (ADW_IS_TAB_BOX (self));
   g_return_if_fail (n_types == 0 || types != NULL);
@@ -3944,8 +4299,11 @@ adw_tab_box_setup_extra_drop_target (AdwTabBox     *self,
   self->extra_drag_types = g_memdup2 (types, sizeof (GType) * n_types);
   self->extra_drag_n_types = n_types;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
+
+    if (!info->tab)
+      continue;
 
     adw_tab_setup_extra_drop_target (info->tab,
                                      self->extra_drag_actions,
@@ -3992,7 +4350,7 @@ void
 adw_tab_box_set_inverted (AdwTabBox *self,
                           gboolean   inverted)
 {
-  GList *l;
+  guint i;
 
   g_return_if_fail (ADW_IS_TAB_BOX (self));
 
@@ -4003,10 +4361,11 @@ adw_tab_box_set_inverted (AdwTabBox *self,
 
   self->inverted = inverted;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    adw_tab_set_inverted (info->tab, inverted);
+    if (info->tab)
+      adw_tab_set_inverted (info->tab, inverted);
   }
 }
 
@@ -4022,7 +4381,7 @@ void
 adw_tab_box_set_extra_drag_preload (AdwTabBox *self,
                                     gboolean   preload)
 {
-  GList *l;
+  guint i;
 
   g_return_if_fail (ADW_IS_TAB_BOX (self));
 
@@ -4031,9 +4390,10 @@ adw_tab_box_set_extra_drag_preload (AdwTabBox *self,
 
   self->extra_drag_preload = preload;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    adw_tab_set_extra_drag_preload (info->tab, preload);
+    if (info->tab)
+      adw_tab_set_extra_drag_preload (info->tab, preload);
   }
 }
@@ -15,6 +15,7 @@
 #include "adw-gizmo-private.h"
 #include "adw-marshalers.h"
 #include "adw-tab-overview-private.h"
+#include "adw-tab-search-filter-private.h"
 #include "adw-tab-view-private.h"
 #include "adw-timed-animation.h"
 #include "adw-widget-utils-private.h"
@@ -51,6 +52,8 @@
 #define LARGE_GRID_PERCENTAGE 0.85
 #define LARGE_NAT_THUMBNAIL_WIDTH 360
 
+#define MAX_RECYCLED_TABS 16
+
 typedef enum {
   TAB_RESIZE_NORMAL,
   TAB_RESIZE_FIXED_TAB_SIZE
@@ -109,8 +112,15 @@ typedef struct {
 
   gboolean visible;
   gboolean is_hidden;
+
+  guint slot; /* Index in self->tabs */
 } TabInfo;
 
+typedef struct {
+  GtkWidget *container;
+  AdwTabThumbnail *tab;
+} TabWidgets;
+
 struct _AdwTabGrid
 {
   GtkWidget parent_instance;
@@ -123,9 +133,21 @@ struct _AdwTabGrid
   GtkEventController *view_drop_target;
   GtkGesture *drag_gesture;
 
-  GList *tabs;
+  /* Tabs are stored in order, each knows its own index and can be looked up
+   * by its page, so that finding a tab doesn't need to walk all of them */
+  GPtrArray *tabs;
+  GHashTable *page_tabs;
   int n_tabs;
 
+  /* Only tabs in or near the visible rows have thumbnails, the rest only have
+   * their geometry. Thumbnails of tabs that scroll away are kept for reuse. */
+  int n_live_tabs;
+  GArray *recycled_tabs;
+  int tab_minimum_width;
+  int tab_natural_width;
+  int tab_natural_height;
+  int tab_natural_height_for;
+
   GtkWidget *context_menu;
 
   int allocated_width;
@@ -190,9 +212,6 @@ struct _AdwTabGrid
   double visible_upper;
   double page_size;
 
-  GtkStringFilter *title_filter;
-  GtkStringFilter *tooltip_filter;
-  GtkStringFilter *keyword_filter;
   GtkFilter *filter;
   gboolean searching;
 
@@ -225,14 +244,6 @@ static guint signals[SIGNAL_LAST_SIGNAL];
 
 /* Helpers */
 
-static void
-remove_and_free_tab_info (TabInfo *info)
-{
-  gtk_widget_unparent (GTK_WIDGET (info->container));
-
-  g_free (info);
-}
-
 static inline int
 get_tab_x (AdwTabGrid *self,
            TabInfo    *info,
@@ -255,12 +266,83 @@ get_tab_y (AdwTabGrid *self,
   return final ? info->final_y : info->pos_y;
 }
 
+static inline TabInfo *
+get_nth_tab (AdwTabGrid *self,
+             guint       index)
+{
+  return g_ptr_array_index (self->tabs, index);
+}
+
+static void
+update_tab_slots (AdwTabGrid *self,
+                  guint       from,
+                  guint       to)
+{
+  guint i;
+
+  for (i = from; i < to; i++)
+    get_nth_tab (self, i)->slot = i;
+}
+
+static void
+insert_tab (AdwTabGrid *self,
+            TabInfo    *info,
+            guint       index)
+{
+  g_ptr_array_insert (self->tabs, index, info);
+  update_tab_slots (self, index, self->tabs->len);
+
+  if (info->page)
+    g_hash_table_insert (self->page_tabs, info->page, info);
+}
+
+static void
+remove_tab (AdwTabGrid *self,
+            TabInfo    *info)
+{
+  guint index = info->slot;
+
+  g_assert (get_nth_tab (self, index) == info);
+
+  if (info->page && g_hash_table_lookup (self->page_tabs, info->page) == info)
+    g_hash_table_remove (self->page_tabs, info->page);
+
+  g_ptr_array_remove_index (self->tabs, index);
+  update_tab_slots (self, index, self->tabs->len);
+}
+
+static void
+move_tab (AdwTabGrid *self,
+          TabInfo    *info,
+          guint       index)
+{
+  guint old_index = info->slot;
+
+  g_ptr_array_remove_index (self->tabs, old_index);
+  g_ptr_array_insert (self->tabs, index, info);
+  update_tab_slots (self, MIN (old_index, index), MAX (old_index, index) + 1);
+}
+
+static void
+set_tab_page (AdwTabGrid *self,
+              TabInfo    *info,
+              AdwTabPage *page)
+{
+  if (info->page && g_hash_table_lookup (self->page_tabs, info->page) == info)
+    g_hash_table_remove (self->page_tabs, info->page);
+
+  info->page = page;
+
+  if (info->page)
+    g_hash_table_insert (self->page_tabs, info->page, info);
+}
+
 static inline TabInfo *
 find_tab_info_at (AdwTabGrid *self,
                   double      x,
                   double      y)
 {
-  GList *l;
+  guint i;
 
   if (self->reordered_tab) {
     int pos_x = get_tab_x (self, self->reordered_tab, FALSE);
@@ -271,10 +353,10 @@ find_tab_info_at (AdwTabGrid *self,
       return self->reordered_tab;
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    if (!gtk_widget_should_layout (info->container))
+    if (!info->visible)
       continue;
 
     if (info != self->reordered_tab &&
@@ -286,74 +368,56 @@ find_tab_info_at (AdwTabGrid *self,
   return NULL;
 }
 
-static inline GList *
-find_link_for_page (AdwTabGrid *self,
-                    AdwTabPage *page)
-{
-  GList *l;
-
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
-
-    if (info->page == page)
-      return l;
-  }
-
-  return NULL;
-}
-
 static inline TabInfo *
 find_info_for_page (AdwTabGrid *self,
                     AdwTabPage *page)
 {
-  GList *l = find_link_for_page (self, page);
-
-  return l ? l->data : NULL;
+  return g_hash_table_lookup (self->page_tabs, page);
 }
 
-static inline GList *
-find_link_for_widget (AdwTabGrid *self,
+static inline TabInfo *
+find_info_for_widget (AdwTabGrid *self,
                       GtkWidget  *widget)
 {
-  GList *l;
-
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
-
-    if (info->container == widget)
-      return l;
-  }
+  if (!widget)
+    return NULL;
 
-  return NULL;
+  return g_object_get_data (G_OBJECT (widget), "info");
 }
 
-static GList *
+/* Returns the index in self->tabs to insert a tab for the page at @position
+ * at, skipping closing tabs */
+static guint
 find_nth_alive_tab (AdwTabGrid *self,
                     guint       position)
 {
-  GList *l;
+  guint i;
+
+  /* No tabs are closing, so every tab has a page */
+  if (g_hash_table_size (self->page_tabs) == self->tabs->len)
+    return MIN (position, self->tabs->len);
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (!info->page)
         continue;
 
     if (!position--)
-        return l;
+        return i;
   }
 
-  return NULL;
+  return self->tabs->len;
 }
 
 static int
 get_n_visible_tabs (AdwTabGrid *self)
 {
-  GList *l;
+  guint i;
   int ret = 0;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (info->page && info->visible)
       ret++;
@@ -362,14 +426,14 @@ get_n_visible_tabs (AdwTabGrid *self)
   return ret;
 }
 
-static GList *
+static TabInfo *
 find_nth_visible_tab (AdwTabGrid *self,
                       guint       position)
 {
-  GList *l;
+  guint i;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (!info->page)
         continue;
@@ -378,7 +442,7 @@ find_nth_visible_tab (AdwTabGrid *self,
         continue;
 
     if (!position--)
-        return l;
+        return info;
   }
 
   return NULL;
@@ -388,17 +452,11 @@ static TabInfo *
 get_focused_info (AdwTabGrid *self)
 {
   GtkWidget *focus_child = gtk_widget_get_focus_child (GTK_WIDGET (self));
-  GList *l;
 
   if (!focus_child)
     return NULL;
 
-  l = find_link_for_widget (self, focus_child);
-
-  if (!l || !l->data)
-    return NULL;
-
-  return l->data;
+  return find_info_for_widget (self, focus_child);
 }
 
 static int
@@ -426,15 +484,15 @@ get_other_tab_grid (AdwTabGrid *self)
 static double
 get_max_n_columns (AdwTabGrid *self)
 {
-  GList *l;
+  guint i;
   double max_columns = 0;
   double other_max_columns = 0;
   AdwTabGrid *other_grid = get_other_tab_grid (self);
   int n_tabs = 0;
   int other_n_tabs = 0;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     max_columns += info->appear_progress;
 
@@ -442,8 +500,8 @@ get_max_n_columns (AdwTabGrid *self)
       n_tabs++;
   }
 
-  for (l = other_grid->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < other_grid->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (other_grid, i);
 
     other_max_columns += info->appear_progress;
 
@@ -516,21 +574,50 @@ get_tab_width (AdwTabGrid *self,
   return CLAMP (ret, MIN_THUMBNAIL_WIDTH, MAX_THUMBNAIL_WIDTH);
 }
 
+static void
+measure_tab_width (AdwTabGrid *self,
+                   TabInfo    *info,
+                   int        *minimum,
+                   int        *natural)
+{
+  /* Tabs without thumbnails reuse the last measured width */
+  if (info->container)
+    gtk_widget_measure (info->container, GTK_ORIENTATION_HORIZONTAL, -1,
+                        &self->tab_minimum_width, &self->tab_natural_width,
+                        NULL, NULL);
+
+  *minimum = self->tab_minimum_width;
+  *natural = self->tab_natural_width;
+}
+
 static int
 get_tab_height (AdwTabGrid *self,
                 int         tab_width)
 {
   int height = 0;
-  GList *l;
+  gboolean measured = FALSE;
+  guint i;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  /* Tabs without thumbnails have the same height as the last measured ones */
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     int tab_height;
 
+    if (!info->tab)
+      continue;
+
     gtk_widget_measure (GTK_WIDGET (info->tab), GTK_ORIENTATION_VERTICAL,
                         tab_width, NULL, &tab_height, NULL, NULL);
 
     height = MAX (height, tab_height);
+    measured = TRUE;
+  }
+
+  if (measured) {
+    self->tab_natural_height = height;
+    self->tab_natural_height_for = tab_width;
+  } else if (self->tab_natural_height_for == tab_width) {
+    height = self->tab_natural_height;
   }
 
   return height;
@@ -599,21 +686,20 @@ measure_tab_grid (AdwTabGrid     *self,
                   int            *natural,
                   gboolean        animated)
 {
-  GList *l;
+  guint i;
   int min, nat;
 
   min = nat = 0;
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
       int child_min, child_nat;
 
-      if (!gtk_widget_should_layout (info->container))
+      if (!info->visible)
         continue;
 
-      gtk_widget_measure (info->container, orientation, -1,
-                          &child_min, &child_nat, NULL, NULL);
+      measure_tab_width (self, info, &child_min, &child_nat);
 
       if (animated)
         min = MAX (min, calculate_tab_width (info, child_min));
@@ -636,10 +722,10 @@ measure_tab_grid (AdwTabGrid     *self,
 
     child_height = get_tab_height (self, child_width);
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
-      if (!gtk_widget_should_layout (info->container))
+      if (!info->visible)
         continue;
 
       if (animated) {
@@ -683,7 +769,7 @@ static void
 calculate_tab_layout (AdwTabGrid *self)
 {
   gboolean is_rtl;
-  GList *l;
+  guint i;
   double index = 0, final_index = 0;
 
   if (self->tab_resize_mode != TAB_RESIZE_FIXED_TAB_SIZE &&
@@ -700,10 +786,10 @@ calculate_tab_layout (AdwTabGrid *self)
   self->tab_width = get_tab_width (self, self->allocated_width);
   self->tab_height = get_tab_height (self, self->tab_width);
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    if (!gtk_widget_should_layout (info->container))
+    if (!info->visible)
       continue;
 
     get_position_for_index (self, final_index, is_rtl,
@@ -760,6 +846,258 @@ is_touchscreen (GtkGesture *gesture)
   return input_source == GDK_SOURCE_TOUCHSCREEN;
 }
 
+/* Tab widgets */
+
+static gboolean
+extra_drag_drop_cb (AdwTabThumbnail *tab,
+                    GValue          *value,
+                    AdwTabGrid      *self)
+{
+  gboolean ret = GDK_EVENT_PROPAGATE;
+  AdwTabPage *page = adw_tab_thumbnail_get_page (tab);
+
+  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_DROP], 0, page, value, &ret);
+
+  return ret;
+}
+
+static GdkDragAction
+extra_drag_value_cb (AdwTabThumbnail *tab,
+                     GValue          *value,
+                     AdwTabGrid      *self)
+{
+  GdkDragAction preferred_action;
+  AdwTabPage *page = adw_tab_thumbnail_get_page (tab);
+
+  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_VALUE], 0, page, value, &preferred_action);
+
+  return preferred_action;
+}
+
+static void
+measure_tab (AdwGizmo       *widget,
+             GtkOrientation  orientation,
+             int             for_size,
+             int            *minimum,
+             int            *natural,
+             int            *minimum_baseline,
+             int            *natural_baseline)
+{
+  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
+
+  gtk_widget_measure (child, orientation, for_size,
+                      minimum, natural,
+                      minimum_baseline,  natural_baseline);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL && minimum)
+    *minimum = 0;
+}
+
+static void
+allocate_tab (AdwGizmo *widget,
+              int       width,
+              int       height,
+              int       baseline)
+{
+  TabInfo *info = g_object_get_data (G_OBJECT (widget), "info");
+  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
+  int allocated_width = gtk_widget_get_allocated_width (GTK_WIDGET (widget));
+  int width_diff = MAX (0, info->final_width - allocated_width);
+
+  gtk_widget_allocate (child, width + width_diff, height, baseline,
+                       gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (-width_diff / 2, 0)));
+}
+
+static gboolean
+focus_tab (AdwGizmo         *widget,
+           GtkDirectionType  direction)
+{
+  return gtk_widget_grab_focus (GTK_WIDGET (widget));
+}
+
+static void
+create_tab_widgets (AdwTabGrid *self,
+                    TabWidgets *widgets)
+{
+  widgets->container = adw_gizmo_new ("tabgridchild", measure_tab, allocate_tab,
+                                      NULL, NULL,
+                                      focus_tab,
+                                      (AdwGizmoGrabFocusFunc) adw_widget_grab_focus_self);
+  widgets->tab = adw_tab_thumbnail_new (self->view, self->pinned);
+
+  gtk_widget_set_overflow (widgets->container, GTK_OVERFLOW_HIDDEN);
+  gtk_widget_set_focusable (widgets->container, TRUE);
+
+  gtk_widget_set_parent (GTK_WIDGET (widgets->tab), widgets->container);
+
+  g_signal_connect_object (widgets->tab, "extra-drag-drop", G_CALLBACK (extra_drag_drop_cb), self, 0);
+  g_signal_connect_object (widgets->tab, "extra-drag-value", G_CALLBACK (extra_drag_value_cb), self, 0);
+}
+
+static void
+clear_recycled_tabs (AdwTabGrid *self)
+{
+  guint i;
+
+  for (i = 0; i < self->recycled_tabs->len; i++)
+    gtk_widget_unparent (g_array_index (self->recycled_tabs, TabWidgets, i).container);
+
+  g_array_set_size (self->recycled_tabs, 0);
+}
+
+static void
+ensure_tab_widgets (AdwTabGrid *self,
+                    TabInfo    *info)
+{
+  TabWidgets widgets;
+  GtkWidget *sibling = NULL;
+
+  if (info->container)
+    return;
+
+  if (self->recycled_tabs->len > 0) {
+    guint last = self->recycled_tabs->len - 1;
+
+    widgets = g_array_index (self->recycled_tabs, TabWidgets, last);
+    g_array_remove_index (self->recycled_tabs, last);
+
+    gtk_widget_set_child_visible (widgets.container, TRUE);
+  } else {
+    create_tab_widgets (self, &widgets);
+  }
+
+  info->container = widgets.container;
+  info->tab = widgets.tab;
+
+  g_object_set_data (G_OBJECT (info->container), "info", info);
+
+  gtk_widget_set_visible (info->container, info->visible);
+  gtk_widget_set_opacity (info->container, info->is_hidden ? 0 : info->appear_progress);
+
+  adw_tab_thumbnail_set_page (info->tab, info->page);
+  adw_tab_thumbnail_set_inverted (info->tab, self->inverted);
+  adw_tab_thumbnail_setup_extra_drop_target (info->tab,
+                                             self->extra_drag_actions,
+                                             self->extra_drag_types,
+                                             self->extra_drag_n_types);
+  adw_tab_thumbnail_set_extra_drag_preload (info->tab, self->extra_drag_preload);
+
+  /* The reordered tab must stay above everything else */
+  if (self->reordered_tab && self->reordered_tab->container)
+    sibling = self->reordered_tab->container;
+
+  gtk_widget_insert_before (info->container, GTK_WIDGET (self), sibling);
+
+  self->n_live_tabs++;
+}
+
+static void
+release_tab_widgets (AdwTabGrid *self,
+                     TabInfo    *info)
+{
+  TabWidgets widgets;
+
+  if (!info->container)
+    return;
+
+  widgets.container = info->container;
+  widgets.tab = info->tab;
+
+  info->container = NULL;
+  info->tab = NULL;
+
+  self->n_live_tabs--;
+
+  g_object_set_data (G_OBJECT (widgets.container), "info", NULL);
+  adw_tab_thumbnail_set_page (widgets.tab, NULL);
+
+  if (self->recycled_tabs->len >= MAX_RECYCLED_TABS) {
+    gtk_widget_unparent (widgets.container);
+
+    return;
+  }
+
+  gtk_widget_set_child_visible (widgets.container, FALSE);
+
+  g_array_append_val (self->recycled_tabs, widgets);
+}
+
+static void
+remove_and_free_tab_info (TabInfo *info)
+{
+  release_tab_widgets (info->box, info);
+
+  g_free (info);
+}
+
+static gboolean
+should_keep_tab_widgets (AdwTabGrid *self,
+                         TabInfo    *info)
+{
+  if (info == self->selected_tab ||
+      info == self->pressed_tab ||
+      info == self->reordered_tab ||
+      info == self->reorder_placeholder ||
+      info == self->drop_target_tab)
+    return TRUE;
+
+  return info->container &&
+         gtk_widget_get_focus_child (GTK_WIDGET (self)) == info->container;
+}
+
+/* This runs during allocation, the same way as GtkListView creates its rows,
+ * so new thumbnails have to be measured here before they are allocated */
+static void
+update_live_tabs (AdwTabGrid *self)
+{
+  double margin = self->page_size / 2;
+  double lower = self->visible_lower - margin;
+  double upper = self->visible_upper + margin;
+  guint i;
+
+  /* Release thumbnails first so that they can be reused right away. Always
+   * keep at least one tab alive, it's used for measuring */
+  for (i = 0; i < self->tabs->len && self->n_live_tabs > 1; i++) {
+    TabInfo *info = get_nth_tab (self, i);
+    int y;
+
+    if (!info->container || should_keep_tab_widgets (self, info))
+      continue;
+
+    y = get_tab_y (self, info, FALSE);
+
+    if (!info->visible || y + MAX (0, info->height) < lower || y > upper)
+      release_tab_widgets (self, info);
+  }
+
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
+    int y, bottom;
+
+    if (!info->visible)
+      continue;
+
+    y = get_tab_y (self, info, FALSE);
+    bottom = y + MAX (0, info->height);
+
+    if (!info->container && bottom >= lower && y <= upper) {
+      ensure_tab_widgets (self, info);
+
+      gtk_widget_measure (info->container, GTK_ORIENTATION_HORIZONTAL, -1,
+                          NULL, NULL, NULL, NULL);
+      gtk_widget_measure (info->container, GTK_ORIENTATION_VERTICAL,
+                          MAX (0, info->width), NULL, NULL, NULL, NULL);
+    }
+
+    /* Thumbnails kept alive within the margin don't need to animate their
+     * spinners until they are scrolled into view */
+    if (info->tab)
+      adw_tab_thumbnail_set_onscreen (info->tab,
+                                      bottom >= self->visible_lower &&
+                                      y <= self->visible_upper);
+  }
+}
+
 /* Search */
 
 static gboolean
@@ -788,12 +1126,12 @@ static void
 search_changed_cb (AdwTabGrid      *self,
                    GtkFilterChange  change)
 {
-  GList *l;
+  guint i;
   gboolean changed = FALSE;
   gboolean empty = TRUE;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     gboolean visible;
 
     if (change == GTK_FILTER_CHANGE_LESS_STRICT && info->visible) {
@@ -811,8 +1149,10 @@ search_changed_cb (AdwTabGrid      *self,
 
     if (visible != info->visible) {
       info->visible = visible;
-      gtk_widget_set_visible (info->container, visible);
       changed = TRUE;
+
+      if (info->container)
+        gtk_widget_set_visible (info->container, visible);
     }
   }
 
@@ -822,6 +1162,41 @@ search_changed_cb (AdwTabGrid      *self,
     gtk_widget_queue_resize (GTK_WIDGET (self));
 }
 
+/* A single page started or stopped matching, e.g. because its title changed,
+ * so only its tab needs to be updated */
+static void
+search_page_match_changed_cb (AdwTabGrid *self,
+                              AdwTabPage *page)
+{
+  TabInfo *info;
+  gboolean visible;
+
+  if (!self->searching)
+    return;
+
+  info = find_info_for_page (self, page);
+
+  if (!info)
+    return;
+
+  visible = tab_should_be_visible (self, page);
+
+  if (visible == info->visible)
+    return;
+
+  info->visible = visible;
+
+  if (info->container)
+    gtk_widget_set_visible (info->container, visible);
+
+  if (visible)
+    set_empty (self, FALSE);
+  else if (!self->empty)
+    set_empty (self, !find_nth_visible_tab (self, 0));
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+}
+
 /* Tab resize delay */
 
 static void
@@ -856,12 +1231,12 @@ set_tab_resize_mode_do (AdwTabGrid    *self,
     return;
 
   if (mode == TAB_RESIZE_FIXED_TAB_SIZE) {
-    GList *l;
+    guint i;
 
     self->last_height = self->allocated_height;
 
-    for (l = self->tabs; l; l = l->next) {
-      TabInfo *info = l->data;
+    for (i = 0; i < self->tabs->len; i++) {
+      TabInfo *info = get_nth_tab (self, i);
 
       if (info->appear_animation)
         info->last_height = info->final_height;
@@ -1061,7 +1436,7 @@ scroll_to_tab (AdwTabGrid *self,
 static void
 force_end_reordering (AdwTabGrid *self)
 {
-  GList *l;
+  guint i;
 
   if (self->dragging || !self->reordered_tab)
     return;
@@ -1069,8 +1444,8 @@ force_end_reordering (AdwTabGrid *self)
   if (self->reorder_animation)
     adw_animation_skip (self->reorder_animation);
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (info->reorder_animation)
       adw_animation_skip (info->reorder_animation);
@@ -1080,7 +1455,7 @@ force_end_reordering (AdwTabGrid *self)
 static void
 check_end_reordering (AdwTabGrid *self)
 {
-  GList *l;
+  guint i;
 
   if (self->dragging || !self->reordered_tab || self->continue_reorder)
     return;
@@ -1088,15 +1463,15 @@ check_end_reordering (AdwTabGrid *self)
   if (self->reorder_animation)
     return;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     if (info->reorder_animation)
       return;
   }
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
     info->end_reorder_offset = 0;
     info->reorder_offset = 0;
@@ -1104,8 +1479,7 @@ check_end_reordering (AdwTabGrid *self)
 
   self->reordered_tab->reorder_ignore_bounds = FALSE;
 
-  self->tabs = g_list_remove (self->tabs, self->reordered_tab);
-  self->tabs = g_list_insert (self->tabs, self->reordered_tab, self->reorder_index);
+  move_tab (self, self->reordered_tab, self->reorder_index);
 
   gtk_widget_queue_allocate (GTK_WIDGET (self));
 
@@ -1116,6 +1490,8 @@ static void
 start_reordering (AdwTabGrid *self,
                   TabInfo    *info)
 {
+  ensure_tab_widgets (self, info);
+
   self->reordered_tab = info;
 
   /* The reordered tab should be displayed above everything else */
@@ -1251,25 +1627,19 @@ static void
 reset_reorder_animations (AdwTabGrid *self)
 {
   int i, original_index;
-  GList *l;
 
   if (!adw_get_enable_animations (GTK_WIDGET (self)))
       return;
 
-  l = find_link_for_page (self, self->reordered_tab->page);
-  original_index = g_list_position (self->tabs, l);
+  original_index = self->reordered_tab->slot;
 
   if (self->reorder_index > original_index)
-    for (i = 0; i < self->reorder_index - original_index; i++) {
-      l = l->next;
-      animate_reorder_offset (self, l->data, 0);
-    }
+    for (i = original_index + 1; i <= self->reorder_index; i++)
+      animate_reorder_offset (self, get_nth_tab (self, i), 0);
 
   if (self->reorder_index < original_index)
-    for (i = 0; i < original_index - self->reorder_index; i++) {
-      l = l->prev;
-      animate_reorder_offset (self, l->data, 0);
-    }
+    for (i = self->reorder_index; i < original_index; i++)
+      animate_reorder_offset (self, get_nth_tab (self, i), 0);
 }
 
 static void
@@ -1277,7 +1647,6 @@ page_reordered_cb (AdwTabGrid *self,
                    AdwTabPage *page,
                    int         index)
 {
-  GList *link;
   int original_index;
   TabInfo *info, *dest_tab;
   gboolean is_rtl;
@@ -1285,6 +1654,24 @@ page_reordered_cb (AdwTabGrid *self,
   if (adw_tab_page_get_pinned (page) != self->pinned)
     return;
 
+  if (adw_tab_view_get_is_batching (self->view) && !self->dragging) {
+    self->continue_reorder = FALSE;
+    force_end_reordering (self);
+
+    if (!self->pinned)
+      index -= adw_tab_view_get_n_pinned_pages (self->view);
+
+    /* Several pages are being moved, skip the animation */
+    info = find_info_for_page (self, page);
+
+    remove_tab (self, info);
+    insert_tab (self, info, find_nth_alive_tab (self, index));
+
+    gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+    return;
+  }
+
   self->continue_reorder = self->reordered_tab && page == self->reordered_tab->page;
 
   if (self->continue_reorder)
@@ -1292,9 +1679,8 @@ page_reordered_cb (AdwTabGrid *self,
   else
     force_end_reordering (self);
 
-  link = find_link_for_page (self, page);
-  info = link->data;
-  original_index = g_list_position (self->tabs, link);
+  info = find_info_for_page (self, page);
+  original_index = info->slot;
 
   if (!self->continue_reorder)
     start_reordering (self, info);
@@ -1312,7 +1698,7 @@ page_reordered_cb (AdwTabGrid *self,
   if (!self->pinned)
     self->reorder_index -= adw_tab_view_get_n_pinned_pages (self->view);
 
-  dest_tab = g_list_nth_data (self->tabs, self->reorder_index);
+  dest_tab = get_nth_tab (self, self->reorder_index);
 
   if (info == self->selected_tab)
     scroll_to_tab_full (self, self->selected_tab, dest_tab->final_y, REORDER_ANIMATION_DURATION, FALSE);
@@ -1331,16 +1717,12 @@ page_reordered_cb (AdwTabGrid *self,
     int i;
 
     if (self->reorder_index > original_index)
-      for (i = 0; i < self->reorder_index - original_index; i++) {
-        link = link->next;
-        animate_reorder_offset (self, link->data, is_rtl ? 1 : -1);
-      }
+      for (i = original_index + 1; i <= self->reorder_index; i++)
+        animate_reorder_offset (self, get_nth_tab (self, i), is_rtl ? 1 : -1);
 
     if (self->reorder_index < original_index)
-      for (i = 0; i < original_index - self->reorder_index; i++) {
-        link = link->prev;
-        animate_reorder_offset (self, link->data, is_rtl ? -1 : 1);
-      }
+      for (i = self->reorder_index; i < original_index; i++)
+        animate_reorder_offset (self, get_nth_tab (self, i), is_rtl ? -1 : 1);
   }
 
   self->continue_reorder = FALSE;
@@ -1350,11 +1732,10 @@ static void
 update_drag_reodering (AdwTabGrid *self)
 {
   gboolean is_rtl;
-  int old_index = -1, new_index = -1;
+  int old_index, new_index = -1;
   int x, y;
-  int i = 0;
+  int i;
   int width, height;
-  GList *l;
 
   if (!self->dragging)
     return;
@@ -1371,8 +1752,10 @@ update_drag_reodering (AdwTabGrid *self)
 
   is_rtl = gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  old_index = self->reordered_tab->slot;
+
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     int center_x, center_y;
 
     center_x = info->unshifted_x + info->final_width / 2;
@@ -1381,27 +1764,18 @@ update_drag_reodering (AdwTabGrid *self)
     if (is_rtl)
       center_x -= info->final_width;
 
-    if (info == self->reordered_tab)
-      old_index = i;
-
     if (x + width  + SPACING > center_x && center_x >= x - SPACING &&
-        y + height + SPACING > center_y && center_y >= y - SPACING &&
-        new_index < 0)
+        y + height + SPACING > center_y && center_y >= y - SPACING) {
       new_index = i;
-
-    if (old_index >= 0 && new_index >= 0)
       break;
-
-    i++;
+    }
   }
 
   if (new_index < 0)
-    new_index = g_list_length (self->tabs) - 1;
+    new_index = self->tabs->len - 1;
 
-  i = 0;
-
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     double offset = 0;
 
     if (i > old_index && i <= new_index)
@@ -1410,8 +1784,6 @@ update_drag_reodering (AdwTabGrid *self)
     if (i < old_index && i >= new_index)
       offset = is_rtl ? -1 : 1;
 
-    i++;
-
     animate_reorder_offset (self, info, offset);
   }
 
@@ -1555,7 +1927,7 @@ end_drag_reodering (AdwTabGrid *self)
 
   end_autoscroll (self);
 
-  dest_tab = g_list_nth_data (self->tabs, self->reorder_index);
+  dest_tab = get_nth_tab (self, self->reorder_index);
 
   if (!self->indirect_reordering) {
     int index = self->reorder_index;
@@ -1733,6 +2105,8 @@ select_page (AdwTabGrid *self,
     return;
   }
 
+  ensure_tab_widgets (self, self->selected_tab);
+
   gtk_widget_grab_focus (self->selected_tab->container);
 
   gtk_widget_set_focus_child (GTK_WIDGET (self),
@@ -1745,43 +2119,22 @@ select_page (AdwTabGrid *self,
 
 /* Opening */
 
-static gboolean
-extra_drag_drop_cb (AdwTabThumbnail *tab,
-                    GValue          *value,
-                    AdwTabGrid      *self)
-{
-  gboolean ret = GDK_EVENT_PROPAGATE;
-  AdwTabPage *page = adw_tab_thumbnail_get_page (tab);
-
-  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_DROP], 0, page, value, &ret);
-
-  return ret;
-}
-
-static GdkDragAction
-extra_drag_value_cb (AdwTabThumbnail *tab,
-                     GValue          *value,
-                     AdwTabGrid      *self)
-{
-  GdkDragAction preferred_action;
-  AdwTabPage *page = adw_tab_thumbnail_get_page (tab);
-
-  g_signal_emit (self, signals[SIGNAL_EXTRA_DRAG_VALUE], 0, page, value, &preferred_action);
-
-  return preferred_action;
-}
-
 static void
 appear_animation_value_cb (double   value,
                            TabInfo *info)
 {
   info->appear_progress = value;
 
+  if (!GTK_IS_WIDGET (info->container)) {
+    gtk_widget_queue_resize (GTK_WIDGET (info->box));
+
+    return;
+  }
+
   if (!info->is_hidden)
     gtk_widget_set_opacity (info->container, info->appear_progress);
 
-  if (GTK_IS_WIDGET (info->container))
-    gtk_widget_queue_resize (info->container);
+  gtk_widget_queue_resize (info->container);
 }
 
 static void
@@ -1790,47 +2143,6 @@ open_animation_done_cb (TabInfo *info)
   g_clear_object (&info->appear_animation);
 }
 
-static void
-measure_tab (AdwGizmo       *widget,
-             GtkOrientation  orientation,
-             int             for_size,
-             int            *minimum,
-             int            *natural,
-             int            *minimum_baseline,
-             int            *natural_baseline)
-{
-  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
-
-  gtk_widget_measure (child, orientation, for_size,
-                      minimum, natural,
-                      minimum_baseline,  natural_baseline);
-
-  if (orientation == GTK_ORIENTATION_HORIZONTAL && minimum)
-    *minimum = 0;
-}
-
-static void
-allocate_tab (AdwGizmo *widget,
-              int       width,
-              int       height,
-              int       baseline)
-{
-  TabInfo *info = g_object_get_data (G_OBJECT (widget), "info");
-  GtkWidget *child = gtk_widget_get_first_child (GTK_WIDGET (widget));
-  int allocated_width = gtk_widget_get_allocated_width (GTK_WIDGET (widget));
-  int width_diff = MAX (0, info->final_width - allocated_width);
-
-  gtk_widget_allocate (child, width + width_diff, height, baseline,
-                       gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (-width_diff / 2, 0)));
-}
-
-static gboolean
-focus_tab (AdwGizmo         *widget,
-           GtkDirectionType  direction)
-{
-  return gtk_widget_grab_focus (GTK_WIDGET (widget));
-}
-
 static TabInfo *
 create_tab_info (AdwTabGrid *self,
                  AdwTabPage *page)
@@ -1847,30 +2159,6 @@ create_tab_info (AdwTabGrid *self,
   info->width = -1;
   info->height = -1;
   info->visible = tab_should_be_visible (self, page);
-  info->container = adw_gizmo_new ("tabgridchild", measure_tab, allocate_tab,
-                                   NULL, NULL,
-                                   focus_tab,
-                                   (AdwGizmoGrabFocusFunc) adw_widget_grab_focus_self);
-  gtk_widget_set_visible (info->container, info->visible);
-  info->tab = adw_tab_thumbnail_new (self->view, self->pinned);
-
-  g_object_set_data (G_OBJECT (info->container), "info", info);
-  gtk_widget_set_overflow (info->container, GTK_OVERFLOW_HIDDEN);
-  gtk_widget_set_focusable (info->container, TRUE);
-
-  adw_tab_thumbnail_set_page (info->tab, page);
-  adw_tab_thumbnail_set_inverted (info->tab, self->inverted);
-  adw_tab_thumbnail_setup_extra_drop_target (info->tab,
-                                             self->extra_drag_actions,
-                                             self->extra_drag_types,
-                                             self->extra_drag_n_types);
-  adw_tab_thumbnail_set_extra_drag_preload (info->tab, self->extra_drag_preload);
-
-  gtk_widget_set_parent (GTK_WIDGET (info->tab), info->container);
-  gtk_widget_insert_before (info->container, GTK_WIDGET (self), NULL);
-
-  g_signal_connect_object (info->tab, "extra-drag-drop", G_CALLBACK (extra_drag_drop_cb), self, 0);
-  g_signal_connect_object (info->tab, "extra-drag-value", G_CALLBACK (extra_drag_value_cb), self, 0);
 
   return info;
 }
@@ -1882,7 +2170,6 @@ page_attached_cb (AdwTabGrid *self,
 {
   AdwAnimationTarget *target;
   TabInfo *info;
-  GList *l;
 
   if (adw_tab_page_get_pinned (page) != self->pinned)
     return;
@@ -1895,31 +2182,40 @@ page_attached_cb (AdwTabGrid *self,
 
   info = create_tab_info (self, page);
 
-  target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
-                                              appear_animation_value_cb,
-                                              info, NULL);
-  info->appear_animation =
-    adw_timed_animation_new (GTK_WIDGET (self), 0, 1,
-                             OPEN_ANIMATION_DURATION, target);
-
-  g_signal_connect_swapped (info->appear_animation, "done",
-                            G_CALLBACK (open_animation_done_cb), info);
+  /* Make sure there's always a tab to measure */
+  if (!self->n_live_tabs)
+    ensure_tab_widgets (self, info);
 
-  l = find_nth_alive_tab (self, position);
-  self->tabs = g_list_insert_before (self->tabs, l, info);
+  insert_tab (self, info, find_nth_alive_tab (self, position));
 
   self->n_tabs++;
 
   if (!self->searching)
     set_empty (self, FALSE);
 
-  adw_animation_play (info->appear_animation);
+  if (adw_tab_view_get_is_batching (self->view)) {
+    /* Several pages are being added, skip the animation. The next allocation
+     * will lay out all of them at once */
+    appear_animation_value_cb (1, info);
+  } else {
+    target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
+                                                appear_animation_value_cb,
+                                                info, NULL);
+    info->appear_animation =
+      adw_timed_animation_new (GTK_WIDGET (self), 0, 1,
+                               OPEN_ANIMATION_DURATION, target);
 
-  calculate_tab_layout (self);
+    g_signal_connect_swapped (info->appear_animation, "done",
+                              G_CALLBACK (open_animation_done_cb), info);
+
+    adw_animation_play (info->appear_animation);
+
+    calculate_tab_layout (self);
+  }
 
   if (page == adw_tab_view_get_selected_page (self->view))
     adw_tab_grid_select_page (self, page);
-  else
+  else if (!adw_tab_view_get_is_batching (self->view))
     scroll_to_tab_full (self, info, -1, OPEN_ANIMATION_DURATION, TRUE);
 }
 
@@ -1932,7 +2228,7 @@ close_animation_done_cb (TabInfo *info)
 
   g_clear_object (&info->appear_animation);
 
-  self->tabs = g_list_remove (self->tabs, info);
+  remove_tab (self, info);
 
   if (info->reorder_animation)
     adw_animation_skip (info->reorder_animation);
@@ -1960,26 +2256,20 @@ page_detached_cb (AdwTabGrid *self,
 {
   AdwAnimationTarget *target;
   TabInfo *info;
-  GList *page_link;
 
-  page_link = find_link_for_page (self, page);
+  info = find_info_for_page (self, page);
 
-  if (!page_link)
+  if (!info)
     return;
 
-  info = page_link->data;
-  page_link = page_link->next;
-
   force_end_reordering (self);
 
   if (self->hovering) {
     gboolean is_last = TRUE;
+    guint i;
 
-    while (page_link) {
-      TabInfo *i = page_link->data;
-      page_link = page_link->next;
-
-      if (i->page) {
+    for (i = info->slot + 1; i < self->tabs->len; i++) {
+      if (get_nth_tab (self, i)->page) {
         is_last = FALSE;
         break;
       }
@@ -1993,21 +2283,31 @@ page_detached_cb (AdwTabGrid *self,
 
   g_assert (info->page);
 
-  if (gtk_widget_is_focus (info->container))
+  if (info->container && gtk_widget_is_focus (info->container))
     adw_tab_grid_try_focus_selected_tab (self, TRUE);
 
   if (info == self->selected_tab)
     adw_tab_grid_select_page (self, NULL);
 
-  adw_tab_thumbnail_set_page (info->tab, NULL);
-
-  info->page = NULL;
+  set_tab_page (self, info, NULL);
 
   if (info->appear_animation)
     adw_animation_skip (info->appear_animation);
 
-  gtk_widget_insert_after (GTK_WIDGET (info->container),
-                           GTK_WIDGET (self), NULL);
+  if (info->container) {
+    adw_tab_thumbnail_set_page (info->tab, NULL);
+
+    gtk_widget_insert_after (GTK_WIDGET (info->container),
+                             GTK_WIDGET (self), NULL);
+  }
+
+  /* Several pages are being closed, skip the animation */
+  if (adw_tab_view_get_is_batching (self->view)) {
+    close_animation_done_cb (info);
+    gtk_widget_queue_resize (GTK_WIDGET (self));
+
+    return;
+  }
 
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
                                               appear_animation_value_cb,
@@ -2116,7 +2416,7 @@ calculate_placeholder_index (AdwTabGrid *self,
                              int         x,
                              int         y)
 {
-  int lower, upper, i;
+  int lower, upper, n_columns, start, end, i;
   gboolean is_rtl;
 
   get_visible_range (self, &lower, &upper);
@@ -2126,7 +2426,26 @@ calculate_placeholder_index (AdwTabGrid *self,
 
   is_rtl = gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL;
 
-  for (i = 0; i < self->n_tabs; i++) {
+  /* Every tab in a row has the same y, and rows go top to bottom, so find the
+   * first row that can contain the placeholder and only look at the tabs
+   * starting from it */
+  n_columns = MAX (1, (int) ceil (self->n_columns));
+  start = 0;
+  end = (self->n_tabs + n_columns - 1) / n_columns;
+
+  while (start < end) {
+    int mid = start + (end - start) / 2;
+    int tab_y;
+
+    get_position_for_index (self, mid * n_columns, is_rtl, NULL, &tab_y);
+
+    if (y <= tab_y + self->tab_width + SPACING / 2)
+      end = mid;
+    else
+      start = mid + 1;
+  }
+
+  for (i = MIN (start * n_columns, self->n_tabs); i < self->n_tabs; i++) {
     int tab_x, tab_y;
 
     get_position_for_index (self, i, is_rtl, &tab_x, &tab_y);
@@ -2173,20 +2492,20 @@ insert_placeholder (AdwTabGrid *self,
     info = create_tab_info (self, page);
 
     info->is_hidden = TRUE;
-    gtk_widget_set_opacity (info->container, 0);
+    ensure_tab_widgets (self, info);
 
     info->reorder_ignore_bounds = TRUE;
 
     index = calculate_placeholder_index (self, x, y);
 
-    self->tabs = g_list_insert (self->tabs, info, index);
+    insert_tab (self, info, index);
     self->n_tabs++;
 
     if (!self->searching)
       set_empty (self, FALSE);
 
     self->reorder_placeholder = info;
-    self->reorder_index = g_list_index (self->tabs, info);
+    self->reorder_index = info->slot;
   }
 
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
@@ -2234,7 +2553,7 @@ replace_placeholder (AdwTabGrid *self,
   self->can_remove_placeholder = FALSE;
 
   adw_tab_thumbnail_set_page (info->tab, page);
-  info->page = page;
+  set_tab_page (self, info, page);
 
   adw_animation_skip (info->appear_animation);
 
@@ -2260,7 +2579,7 @@ remove_animation_done_cb (TabInfo *info)
 
   if (!self->can_remove_placeholder) {
     adw_tab_thumbnail_set_page (info->tab, self->placeholder_page);
-    info->page = self->placeholder_page;
+    set_tab_page (self, info, self->placeholder_page);
 
     return;
   }
@@ -2277,7 +2596,7 @@ remove_animation_done_cb (TabInfo *info)
   if (self->pressed_tab == info)
     self->pressed_tab = NULL;
 
-  self->tabs = g_list_remove (self->tabs, info);
+  remove_tab (self, info);
 
   remove_and_free_tab_info (info);
 
@@ -2299,7 +2618,7 @@ remove_placeholder (AdwTabGrid *self)
     return;
 
   adw_tab_thumbnail_set_page (info->tab, NULL);
-  info->page = NULL;
+  set_tab_page (self, info, NULL);
 
   if (info->appear_animation)
     adw_animation_skip (info->appear_animation);
@@ -2844,7 +3163,7 @@ do_popup (AdwTabGrid *self,
     rect.y = y;
   } else {
     rect.x = info->pos_x;
-    rect.y = info->pos_y + gtk_widget_get_allocated_height (GTK_WIDGET (info->container));
+    rect.y = info->pos_y + info->height;
 
     if (gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL)
       rect.x += info->width;
@@ -3007,7 +3326,7 @@ adw_tab_grid_size_allocate (GtkWidget *widget,
                             int        baseline)
 {
   AdwTabGrid *self = ADW_TAB_GRID (widget);
-  GList *l;
+  guint i;
 
   measure_tab_grid (self, GTK_ORIENTATION_HORIZONTAL, -1,
                     &self->allocated_width, NULL, TRUE);
@@ -3019,12 +3338,14 @@ adw_tab_grid_size_allocate (GtkWidget *widget,
 
   calculate_tab_layout (self);
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  update_live_tabs (self);
+
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
     GskTransform *transform = NULL;
     int x, y, w, h;
 
-    if (!gtk_widget_should_layout (info->container))
+    if (!info->container || !info->visible)
       continue;
 
     x = ((info == self->reordered_tab) ? self->reorder_window_x : info->pos_x);
@@ -3052,9 +3373,9 @@ adw_tab_grid_get_request_mode (GtkWidget *widget)
 }
 
 static inline gboolean
-page_can_be_focused (GList *l)
+page_can_be_focused (TabInfo *info)
 {
-  return ((TabInfo *) l->data)->page && ((TabInfo *) l->data)->visible;
+  return info->page && info->visible;
 }
 
 static gboolean
@@ -3064,61 +3385,68 @@ adw_tab_grid_focus (GtkWidget        *widget,
   AdwTabGrid *self = ADW_TAB_GRID (widget);
   gboolean is_rtl;
   GtkDirectionType start, end;
-  GList *l;
-  TabInfo *info = NULL;
+  TabInfo *focused, *info = NULL;
   int n_columns = (int) ceil (self->n_columns);
+  int i, n = self->tabs->len;
 
   is_rtl = gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL;
   start = is_rtl ? GTK_DIR_RIGHT : GTK_DIR_LEFT;
   end = is_rtl ? GTK_DIR_LEFT : GTK_DIR_RIGHT;
 
-  l = find_link_for_widget (self, gtk_widget_get_focus_child (widget));
+  focused = find_info_for_widget (self, gtk_widget_get_focus_child (widget));
 
   if (!self->n_tabs)
     return GDK_EVENT_PROPAGATE;
 
   if (((direction == GTK_DIR_TAB_FORWARD ||
         direction == GTK_DIR_TAB_BACKWARD) &&
-       l && l->data != self->selected_tab) || !l) {
+       focused && focused != self->selected_tab) || !focused) {
     info = self->selected_tab;
   } else if (direction == start) {
+    i = focused->slot;
+
     do {
-      l = l->prev;
-    } while (l && l->data && !page_can_be_focused (l));
+      i--;
+    } while (i >= 0 && !page_can_be_focused (get_nth_tab (self, i)));
 
-    info = l ? l->data : NULL;
+    info = i >= 0 ? get_nth_tab (self, i) : NULL;
   } else if (direction == end) {
+    i = focused->slot;
+
     do {
-      l = l->next;
-    } while (l && l->data && !page_can_be_focused (l));
+      i++;
+    } while (i < n && !page_can_be_focused (get_nth_tab (self, i)));
 
-    info = l ? l->data : NULL;
+    info = i < n ? get_nth_tab (self, i) : NULL;
   } else if (direction == GTK_DIR_UP) {
+    i = focused->slot;
+
     do {
-      l = l->prev;
+      i--;
 
-      if (l && l->data && page_can_be_focused (l))
+      if (i >= 0 && page_can_be_focused (get_nth_tab (self, i)))
         n_columns--;
-    } while (l && l->data && n_columns > 0);
+    } while (i >= 0 && n_columns > 0);
 
-    info = l ? l->data : NULL;
+    info = i >= 0 ? get_nth_tab (self, i) : NULL;
   } else if (direction == GTK_DIR_DOWN) {
-    GList *last_link = find_nth_visible_tab (self, get_n_visible_tabs (self) - 1);
-    TabInfo *last_info = last_link->data;
+    TabInfo *last_info = find_nth_visible_tab (self, get_n_visible_tabs (self) - 1);
     int last_col = (int) round (fmod (last_info->final_index, n_columns));
     int empty_slots = n_columns - last_col;
 
+    i = focused->slot;
+
     do {
-      l = l->next;
+      i++;
 
-      if (l && l->data && page_can_be_focused (l))
+      if (i < n && page_can_be_focused (get_nth_tab (self, i)))
         n_columns--;
-    } while (l && l->data && n_columns > 0);
+    } while (i < n && n_columns > 0);
 
     if (n_columns > 0 && n_columns < empty_slots)
-      l = last_link;
+      i = last_info->slot;
 
-    info = l ? l->data : NULL;
+    info = i < n ? get_nth_tab (self, i) : NULL;
   }
 
   if (!info) {
@@ -3151,6 +3479,7 @@ adw_tab_grid_focus (GtkWidget        *widget,
   }
 
   scroll_to_tab (self, info, FOCUS_ANIMATION_DURATION);
+  ensure_tab_widgets (self, info);
 
   return gtk_widget_grab_focus (info->container);
 }
@@ -3222,9 +3551,6 @@ adw_tab_grid_dispose (GObject *object)
   adw_tab_grid_set_view (self, NULL);
 
   g_clear_object (&self->filter);
-  self->title_filter = NULL;
-  self->tooltip_filter = NULL;
-  self->keyword_filter = NULL;
 
   g_clear_object (&self->resize_animation);
 
@@ -3239,6 +3565,9 @@ adw_tab_grid_finalize (GObject *object)
   AdwTabGrid *self = (AdwTabGrid *) object;
 
   g_clear_pointer (&self->extra_drag_types, g_free);
+  g_array_unref (self->recycled_tabs);
+  g_ptr_array_unref (self->tabs);
+  g_hash_table_unref (self->page_tabs);
 
   G_OBJECT_CLASS (adw_tab_grid_parent_class)->finalize (object);
 }
@@ -3429,13 +3758,15 @@ adw_tab_grid_init (AdwTabGrid *self)
 {
   GtkEventController *controller;
   AdwAnimationTarget *target;
-  GtkExpression *expression;
 
   self->can_remove_placeholder = TRUE;
   self->initial_max_n_columns = -1;
   self->visible_lower = 0;
   self->visible_upper = 0;
   self->empty = TRUE;
+  self->recycled_tabs = g_array_new (FALSE, FALSE, sizeof (TabWidgets));
+  self->tabs = g_ptr_array_new ();
+  self->page_tabs = g_hash_table_new (NULL, NULL);
 
   controller = GTK_EVENT_CONTROLLER (gtk_gesture_click_new ());
   gtk_gesture_single_set_button (GTK_GESTURE_SINGLE (controller), 0);
@@ -3484,25 +3815,12 @@ adw_tab_grid_init (AdwTabGrid *self)
   g_signal_connect_swapped (self->resize_animation, "done",
                             G_CALLBACK (resize_animation_done_cb), self);
 
-  expression = gtk_property_expression_new (ADW_TYPE_TAB_PAGE, NULL, "title");
-  self->title_filter = gtk_string_filter_new (expression);
-
-  expression = gtk_property_expression_new (ADW_TYPE_TAB_PAGE, NULL, "tooltip");
-  self->tooltip_filter = gtk_string_filter_new (expression);
-
-  expression = gtk_property_expression_new (ADW_TYPE_TAB_PAGE, NULL, "keyword");
-  self->keyword_filter = gtk_string_filter_new (expression);
-
-  self->filter = GTK_FILTER (gtk_any_filter_new ());
-  gtk_multi_filter_append (GTK_MULTI_FILTER (self->filter),
-                           GTK_FILTER (self->title_filter));
-  gtk_multi_filter_append (GTK_MULTI_FILTER (self->filter),
-                           GTK_FILTER (self->tooltip_filter));
-  gtk_multi_filter_append (GTK_MULTI_FILTER (self->filter),
-                           GTK_FILTER (self->keyword_filter));
+  self->filter = adw_tab_search_filter_new ();
 
   g_signal_connect_swapped (self->filter, "changed",
                             G_CALLBACK (search_changed_cb), self);
+  g_signal_connect_swapped (self->filter, "page-match-changed",
+                            G_CALLBACK (search_page_match_changed_cb), self);
 }
 
 void
@@ -3516,6 +3834,8 @@ adw_tab_grid_set_view (AdwTabGrid *self,
     return;
 
   if (self->view) {
+    guint i;
+
     force_end_reordering (self);
     g_signal_handlers_disconnect_by_func (self->view, page_attached_cb, self);
     g_signal_handlers_disconnect_by_func (self->view, page_detached_cb, self);
@@ -3526,17 +3846,27 @@ adw_tab_grid_set_view (AdwTabGrid *self,
       self->view_drop_target = NULL;
     }
 
-    g_clear_list (&self->tabs, (GDestroyNotify) remove_and_free_tab_info);
+    for (i = 0; i < self->tabs->len; i++)
+      remove_and_free_tab_info (get_nth_tab (self, i));
+
+    g_ptr_array_set_size (self->tabs, 0);
+    g_hash_table_remove_all (self->page_tabs);
     self->n_tabs = 0;
+
+    /* Recycled thumbnails still refer to the old view */
+    clear_recycled_tabs (self);
   }
 
   self->view = view;
 
+  adw_tab_search_filter_set_index (ADW_TAB_SEARCH_FILTER (self->filter),
+                                   view ? adw_tab_view_get_search_index (view) : NULL);
+
   if (self->view) {
     int i, n_pages = adw_tab_view_get_n_pages (self->view);
 
-    for (i = n_pages - 1; i >= 0; i--)
-      page_attached_cb (self, adw_tab_view_get_nth_page (self->view, i), 0);
+    for (i = 0; i < n_pages; i++)
+      page_attached_cb (self, adw_tab_view_get_nth_page (self->view, i), i);
 
     g_signal_connect_object (self->view, "page-attached", G_CALLBACK (page_attached_cb), self, G_CONNECT_SWAPPED);
     g_signal_connect_object (self->view, "page-detached", G_CALLBACK (page_detached_cb), self, G_CONNECT_SWAPPED);
@@ -3612,7 +3942,7 @@ adw_tab_grid_is_page_focused (AdwTabGrid *self,
 
   info = find_info_for_page (self, page);
 
-  return info && gtk_widget_is_focus (info->container);
+  return info && info->container && gtk_widget_is_focus (info->container);
 }
 
 void
@@ -3621,7 +3951,7 @@ adw_tab_grid_setup_extra_drop_target (AdwTabGrid    *self,
                                       GType         *types,
                                       gsize          n_types)
 {
-  GList *l;
+  guint i;
 
   g_return_if_fail (ADW_IS_TAB_GRID (self));
   g_return_if_fail (n_types == 0 || types != NULL);
@@ -3632,8 +3962,11 @@ adw_tab_grid_setup_extra_drop_target (AdwTabGrid    *self,
   self->extra_drag_types = g_memdup2 (types, sizeof (GType) * n_types);
   self->extra_drag_n_types = n_types;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
+
+    if (!info->tab)
+      continue;
 
     adw_tab_thumbnail_setup_extra_drop_target (info->tab,
                                                self->extra_drag_actions,
@@ -3654,7 +3987,7 @@ void
 adw_tab_grid_set_inverted (AdwTabGrid *self,
                            gboolean    inverted)
 {
-  GList *l;
+  guint i;
 
   g_return_if_fail (ADW_IS_TAB_GRID (self));
 
@@ -3665,10 +3998,11 @@ adw_tab_grid_set_inverted (AdwTabGrid *self,
 
   self->inverted = inverted;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    adw_tab_thumbnail_set_inverted (info->tab, inverted);
+    if (info->tab)
+      adw_tab_thumbnail_set_inverted (info->tab, inverted);
   }
 }
 
@@ -3753,9 +4087,7 @@ adw_tab_grid_set_search_terms (AdwTabGrid *self,
                                const char *terms)
 {
   self->searching = terms && *terms;
-  gtk_string_filter_set_search (self->title_filter, terms);
-  gtk_string_filter_set_search (self->tooltip_filter, terms);
-  gtk_string_filter_set_search (self->keyword_filter, terms);
+  adw_tab_search_filter_set_search (ADW_TAB_SEARCH_FILTER (self->filter), terms);
 
   if (!self->searching)
     set_empty (self, self->n_tabs == 0);
@@ -3774,7 +4106,7 @@ adw_tab_grid_focus_first_row (AdwTabGrid *self,
   TabInfo *info;
   int n_tabs;
 
-  if (!self->tabs)
+  if (!self->tabs->len)
     return FALSE;
 
   if (column < 0)
@@ -3783,9 +4115,10 @@ adw_tab_grid_focus_first_row (AdwTabGrid *self,
   n_tabs = get_n_visible_tabs (self);
   column = CLAMP (column, 0, MIN (n_tabs, self->n_columns) - 1);
 
-  info = find_nth_visible_tab (self, column)->data;
+  info = find_nth_visible_tab (self, column);
 
   scroll_to_tab (self, info, FOCUS_ANIMATION_DURATION);
+  ensure_tab_widgets (self, info);
 
   return gtk_widget_grab_focus (info->container);
 }
@@ -3797,10 +4130,10 @@ adw_tab_grid_focus_last_row (AdwTabGrid *self,
   TabInfo *info;
   int last_col, n_tabs;
 
-  if (!self->tabs)
+  if (!self->tabs->len)
       return FALSE;
 
-  info = g_list_last (self->tabs)->data;
+  info = get_nth_tab (self, self->tabs->len - 1);
 
   last_col = (int) round (fmod (info->final_index, self->n_columns));
   n_tabs = get_n_visible_tabs (self);
@@ -3810,9 +4143,10 @@ adw_tab_grid_focus_last_row (AdwTabGrid *self,
 
   column = CLAMP (column, 0, MIN (n_tabs - 1, last_col));
 
-  info = find_nth_visible_tab (self, n_tabs - 1 - last_col + column)->data;
+  info = find_nth_visible_tab (self, n_tabs - 1 - last_col + column);
 
   scroll_to_tab (self, info, FOCUS_ANIMATION_DURATION);
+  ensure_tab_widgets (self, info);
 
   return gtk_widget_grab_focus (info->container);
 }
@@ -3827,6 +4161,7 @@ adw_tab_grid_focus_page (AdwTabGrid *self,
     return;
 
   scroll_to_tab (self, info, FOCUS_ANIMATION_DURATION);
+  ensure_tab_widgets (self, info);
 
   gtk_widget_grab_focus (info->container);
 }
@@ -3854,7 +4189,7 @@ void
 adw_tab_grid_set_extra_drag_preload (AdwTabGrid *self,
                                      gboolean    preload)
 {
-  GList *l;
+  guint i;
 
   g_return_if_fail (ADW_IS_TAB_GRID (self));
 
@@ -3863,9 +4198,10 @@ adw_tab_grid_set_extra_drag_preload (AdwTabGrid *self,
 
   self->extra_drag_preload = preload;
 
-  for (l = self->tabs; l; l = l->next) {
-    TabInfo *info = l->data;
+  for (i = 0; i < self->tabs->len; i++) {
+    TabInfo *info = get_nth_tab (self, i);
 
-    adw_tab_thumbnail_set_extra_drag_preload (info->tab, preload);
+    if (info->tab)
+      adw_tab_thumbnail_set_extra_drag_preload (info->tab, preload);
   }
 }
@@ -852,12 +852,14 @@ new_tab_clicked_cb (AdwTabOverview *self)
   if (!new_page)
     return;
 
-  child = adw_tab_page_get_child (new_page);
-
   adw_tab_view_set_selected_page (self->view, new_page);
   adw_tab_overview_set_open (self, FALSE);
 
-  gtk_widget_grab_focus (child);
+  /* Lazy pages only get their child once they are selected */
+  child = adw_tab_page_get_child (new_page);
+
+  if (child)
+    gtk_widget_grab_focus (child);
 }
 
 static void
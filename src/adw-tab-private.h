@@ -39,6 +39,9 @@ void     adw_tab_set_inverted (AdwTab   *self,
 void adw_tab_set_fully_visible (AdwTab   *self,
                                 gboolean  fully_visible);
 
+void adw_tab_set_onscreen (AdwTab   *self,
+                           gboolean  onscreen);
+
 void adw_tab_setup_extra_drop_target (AdwTab        *self,
                                       GdkDragAction  actions,
                                       GType         *types,
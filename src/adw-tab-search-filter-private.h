@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-version.h"
+
+#include <gtk/gtk.h>
+#include "adw-tab-search-index-private.h"
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_TAB_SEARCH_FILTER (adw_tab_search_filter_get_type())
+
+ADW_AVAILABLE_IN_ALL
+G_DECLARE_FINAL_TYPE (AdwTabSearchFilter, adw_tab_search_filter, ADW, TAB_SEARCH_FILTER, GtkFilter)
+
+ADW_AVAILABLE_IN_ALL
+GtkFilter *adw_tab_search_filter_new (void) G_GNUC_WARN_UNUSED_RESULT;
+
+ADW_AVAILABLE_IN_ALL
+void adw_tab_search_filter_set_index  (AdwTabSearchFilter *self,
+                                       AdwTabSearchIndex  *index);
+ADW_AVAILABLE_IN_ALL
+void adw_tab_search_filter_set_search (AdwTabSearchFilter *self,
+                                       const char         *search);
+
+G_END_DECLS
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-tab-search-filter-private.h"
+
+#include "adw-marshalers.h"
+
+#include <string.h>
+
+/*
+ * AdwTabSearchFilter:
+ *
+ * A filter matching pages against a search string using `AdwTabSearchIndex`.
+ *
+ * The matching pages are kept as a set, so matching a single page is O(1).
+ * When the search string changes, the set is updated as cheaply as the change
+ * allows: if the new string contains the previous one, only the previous
+ * matches are checked again, and the change is reported as
+ * `GTK_FILTER_CHANGE_MORE_STRICT`. If it's contained in the previous one, the
+ * change is reported as `GTK_FILTER_CHANGE_LESS_STRICT`.
+ *
+ * When a page stops or starts matching because its title, tooltip or keyword
+ * changed, [signal@Gtk.Filter::changed] isn't emitted, since that would make
+ * the consumer check every page again. The page is passed to
+ * `::page-match-changed` instead.
+ */
+
+struct _AdwTabSearchFilter
+{
+  GtkFilter parent_instance;
+
+  AdwTabSearchIndex *index;
+  char *search;
+  GHashTable *matches;
+};
+
+G_DEFINE_FINAL_TYPE (AdwTabSearchFilter, adw_tab_search_filter, GTK_TYPE_FILTER)
+
+enum {
+  SIGNAL_PAGE_MATCH_CHANGED,
+  SIGNAL_LAST_SIGNAL,
+};
+
+static guint signals[SIGNAL_LAST_SIGNAL];
+
+static void
+update_matches (AdwTabSearchFilter *self,
+                GtkFilterChange     change)
+{
+  if (!self->search || !self->index) {
+    g_clear_pointer (&self->matches, g_hash_table_unref);
+
+    return;
+  }
+
+  if (change == GTK_FILTER_CHANGE_MORE_STRICT && self->matches) {
+    GHashTableIter iter;
+    AdwTabPage *page;
+
+    g_hash_table_iter_init (&iter, self->matches);
+
+    while (g_hash_table_iter_next (&iter, (gpointer *) &page, NULL))
+      if (!adw_tab_search_index_match (self->index, page, self->search))
+        g_hash_table_iter_remove (&iter);
+
+    return;
+  }
+
+  g_clear_pointer (&self->matches, g_hash_table_unref);
+  self->matches = adw_tab_search_index_query (self->index, self->search);
+}
+
+static void
+index_page_changed_cb (AdwTabSearchFilter *self,
+                       AdwTabPage         *page)
+{
+  gboolean matched, matches;
+
+  if (!self->matches)
+    return;
+
+  matched = g_hash_table_contains (self->matches, page);
+  matches = adw_tab_search_index_match (self->index, page, self->search);
+
+  if (matched == matches)
+    return;
+
+  if (matches)
+    g_hash_table_add (self->matches, page);
+  else
+    g_hash_table_remove (self->matches, page);
+
+  g_signal_emit (self, signals[SIGNAL_PAGE_MATCH_CHANGED], 0, page);
+}
+
+static void
+index_page_removed_cb (AdwTabSearchFilter *self,
+                       AdwTabPage         *page)
+{
+  if (self->matches)
+    g_hash_table_remove (self->matches, page);
+}
+
+static gboolean
+adw_tab_search_filter_match (GtkFilter *filter,
+                             gpointer   item)
+{
+  AdwTabSearchFilter *self = ADW_TAB_SEARCH_FILTER (filter);
+
+  if (!self->search)
+    return TRUE;
+
+  return self->matches && g_hash_table_contains (self->matches, item);
+}
+
+static GtkFilterMatch
+adw_tab_search_filter_get_strictness (GtkFilter *filter)
+{
+  AdwTabSearchFilter *self = ADW_TAB_SEARCH_FILTER (filter);
+
+  if (!self->search)
+    return GTK_FILTER_MATCH_ALL;
+
+  return GTK_FILTER_MATCH_SOME;
+}
+
+static void
+adw_tab_search_filter_dispose (GObject *object)
+{
+  AdwTabSearchFilter *self = ADW_TAB_SEARCH_FILTER (object);
+
+  adw_tab_search_filter_set_index (self, NULL);
+
+  G_OBJECT_CLASS (adw_tab_search_filter_parent_class)->dispose (object);
+}
+
+static void
+adw_tab_search_filter_finalize (GObject *object)
+{
+  AdwTabSearchFilter *self = ADW_TAB_SEARCH_FILTER (object);
+
+  g_free (self->search);
+  g_clear_pointer (&self->matches, g_hash_table_unref);
+
+  G_OBJECT_CLASS (adw_tab_search_filter_parent_class)->finalize (object);
+}
+
+static void
+adw_tab_search_filter_class_init (AdwTabSearchFilterClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GtkFilterClass *filter_class = GTK_FILTER_CLASS (klass);
+
+  object_class->dispose = adw_tab_search_filter_dispose;
+  object_class->finalize = adw_tab_search_filter_finalize;
+
+  filter_class->match = adw_tab_search_filter_match;
+  filter_class->get_strictness = adw_tab_search_filter_get_strictness;
+
+  signals[SIGNAL_PAGE_MATCH_CHANGED] =
+    g_signal_new ("page-match-changed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__OBJECT,
+                  G_TYPE_NONE,
+                  1,
+                  ADW_TYPE_TAB_PAGE);
+  g_signal_set_va_marshaller (signals[SIGNAL_PAGE_MATCH_CHANGED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__OBJECTv);
+}
+
+static void
+adw_tab_search_filter_init (AdwTabSearchFilter *self)
+{
+}
+
+GtkFilter *
+adw_tab_search_filter_new (void)
+{
+  return g_object_new (ADW_TYPE_TAB_SEARCH_FILTER, NULL);
+}
+
+/*
+ * adw_tab_search_filter_set_index:
+ * @self: a search filter
+ * @index: (nullable): a search index
+ *
+ * Sets the index to look the pages up in.
+ *
+ * The matches are recomputed, but [signal@Gtk.Filter::changed] isn't emitted,
+ * as the pages of the old and new index are different anyway.
+ */
+void
+adw_tab_search_filter_set_index (AdwTabSearchFilter *self,
+                                 AdwTabSearchIndex  *index)
+{
+  g_return_if_fail (ADW_IS_TAB_SEARCH_FILTER (self));
+  g_return_if_fail (index == NULL || ADW_IS_TAB_SEARCH_INDEX (index));
+
+  if (self->index == index)
+    return;
+
+  if (self->index)
+    g_signal_handlers_disconnect_by_data (self->index, self);
+
+  g_set_object (&self->index, index);
+
+  if (self->index) {
+    g_signal_connect_swapped (self->index, "page-changed",
+                              G_CALLBACK (index_page_changed_cb), self);
+    g_signal_connect_swapped (self->index, "page-removed",
+                              G_CALLBACK (index_page_removed_cb), self);
+  }
+
+  update_matches (self, GTK_FILTER_CHANGE_DIFFERENT);
+}
+
+void
+adw_tab_search_filter_set_search (AdwTabSearchFilter *self,
+                                  const char         *search)
+{
+  GtkFilterChange change;
+  char *prepared;
+
+  g_return_if_fail (ADW_IS_TAB_SEARCH_FILTER (self));
+
+  prepared = adw_tab_search_index_prepare (search);
+
+  if (!g_strcmp0 (prepared, self->search)) {
+    g_free (prepared);
+
+    return;
+  }
+
+  if (!prepared)
+    change = GTK_FILTER_CHANGE_LESS_STRICT;
+  else if (!self->search || strstr (prepared, self->search))
+    change = GTK_FILTER_CHANGE_MORE_STRICT;
+  else if (strstr (self->search, prepared))
+    change = GTK_FILTER_CHANGE_LESS_STRICT;
+  else
+    change = GTK_FILTER_CHANGE_DIFFERENT;
+
+  g_free (self->search);
+  self->search = prepared;
+
+  update_matches (self, change);
+
+  gtk_filter_changed (GTK_FILTER (self), change);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-version.h"
+
+#include <gtk/gtk.h>
+#include "adw-tab-view.h"
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_TAB_SEARCH_INDEX (adw_tab_search_index_get_type())
+
+ADW_AVAILABLE_IN_ALL
+G_DECLARE_FINAL_TYPE (AdwTabSearchIndex, adw_tab_search_index, ADW, TAB_SEARCH_INDEX, GObject)
+
+ADW_AVAILABLE_IN_ALL
+AdwTabSearchIndex *adw_tab_search_index_new (void) G_GNUC_WARN_UNUSED_RESULT;
+
+ADW_AVAILABLE_IN_ALL
+void adw_tab_search_index_add_page    (AdwTabSearchIndex *self,
+                                       AdwTabPage        *page);
+ADW_AVAILABLE_IN_ALL
+void adw_tab_search_index_remove_page (AdwTabSearchIndex *self,
+                                       AdwTabPage        *page);
+
+ADW_AVAILABLE_IN_ALL
+char *adw_tab_search_index_prepare (const char *str) G_GNUC_WARN_UNUSED_RESULT;
+
+ADW_AVAILABLE_IN_ALL
+gboolean    adw_tab_search_index_match (AdwTabSearchIndex *self,
+                                        AdwTabPage        *page,
+                                        const char        *search);
+ADW_AVAILABLE_IN_ALL
+GHashTable *adw_tab_search_index_query (AdwTabSearchIndex *self,
+                                        const char        *search) G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-tab-search-index-private.h"
+
+#include "adw-marshalers.h"
+
+#include <string.h>
+
+/*
+ * AdwTabSearchIndex:
+ *
+ * An index of the title, tooltip and keyword of every page in a tab view.
+ *
+ * The strings are normalized and case-folded once, when they change, rather
+ * than every time they are matched. Every string is also split into byte
+ * trigrams, so that the pages containing a search string of 3 bytes or more
+ * can be found by only checking the pages that contain all of its trigrams.
+ *
+ * Matching is the same as with a case-insensitive [class@Gtk.StringFilter] in
+ * the substring mode.
+ */
+
+enum {
+  FIELD_TITLE,
+  FIELD_TOOLTIP,
+  FIELD_KEYWORD,
+  N_FIELDS,
+};
+
+typedef struct {
+  AdwTabPage *page;
+  char *fields[N_FIELDS];
+} Entry;
+
+struct _AdwTabSearchIndex
+{
+  GObject parent_instance;
+
+  GHashTable *entries; /* AdwTabPage -> Entry */
+  GHashTable *trigrams; /* trigram -> set of Entry */
+};
+
+G_DEFINE_FINAL_TYPE (AdwTabSearchIndex, adw_tab_search_index, G_TYPE_OBJECT)
+
+enum {
+  SIGNAL_PAGE_CHANGED,
+  SIGNAL_PAGE_REMOVED,
+  SIGNAL_LAST_SIGNAL,
+};
+
+static guint signals[SIGNAL_LAST_SIGNAL];
+
+static inline guint
+make_trigram (const char *str)
+{
+  return ((guchar) str[0]) << 16 | ((guchar) str[1]) << 8 | (guchar) str[2];
+}
+
+static void
+add_trigrams (AdwTabSearchIndex *self,
+              Entry             *entry)
+{
+  int i;
+
+  for (i = 0; i < N_FIELDS; i++) {
+    const char *str = entry->fields[i];
+
+    if (!str)
+      continue;
+
+    for (; str[0] && str[1] && str[2]; str++) {
+      gpointer trigram = GUINT_TO_POINTER (make_trigram (str));
+      GHashTable *entries = g_hash_table_lookup (self->trigrams, trigram);
+
+      if (!entries) {
+        entries = g_hash_table_new (NULL, NULL);
+        g_hash_table_insert (self->trigrams, trigram, entries);
+      }
+
+      g_hash_table_add (entries, entry);
+    }
+  }
+}
+
+static void
+remove_trigrams (AdwTabSearchIndex *self,
+                 Entry             *entry)
+{
+  int i;
+
+  for (i = 0; i < N_FIELDS; i++) {
+    const char *str = entry->fields[i];
+
+    if (!str)
+      continue;
+
+    for (; str[0] && str[1] && str[2]; str++) {
+      gpointer trigram = GUINT_TO_POINTER (make_trigram (str));
+      GHashTable *entries = g_hash_table_lookup (self->trigrams, trigram);
+
+      if (!entries)
+        continue;
+
+      g_hash_table_remove (entries, entry);
+
+      if (!g_hash_table_size (entries))
+        g_hash_table_remove (self->trigrams, trigram);
+    }
+  }
+}
+
+static void
+update_entry (AdwTabSearchIndex *self,
+              Entry             *entry)
+{
+  int i;
+
+  remove_trigrams (self, entry);
+
+  for (i = 0; i < N_FIELDS; i++)
+    g_free (entry->fields[i]);
+
+  entry->fields[FIELD_TITLE] =
+    adw_tab_search_index_prepare (adw_tab_page_get_title (entry->page));
+  entry->fields[FIELD_TOOLTIP] =
+    adw_tab_search_index_prepare (adw_tab_page_get_tooltip (entry->page));
+  entry->fields[FIELD_KEYWORD] =
+    adw_tab_search_index_prepare (adw_tab_page_get_keyword (entry->page));
+
+  add_trigrams (self, entry);
+}
+
+static void
+entry_free (Entry *entry)
+{
+  int i;
+
+  for (i = 0; i < N_FIELDS; i++)
+    g_free (entry->fields[i]);
+
+  g_free (entry);
+}
+
+static gboolean
+entry_matches (Entry      *entry,
+               const char *search)
+{
+  int i;
+
+  for (i = 0; i < N_FIELDS; i++)
+    if (entry->fields[i] && strstr (entry->fields[i], search))
+      return TRUE;
+
+  return FALSE;
+}
+
+static void
+page_notify_cb (AdwTabPage        *page,
+                GParamSpec        *pspec,
+                AdwTabSearchIndex *self)
+{
+  Entry *entry = g_hash_table_lookup (self->entries, page);
+
+  update_entry (self, entry);
+
+  g_signal_emit (self, signals[SIGNAL_PAGE_CHANGED], 0, page);
+}
+
+static void
+adw_tab_search_index_dispose (GObject *object)
+{
+  AdwTabSearchIndex *self = ADW_TAB_SEARCH_INDEX (object);
+  GHashTableIter iter;
+  AdwTabPage *page;
+
+  g_hash_table_iter_init (&iter, self->entries);
+
+  while (g_hash_table_iter_next (&iter, (gpointer *) &page, NULL))
+    g_signal_handlers_disconnect_by_data (page, self);
+
+  g_hash_table_remove_all (self->trigrams);
+  g_hash_table_remove_all (self->entries);
+
+  G_OBJECT_CLASS (adw_tab_search_index_parent_class)->dispose (object);
+}
+
+static void
+adw_tab_search_index_finalize (GObject *object)
+{
+  AdwTabSearchIndex *self = ADW_TAB_SEARCH_INDEX (object);
+
+  g_hash_table_unref (self->trigrams);
+  g_hash_table_unref (self->entries);
+
+  G_OBJECT_CLASS (adw_tab_search_index_parent_class)->finalize (object);
+}
+
+static void
+adw_tab_search_index_class_init (AdwTabSearchIndexClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = adw_tab_search_index_dispose;
+  object_class->finalize = adw_tab_search_index_finalize;
+
+  signals[SIGNAL_PAGE_CHANGED] =
+    g_signal_new ("page-changed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__OBJECT,
+                  G_TYPE_NONE,
+                  1,
+                  ADW_TYPE_TAB_PAGE);
+  g_signal_set_va_marshaller (signals[SIGNAL_PAGE_CHANGED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__OBJECTv);
+
+  signals[SIGNAL_PAGE_REMOVED] =
+    g_signal_new ("page-removed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__OBJECT,
+                  G_TYPE_NONE,
+                  1,
+                  ADW_TYPE_TAB_PAGE);
+  g_signal_set_va_marshaller (signals[SIGNAL_PAGE_REMOVED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__OBJECTv);
+}
+
+static void
+adw_tab_search_index_init (AdwTabSearchIndex *self)
+{
+  self->entries = g_hash_table_new_full (NULL, NULL, NULL,
+                                         (GDestroyNotify) entry_free);
+  self->trigrams = g_hash_table_new_full (NULL, NULL, NULL,
+                                          (GDestroyNotify) g_hash_table_unref);
+}
+
+AdwTabSearchIndex *
+adw_tab_search_index_new (void)
+{
+  return g_object_new (ADW_TYPE_TAB_SEARCH_INDEX, NULL);
+}
+
+void
+adw_tab_search_index_add_page (AdwTabSearchIndex *self,
+                               AdwTabPage        *page)
+{
+  Entry *entry;
+
+  g_return_if_fail (ADW_IS_TAB_SEARCH_INDEX (self));
+  g_return_if_fail (ADW_IS_TAB_PAGE (page));
+  g_return_if_fail (!g_hash_table_contains (self->entries, page));
+
+  entry = g_new0 (Entry, 1);
+  entry->page = page;
+
+  g_hash_table_insert (self->entries, page, entry);
+
+  update_entry (self, entry);
+
+  g_signal_connect (page, "notify::title", G_CALLBACK (page_notify_cb), self);
+  g_signal_connect (page, "notify::tooltip", G_CALLBACK (page_notify_cb), self);
+  g_signal_connect (page, "notify::keyword", G_CALLBACK (page_notify_cb), self);
+
+  g_signal_emit (self, signals[SIGNAL_PAGE_CHANGED], 0, page);
+}
+
+void
+adw_tab_search_index_remove_page (AdwTabSearchIndex *self,
+                                  AdwTabPage        *page)
+{
+  Entry *entry;
+
+  g_return_if_fail (ADW_IS_TAB_SEARCH_INDEX (self));
+  g_return_if_fail (ADW_IS_TAB_PAGE (page));
+
+  entry = g_hash_table_lookup (self->entries, page);
+
+  g_return_if_fail (entry != NULL);
+
+  g_signal_handlers_disconnect_by_data (page, self);
+
+  remove_trigrams (self, entry);
+  g_hash_table_remove (self->entries, page);
+
+  g_signal_emit (self, signals[SIGNAL_PAGE_REMOVED], 0, page);
+}
+
+/*
+ * adw_tab_search_index_prepare:
+ * @str: (nullable): a string
+ *
+ * Normalizes and case-folds @str the same way as it's done for indexed pages.
+ *
+ * Returns: (transfer full) (nullable): the prepared string, or `NULL` if @str
+ *   is `NULL` or empty
+ */
+char *
+adw_tab_search_index_prepare (const char *str)
+{
+  char *normalized, *ret;
+
+  if (!str || !*str)
+    return NULL;
+
+  normalized = g_utf8_normalize (str, -1, G_NORMALIZE_ALL);
+  ret = g_utf8_casefold (normalized, -1);
+
+  g_free (normalized);
+
+  return ret;
+}
+
+/*
+ * adw_tab_search_index_match:
+ * @self: a search index
+ * @page: a page
+ * @search: (nullable): a string prepared with adw_tab_search_index_prepare()
+ *
+ * Checks whether @search is contained in the title, tooltip or keyword of
+ * @page.
+ *
+ * Returns: whether @page matches, always `TRUE` if @search is `NULL`
+ */
+gboolean
+adw_tab_search_index_match (AdwTabSearchIndex *self,
+                            AdwTabPage        *page,
+                            const char        *search)
+{
+  Entry *entry;
+
+  g_return_val_if_fail (ADW_IS_TAB_SEARCH_INDEX (self), FALSE);
+  g_return_val_if_fail (ADW_IS_TAB_PAGE (page), FALSE);
+
+  if (!search)
+    return TRUE;
+
+  entry = g_hash_table_lookup (self->entries, page);
+
+  return entry && entry_matches (entry, search);
+}
+
+/*
+ * adw_tab_search_index_query:
+ * @self: a search index
+ * @search: a string prepared with adw_tab_search_index_prepare()
+ *
+ * Finds all pages matching @search.
+ *
+ * Returns: (transfer full): a set of the matching pages
+ */
+GHashTable *
+adw_tab_search_index_query (AdwTabSearchIndex *self,
+                            const char        *search)
+{
+  GHashTable *ret, *candidates = NULL;
+  GHashTableIter iter;
+  Entry *entry;
+  const char *str;
+
+  g_return_val_if_fail (ADW_IS_TAB_SEARCH_INDEX (self), NULL);
+  g_return_val_if_fail (search != NULL, NULL);
+
+  ret = g_hash_table_new (NULL, NULL);
+
+  /* Only the pages containing every trigram of the search string can match,
+   * so only check the ones in the smallest set */
+  for (str = search; str[0] && str[1] && str[2]; str++) {
+    gpointer trigram = GUINT_TO_POINTER (make_trigram (str));
+    GHashTable *entries = g_hash_table_lookup (self->trigrams, trigram);
+
+    if (!entries)
+      return ret;
+
+    if (!candidates || g_hash_table_size (entries) < g_hash_table_size (candidates))
+      candidates = entries;
+  }
+
+  if (candidates) {
+    g_hash_table_iter_init (&iter, candidates);
+
+    while (g_hash_table_iter_next (&iter, (gpointer *) &entry, NULL))
+      if (entry_matches (entry, search))
+        g_hash_table_add (ret, entry->page);
+  } else {
+    /* Too short for trigrams */
+    g_hash_table_iter_init (&iter, self->entries);
+
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &entry))
+      if (entry_matches (entry, search))
+        g_hash_table_add (ret, entry->page);
+  }
+
+  return ret;
+}
@@ -33,6 +33,9 @@ gboolean adw_tab_thumbnail_get_inverted (AdwTabThumbnail *self);
 void     adw_tab_thumbnail_set_inverted (AdwTabThumbnail *self,
                                          gboolean         inverted);
 
+void adw_tab_thumbnail_set_onscreen (AdwTabThumbnail *self,
+                                     gboolean         onscreen);
+
 void adw_tab_thumbnail_setup_extra_drop_target (AdwTabThumbnail *self,
                                                 GdkDragAction    actions,
                                                 GType           *types,
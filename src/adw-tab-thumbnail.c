@@ -11,23 +11,33 @@
 
 #include "adw-fading-label-private.h"
 #include "adw-gizmo-private.h"
+#include "adw-spinner-paintable-private.h"
 #include "adw-tab-view-private.h"
 #include "adw-timed-animation.h"
 
 #define FADE_TRANSITION_DURATION 250
 #define PINNED_MARGIN 10
 
+typedef enum {
+  THUMBNAIL_UPDATE_TITLE     = 1 << 0,
+  THUMBNAIL_UPDATE_TOOLTIP   = 1 << 1,
+  THUMBNAIL_UPDATE_ICON      = 1 << 2,
+  THUMBNAIL_UPDATE_INDICATOR = 1 << 3,
+  THUMBNAIL_UPDATE_LOADING   = 1 << 4,
+} ThumbnailUpdateFlags;
+
 struct _AdwTabThumbnail
 {
   GtkWidget parent_instance;
 
   GtkWidget *contents;
   GtkWidget *icon_title_box;
+  GtkWidget *title;
   GtkWidget *overlay;
   GtkPicture *picture;
   GtkWidget *icon_stack;
   GtkImage *icon;
-  GtkSpinner *spinner;
+  GtkImage *spinner;
   GtkImage *indicator_icon;
   GtkWidget *indicator_btn;
   GtkWidget *close_btn;
@@ -42,8 +52,15 @@ struct _AdwTabThumbnail
   gboolean pinned;
 
   gboolean inverted;
+  gboolean onscreen;
 
   AdwAnimation *fade_animation;
+
+  GdkPaintable *spinner_paintable;
+
+  /* Page changes are applied once per frame */
+  ThumbnailUpdateFlags pending_updates;
+  guint update_cb_id;
 };
 
 G_DEFINE_FINAL_TYPE (AdwTabThumbnail, adw_tab_thumbnail, GTK_TYPE_WIDGET)
@@ -91,14 +108,33 @@ update_tooltip (AdwTabThumbnail *self)
                                  adw_tab_page_get_title (page));
 }
 
+static void
+update_title (AdwTabThumbnail *self)
+{
+  adw_fading_label_set_label (ADW_FADING_LABEL (self->title),
+                              adw_tab_page_get_title (self->page));
+
+  update_tooltip (self);
+}
+
 static void
 update_spinner (AdwTabThumbnail *self)
 {
   gboolean loading = self->page && adw_tab_page_get_loading (self->page);
   gboolean mapped = gtk_widget_get_mapped (GTK_WIDGET (self));
+  gboolean spinning = loading && mapped && self->onscreen;
 
   /* Don't use CPU when not needed */
-  gtk_spinner_set_spinning (self->spinner, loading && mapped);
+  if (spinning == (self->spinner_paintable != NULL))
+    return;
+
+  if (spinning) {
+    self->spinner_paintable = adw_spinner_paintable_new_for_widget (GTK_WIDGET (self));
+    gtk_image_set_from_paintable (self->spinner, self->spinner_paintable);
+  } else {
+    gtk_image_clear (self->spinner);
+    g_clear_object (&self->spinner_paintable);
+  }
 }
 
 static void
@@ -144,6 +180,87 @@ update_indicator (AdwTabThumbnail *self)
   set_style_class (GTK_WIDGET (self), "indicator", indicator != NULL);
 }
 
+static gboolean
+update_cb (GtkWidget     *widget,
+           GdkFrameClock *frame_clock,
+           gpointer       user_data)
+{
+  AdwTabThumbnail *self = ADW_TAB_THUMBNAIL (widget);
+  ThumbnailUpdateFlags flags = self->pending_updates;
+
+  self->pending_updates = 0;
+  self->update_cb_id = 0;
+
+  if (!self->page)
+    return G_SOURCE_REMOVE;
+
+  if (flags & THUMBNAIL_UPDATE_TITLE)
+    update_title (self);
+  else if (flags & THUMBNAIL_UPDATE_TOOLTIP)
+    update_tooltip (self);
+
+  if (flags & THUMBNAIL_UPDATE_LOADING)
+    update_loading (self);
+  else if (flags & THUMBNAIL_UPDATE_ICON)
+    update_icon (self);
+
+  if (flags & THUMBNAIL_UPDATE_INDICATOR)
+    update_indicator (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+queue_update (AdwTabThumbnail      *self,
+              ThumbnailUpdateFlags  flags)
+{
+  self->pending_updates |= flags;
+
+  if (!self->update_cb_id)
+    self->update_cb_id = gtk_widget_add_tick_callback (GTK_WIDGET (self), update_cb, NULL, NULL);
+}
+
+static void
+cancel_updates (AdwTabThumbnail *self)
+{
+  self->pending_updates = 0;
+
+  if (self->update_cb_id) {
+    gtk_widget_remove_tick_callback (GTK_WIDGET (self), self->update_cb_id);
+    self->update_cb_id = 0;
+  }
+}
+
+static void
+page_notify_title_cb (AdwTabThumbnail *self)
+{
+  queue_update (self, THUMBNAIL_UPDATE_TITLE);
+}
+
+static void
+page_notify_tooltip_cb (AdwTabThumbnail *self)
+{
+  queue_update (self, THUMBNAIL_UPDATE_TOOLTIP);
+}
+
+static void
+page_notify_icon_cb (AdwTabThumbnail *self)
+{
+  queue_update (self, THUMBNAIL_UPDATE_ICON);
+}
+
+static void
+page_notify_indicator_cb (AdwTabThumbnail *self)
+{
+  queue_update (self, THUMBNAIL_UPDATE_INDICATOR);
+}
+
+static void
+page_notify_loading_cb (AdwTabThumbnail *self)
+{
+  queue_update (self, THUMBNAIL_UPDATE_LOADING);
+}
+
 static gboolean
 close_idle_cb (AdwTabThumbnail *self)
 {
@@ -411,6 +528,7 @@ adw_tab_thumbnail_dispose (GObject *object)
   adw_tab_thumbnail_set_page (self, NULL);
 
   g_clear_object (&self->fade_animation);
+  g_clear_object (&self->spinner_paintable);
 
   gtk_widget_dispose_template (GTK_WIDGET (self), ADW_TYPE_TAB_THUMBNAIL);
 
@@ -540,6 +658,7 @@ adw_tab_thumbnail_class_init (AdwTabThumbnailClass *klass)
   gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, contents);
   gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, overlay);
   gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, icon_title_box);
+  gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, title);
   gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, picture);
   gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, icon_stack);
   gtk_widget_class_bind_template_child (widget_class, AdwTabThumbnail, icon);
@@ -569,6 +688,8 @@ adw_tab_thumbnail_init (AdwTabThumbnail *self)
 {
   AdwAnimationTarget *target;
 
+  self->onscreen = TRUE;
+
   gtk_widget_init_template (GTK_WIDGET (self));
 
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc) fade_animation_value_cb,
@@ -611,12 +732,16 @@ adw_tab_thumbnail_set_page (AdwTabThumbnail *self,
     return;
 
   if (self->page) {
-    g_signal_handlers_disconnect_by_func (self->page, update_tooltip, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_icon, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_indicator, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_loading, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_title_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_tooltip_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_icon_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_indicator_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_loading_cb, self);
   }
 
+  /* Everything is updated right away below */
+  cancel_updates (self);
+
   g_set_object (&self->page, page);
 
   if (self->page) {
@@ -624,30 +749,32 @@ adw_tab_thumbnail_set_page (AdwTabThumbnail *self,
 
     gtk_picture_set_paintable (GTK_PICTURE (self->picture), paintable);
 
-    update_tooltip (self);
+    update_title (self);
     update_spinner (self);
     update_icon (self);
     update_indicator (self);
     update_loading (self);
 
     g_signal_connect_object (self->page, "notify::title",
-                             G_CALLBACK (update_tooltip), self,
+                             G_CALLBACK (page_notify_title_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::tooltip",
-                             G_CALLBACK (update_tooltip), self,
+                             G_CALLBACK (page_notify_tooltip_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::icon",
-                             G_CALLBACK (update_icon), self,
+                             G_CALLBACK (page_notify_icon_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::indicator-icon",
-                             G_CALLBACK (update_indicator), self,
+                             G_CALLBACK (page_notify_indicator_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::indicator-activatable",
-                             G_CALLBACK (update_indicator), self,
+                             G_CALLBACK (page_notify_indicator_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::loading",
-                             G_CALLBACK (update_loading), self,
+                             G_CALLBACK (page_notify_loading_cb), self,
                              G_CONNECT_SWAPPED);
+  } else {
+    adw_fading_label_set_label (ADW_FADING_LABEL (self->title), NULL);
   }
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_PAGE]);
@@ -692,6 +819,22 @@ adw_tab_thumbnail_set_inverted (AdwTabThumbnail *self,
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_INVERTED]);
 }
 
+void
+adw_tab_thumbnail_set_onscreen (AdwTabThumbnail *self,
+                                gboolean         onscreen)
+{
+  g_return_if_fail (ADW_IS_TAB_THUMBNAIL (self));
+
+  onscreen = !!onscreen;
+
+  if (self->onscreen == onscreen)
+    return;
+
+  self->onscreen = onscreen;
+
+  update_spinner (self);
+}
+
 void
 adw_tab_thumbnail_setup_extra_drop_target (AdwTabThumbnail *self,
                                            GdkDragAction    actions,
@@ -13,6 +13,7 @@
 #endif
 
 #include "adw-tab-view.h"
+#include "adw-tab-search-index-private.h"
 
 G_BEGIN_DECLS
 
@@ -32,4 +33,11 @@ AdwTabView *adw_tab_view_create_window (AdwTabView *self) G_GNUC_WARN_UNUSED_RES
 void adw_tab_view_open_overview (AdwTabView *self);
 void adw_tab_view_close_overview (AdwTabView *self);
 
+ADW_AVAILABLE_IN_ALL
+gint64 adw_tab_view_get_last_switch_duration (AdwTabView *self);
+
+gboolean adw_tab_view_get_is_batching (AdwTabView *self);
+
+AdwTabSearchIndex *adw_tab_view_get_search_index (AdwTabView *self);
+
 G_END_DECLS
@@ -7,6 +7,7 @@
  */
 
 #include "config.h"
+#include <math.h>
 
 #include "adw-tab-view-private.h"
 
@@ -14,6 +15,7 @@
 #include "adw-gizmo-private.h"
 #include "adw-marshalers.h"
 #include "adw-style-manager.h"
+#include "adw-tab-search-index-private.h"
 #include "adw-widget-utils-private.h"
 
 /* FIXME replace with groups */
@@ -24,6 +26,17 @@ static GSList *tab_view_list;
 #define DEFAULT_ICON_ALPHA_HC 0.3
 #define DEFAULT_ICON_ALPHA 0.15
 
+/* Matches the largest thumbnail AdwTabGrid will show */
+#define THUMBNAIL_WIDTH 500
+#define DEFAULT_THUMBNAIL_CACHE_SIZE (128 * 1024 * 1024)
+#define THUMBNAIL_FRAME_BUDGET 4000 /* µs */
+
+/* Must be bumped whenever the format of saved states changes */
+#define STATE_VERSION 1
+#define STATE_THUMBNAIL_TYPE "(uuuuay)"
+#define STATE_PAGE_TYPE "(ssmsmvmvsbddm" STATE_THUMBNAIL_TYPE ")"
+#define STATE_TYPE "(uia" STATE_PAGE_TYPE ")"
+
 /**
  * AdwTabView:
  *
@@ -121,6 +134,19 @@ static GSList *tab_view_list;
  * Since: 1.2
  */
 
+/**
+ * AdwTabViewStateFlags:
+ * @ADW_TAB_VIEW_STATE_NONE: Only save the page order and properties
+ * @ADW_TAB_VIEW_STATE_THUMBNAILS: Also save the thumbnails that are currently
+ *   rendered or stored
+ *
+ * Describes what [method@TabView.save_state] includes.
+ *
+ * New values may be added to this enumeration over time.
+ *
+ * Since: 1.4
+ */
+
 struct _AdwTabPage
 {
   GObject parent_instance;
@@ -152,7 +178,20 @@ struct _AdwTabPage
 
   gboolean live_thumbnail;
   gboolean invalidated;
+  gboolean thumbnail_requested;
   gboolean in_destruction;
+
+  AdwTabPageFactoryFunc factory;
+  gpointer factory_data;
+  GDestroyNotify factory_destroy;
+  GdkTexture *thumbnail;
+
+  gboolean can_hibernate;
+  gboolean hibernated;
+  guint64 last_selected;
+  gboolean warm;
+
+  int position;
 };
 
 static void adw_tab_page_accessible_init (GtkAccessibleInterface *iface);
@@ -178,6 +217,8 @@ enum {
   PAGE_PROP_THUMBNAIL_XALIGN,
   PAGE_PROP_THUMBNAIL_YALIGN,
   PAGE_PROP_LIVE_THUMBNAIL,
+  PAGE_PROP_CAN_HIBERNATE,
+  PAGE_PROP_HIBERNATED,
   LAST_PAGE_PROP,
   PAGE_PROP_ACCESSIBLE_ROLE
 };
@@ -188,7 +229,8 @@ struct _AdwTabView
 {
   GtkWidget parent_instance;
 
-  GListStore *children;
+  GPtrArray *children;
+  GHashTable *child_pages;
 
   int n_pages;
   int n_pinned_pages;
@@ -200,6 +242,36 @@ struct _AdwTabView
   int transfer_count;
   int overview_count;
   gulong unmap_extra_pages_cb;
+  guint render_thumbnails_cb;
+  GPtrArray *pending_thumbnails;
+  gboolean pending_thumbnails_dirty;
+  gint64 thumbnail_snapshot_cost; /* µs */
+  gint64 thumbnail_render_cost; /* µs */
+
+  int max_live_pages;
+  guint hibernate_pages_cb;
+  guint64 selection_serial;
+  guint n_hibernated;
+  guint n_restored;
+
+  int max_warm_pages;
+  gint64 switch_start_time;
+  gint64 last_switch_duration;
+  GdkFrameClock *switch_frame_clock;
+  gulong switch_after_paint_id;
+
+  int batch_depth;
+  int pending_removal_pos;
+  int pending_removal_n;
+
+  AdwTabSearchIndex *search_index;
+
+  GQueue thumbnail_cache;
+  guint64 thumbnail_cache_used;
+  guint64 thumbnail_cache_size;
+
+  GQueue rasterize_queue;
+  guint rasterize_thumbnails_cb;
 
   GtkSelectionModel *pages;
 };
@@ -223,6 +295,9 @@ enum {
   PROP_MENU_MODEL,
   PROP_SHORTCUTS,
   PROP_PAGES,
+  PROP_THUMBNAIL_CACHE_SIZE,
+  PROP_MAX_LIVE_PAGES,
+  PROP_MAX_WARM_PAGES,
   LAST_PROP
 };
 
@@ -236,6 +311,7 @@ enum {
   SIGNAL_SETUP_MENU,
   SIGNAL_CREATE_WINDOW,
   SIGNAL_INDICATOR_ACTIVATED,
+  SIGNAL_HIBERNATE_PAGE,
   SIGNAL_LAST_SIGNAL,
 };
 
@@ -248,9 +324,208 @@ page_should_be_visible (AdwTabView *view,
   if (!view->overview_count)
     return FALSE;
 
+  /* Don't create the child of a lazy page just to update its thumbnail */
+  if (!page->child)
+    return page->live_thumbnail;
+
   return page->live_thumbnail || page->invalidated;
 }
 
+static void
+set_page_child (AdwTabPage *self,
+                GtkWidget  *child)
+{
+  if (!g_set_object (&self->child, child))
+    return;
+
+  adw_bin_set_child (ADW_BIN (self->bin), child);
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_CHILD]);
+}
+
+static void
+clear_page_factory (AdwTabPage *self)
+{
+  if (self->factory_destroy)
+    self->factory_destroy (self->factory_data);
+
+  self->factory = NULL;
+  self->factory_data = NULL;
+  self->factory_destroy = NULL;
+}
+
+static void
+ensure_page_child (AdwTabView *view,
+                   AdwTabPage *page)
+{
+  GtkWidget *child;
+
+  if (page->child || !page->factory)
+    return;
+
+  child = page->factory (page, page->factory_data);
+
+  if (!child) {
+    g_critical ("AdwTabPageFactoryFunc must not return NULL");
+
+    return;
+  }
+
+  set_page_child (page, child);
+
+  g_hash_table_insert (view->child_pages, page->child, page);
+
+  if (page->hibernated) {
+    page->hibernated = FALSE;
+    view->n_restored++;
+
+    g_object_notify_by_pspec (G_OBJECT (page), page_props[PAGE_PROP_HIBERNATED]);
+  }
+}
+
+static void
+record_thumbnail_cost (gint64 *cost,
+                       gint64  sample)
+{
+  if (*cost)
+    *cost = (*cost * 3 + sample) / 4;
+  else
+    *cost = sample;
+}
+
+static gboolean
+page_needs_thumbnail (AdwTabView *view,
+                      AdwTabPage *page)
+{
+  return page != view->selected_page &&
+         page_should_be_visible (view, page) &&
+         !gtk_widget_get_child_visible (page->bin);
+}
+
+/* Thumbnails currently shown as placeholders come first, the rest are sorted
+ * by their distance from the selected page, which the overview scrolls to. The
+ * queue is sorted in reverse, so that the next page is popped from the end */
+static int
+compare_thumbnail_priority (gconstpointer a,
+                            gconstpointer b,
+                            gpointer      user_data)
+{
+  AdwTabPage *page_a = *(AdwTabPage **) a;
+  AdwTabPage *page_b = *(AdwTabPage **) b;
+  int selected_pos = GPOINTER_TO_INT (user_data);
+  int distance_a, distance_b;
+
+  if (page_a->thumbnail_requested != page_b->thumbnail_requested)
+    return page_a->thumbnail_requested ? 1 : -1;
+
+  distance_a = ABS (page_a->position - selected_pos);
+  distance_b = ABS (page_b->position - selected_pos);
+
+  return distance_b - distance_a;
+}
+
+static void
+rebuild_pending_thumbnails (AdwTabView *self)
+{
+  int selected_pos = self->selected_page ? self->selected_page->position : 0;
+  int i;
+
+  g_ptr_array_set_size (self->pending_thumbnails, 0);
+
+  for (i = 0; i < self->n_pages; i++) {
+    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+
+    if (page_needs_thumbnail (self, page))
+      g_ptr_array_add (self->pending_thumbnails, page);
+  }
+
+  g_ptr_array_sort_with_data (self->pending_thumbnails,
+                              compare_thumbnail_priority,
+                              GINT_TO_POINTER (selected_pos));
+
+  self->pending_thumbnails_dirty = FALSE;
+}
+
+static void
+invalidate_pending_thumbnails (AdwTabView *self)
+{
+  self->pending_thumbnails_dirty = TRUE;
+}
+
+static AdwTabPage *
+pop_next_thumbnail (AdwTabView *self)
+{
+  if (self->pending_thumbnails_dirty)
+    rebuild_pending_thumbnails (self);
+
+  while (self->pending_thumbnails->len > 0) {
+    AdwTabPage *page;
+
+    page = g_ptr_array_remove_index_fast (self->pending_thumbnails,
+                                          self->pending_thumbnails->len - 1);
+
+    /* It may have been mapped or selected since the queue was built */
+    if (page_needs_thumbnail (self, page))
+      return page;
+  }
+
+  return NULL;
+}
+
+static gboolean
+render_thumbnails_cb (GtkWidget     *widget,
+                      GdkFrameClock *frame_clock,
+                      gpointer       user_data)
+{
+  AdwTabView *self = ADW_TAB_VIEW (widget);
+  gint64 cost = self->thumbnail_snapshot_cost + self->thumbnail_render_cost;
+  gint64 spent = 0;
+
+  /* Pages mapped here are drawn later in the same frame, so use the cost
+   * measured on the previous ones to decide how many fit into the budget. As
+   * long as the cost is unknown, do one page per frame */
+  do {
+    AdwTabPage *page = pop_next_thumbnail (self);
+
+    if (!page) {
+      self->render_thumbnails_cb = 0;
+
+      return G_SOURCE_REMOVE;
+    }
+
+    ensure_page_child (self, page);
+
+    gtk_widget_set_child_visible (page->bin, TRUE);
+    gtk_widget_queue_allocate (widget);
+
+    spent += cost;
+  } while (cost > 0 && spent + cost <= THUMBNAIL_FRAME_BUDGET);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+schedule_thumbnails (AdwTabView *self)
+{
+  invalidate_pending_thumbnails (self);
+
+  if (self->render_thumbnails_cb)
+    return;
+
+  self->render_thumbnails_cb =
+    gtk_widget_add_tick_callback (GTK_WIDGET (self), render_thumbnails_cb, NULL, NULL);
+}
+
+static void
+unschedule_thumbnails (AdwTabView *self)
+{
+  if (!self->render_thumbnails_cb)
+    return;
+
+  gtk_widget_remove_tick_callback (GTK_WIDGET (self), self->render_thumbnails_cb);
+  self->render_thumbnails_cb = 0;
+}
+
 static void
 set_page_selected (AdwTabPage *self,
                    gboolean    selected)
@@ -342,11 +617,17 @@ map_or_unmap_page (AdwTabPage *self)
     return;
 
   should_be_visible = self == view->selected_page ||
+  self->warm ||
   page_should_be_visible (view, self);
 
   if (gtk_widget_get_child_visible (self->bin) == should_be_visible)
     return;
 
+  if (should_be_visible && self != view->selected_page) {
+    schedule_thumbnails (view);
+    return;
+  }
+
   gtk_widget_set_child_visible (self->bin, should_be_visible);
   gtk_widget_queue_allocate (parent);
 }
@@ -373,7 +654,10 @@ adw_tab_page_finalize (GObject *object)
 {
   AdwTabPage *self = (AdwTabPage *)object;
 
+  clear_page_factory (self);
+
   g_clear_object (&self->child);
+  g_clear_object (&self->thumbnail);
   g_clear_pointer (&self->title, g_free);
   g_clear_pointer (&self->tooltip, g_free);
   g_clear_object (&self->icon);
@@ -461,6 +745,14 @@ adw_tab_page_get_property (GObject    *object,
     g_value_set_boolean (value, adw_tab_page_get_live_thumbnail (self));
     break;
 
+  case PAGE_PROP_CAN_HIBERNATE:
+    g_value_set_boolean (value, adw_tab_page_get_can_hibernate (self));
+    break;
+
+  case PAGE_PROP_HIBERNATED:
+    g_value_set_boolean (value, adw_tab_page_get_hibernated (self));
+    break;
+
   case PAGE_PROP_ACCESSIBLE_ROLE:
     g_value_set_enum (value, GTK_ACCESSIBLE_ROLE_TAB_PANEL);
     break;
@@ -480,8 +772,7 @@ adw_tab_page_set_property (GObject      *object,
 
   switch (prop_id) {
   case PAGE_PROP_CHILD:
-    g_set_object (&self->child, g_value_get_object (value));
-    adw_bin_set_child (ADW_BIN (self->bin), g_value_get_object (value));
+    set_page_child (self, g_value_get_object (value));
     break;
 
   case PAGE_PROP_PARENT:
@@ -536,6 +827,10 @@ adw_tab_page_set_property (GObject      *object,
     adw_tab_page_set_live_thumbnail (self, g_value_get_boolean (value));
     break;
 
+  case PAGE_PROP_CAN_HIBERNATE:
+    adw_tab_page_set_can_hibernate (self, g_value_get_boolean (value));
+    break;
+
   case PAGE_PROP_ACCESSIBLE_ROLE:
     break;
 
@@ -558,6 +853,9 @@ adw_tab_page_class_init (AdwTabPageClass *klass)
    * AdwTabPage:child: (attributes org.gtk.Property.get=adw_tab_page_get_child)
    *
    * The child of the page.
+   *
+   * For pages added with [method@TabView.insert_lazy], this is `NULL` until
+   * the page is selected or its live thumbnail is needed.
    */
   page_props[PAGE_PROP_CHILD] =
     g_param_spec_object ("child", NULL, NULL,
@@ -820,6 +1118,39 @@ adw_tab_page_class_init (AdwTabPageClass *klass)
                           FALSE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwTabPage:can-hibernate: (attributes org.gtk.Property.get=adw_tab_page_get_can_hibernate org.gtk.Property.set=adw_tab_page_set_can_hibernate)
+   *
+   * Whether the page can be hibernated.
+   *
+   * Hibernated pages don't have a child. It's recreated with the page's factory
+   * when the page is selected again, so only pages with a factory can be
+   * hibernated, see [method@TabPage.set_child_factory].
+   *
+   * Pages are hibernated when [property@TabView:max-live-pages] is exceeded,
+   * starting from the least recently selected one.
+   *
+   * Since: 1.4
+   */
+  page_props[PAGE_PROP_CAN_HIBERNATE] =
+    g_param_spec_boolean ("can-hibernate", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwTabPage:hibernated: (attributes org.gtk.Property.get=adw_tab_page_get_hibernated)
+   *
+   * Whether the page is currently hibernated.
+   *
+   * See [property@TabPage:can-hibernate].
+   *
+   * Since: 1.4
+   */
+  page_props[PAGE_PROP_HIBERNATED] =
+    g_param_spec_boolean ("hibernated", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (object_class, LAST_PAGE_PROP, page_props);
 
   g_object_class_override_property (object_class, PAGE_PROP_ACCESSIBLE_ROLE, "accessible-role");
@@ -833,6 +1164,7 @@ adw_tab_page_init (AdwTabPage *self)
   self->indicator_tooltip = g_strdup ("");
   self->thumbnail_xalign = 0;
   self->thumbnail_yalign = 0;
+  self->position = -1;
   self->bin = g_object_ref_sink (adw_bin_new ());
 }
 
@@ -898,19 +1230,27 @@ static GtkAccessible *
 adw_tab_page_accessible_get_next_accessible_sibling (GtkAccessible *accessible)
 {
   AdwTabPage *self = ADW_TAB_PAGE (accessible);
-  GtkWidget *view = gtk_widget_get_parent (self->bin);
+  GtkWidget *parent;
+  AdwTabView *view;
   AdwTabPage *next_page;
-  int pos;
 
-  if (!ADW_TAB_VIEW (view))
+  if (!self->bin)
+    return NULL;
+
+  parent = gtk_widget_get_parent (self->bin);
+
+  if (!ADW_IS_TAB_VIEW (parent))
     return NULL;
 
-  pos = adw_tab_view_get_page_position (ADW_TAB_VIEW (view), self);
+  view = ADW_TAB_VIEW (parent);
 
-  if (pos >= adw_tab_view_get_n_pages (ADW_TAB_VIEW (view)) - 1)
+  /* Screen readers walk through all pages this way, so use the stored
+   * position directly instead of going through the checks in the public
+   * getters for every step */
+  if (self->position < 0 || self->position >= view->n_pages - 1)
     return NULL;
 
-  next_page = adw_tab_view_get_nth_page (ADW_TAB_VIEW (view), pos + 1);
+  next_page = g_ptr_array_index (view->children, self->position + 1);
 
   return GTK_ACCESSIBLE (g_object_ref (next_page));
 }
@@ -958,6 +1298,15 @@ struct _AdwTabPaintable
   GdkPaintable *cached_paintable;
   double cached_aspect_ratio;
 
+  GdkTexture *texture;
+  int texture_scale;
+  guint64 texture_size;
+  AdwTabView *cache_view;
+  GList cache_link;
+
+  AdwTabView *rasterize_view;
+  GList rasterize_link;
+
   gboolean frozen;
 
   double last_xalign;
@@ -971,6 +1320,9 @@ get_background_color (AdwTabPaintable *self,
 {
   GtkWidget *child = adw_tab_page_get_child (self->page);
 
+  if (!child)
+    child = self->page->bin;
+
   if (adw_widget_lookup_color (child, "thumbnail_bg_color", rgba))
     return;
 
@@ -980,113 +1332,360 @@ get_background_color (AdwTabPaintable *self,
   rgba->alpha = 1;
 }
 
-static void
-invalidate_contents_and_clear_cache (AdwTabPaintable *self)
+static gboolean
+is_live (AdwTabPaintable *self)
 {
-  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
-
-  if (!self->frozen &&
-      self->page->bin &&
-      gtk_widget_get_mapped (self->page->bin))
-    g_clear_object (&self->cached_paintable);
+  return !self->frozen &&
+         self->page->bin &&
+         gtk_widget_get_mapped (self->page->bin);
 }
 
-static double
-get_unclamped_aspect_ratio (AdwTabPaintable *self)
+static void
+remove_from_cache (AdwTabPaintable *self)
 {
-  if (self->frozen || !self->view_paintable)
-    return self->cached_aspect_ratio;
+  AdwTabView *view = self->cache_view;
 
-  return gdk_paintable_get_intrinsic_aspect_ratio (self->view_paintable);
+  if (!view)
+    return;
+
+  g_queue_unlink (&view->thumbnail_cache, &self->cache_link);
+  view->thumbnail_cache_used -= self->texture_size;
+  self->cache_view = NULL;
 }
 
 static void
-child_unmap_cb (AdwTabPaintable *self)
+clear_texture (AdwTabPaintable *self)
 {
-  if (self->frozen)
-    return;
+  remove_from_cache (self);
 
-  g_clear_object (&self->cached_paintable);
-  self->cached_paintable = gdk_paintable_get_current_image (self->child_paintable);
-  self->cached_aspect_ratio = get_unclamped_aspect_ratio (self);
+  g_clear_object (&self->texture);
+  self->texture_size = 0;
 }
 
+/* The most recently used texture is never evicted, otherwise a texture larger
+ * than the whole cache would be thrown away as soon as it's rendered. Neither
+ * are the textures of pages without a child, such as hibernated pages, since
+ * they have no way to render them again */
 static void
-connect_to_view (AdwTabPaintable *self)
+trim_thumbnail_cache (AdwTabView *view)
 {
-  if (self->view || !gtk_widget_get_parent (self->page->bin))
-    return;
+  GList *link = g_queue_peek_tail_link (&view->thumbnail_cache);
 
-  self->view = gtk_widget_get_parent (self->page->bin);
-  self->view_paintable = gtk_widget_paintable_new (self->view);
+  while (link && link->prev &&
+         view->thumbnail_cache_used > view->thumbnail_cache_size) {
+    AdwTabPaintable *paintable = link->data;
 
-  g_signal_connect_swapped (self->view_paintable, "invalidate-size",
-                            G_CALLBACK (gdk_paintable_invalidate_size), self);
+    link = link->prev;
+
+    if (!paintable->page->child)
+      continue;
+
+    clear_texture (paintable);
+
+    /* Render it again the next time the overview is open */
+    paintable->page->invalidated = TRUE;
+
+    gdk_paintable_invalidate_contents (GDK_PAINTABLE (paintable));
+  }
 }
 
 static void
-disconnect_from_view (AdwTabPaintable *self)
+add_to_cache (AdwTabPaintable *self)
 {
-  g_clear_object (&self->view_paintable);
-  self->view = NULL;
+  AdwTabView *view;
+
+  if (!self->texture || !self->view || self->cache_view)
+    return;
+
+  view = ADW_TAB_VIEW (self->view);
+
+  g_queue_push_head_link (&view->thumbnail_cache, &self->cache_link);
+  view->thumbnail_cache_used += self->texture_size;
+  self->cache_view = view;
+
+  trim_thumbnail_cache (view);
 }
 
 static void
-child_parent_changed (AdwTabPaintable *self)
+touch_cache (AdwTabPaintable *self)
 {
-  disconnect_from_view (self);
-  connect_to_view (self);
-}
+  AdwTabView *view = self->cache_view;
 
-static double
-adw_tab_paintable_get_intrinsic_aspect_ratio (GdkPaintable *paintable)
-{
-  AdwTabPaintable *self = ADW_TAB_PAINTABLE (paintable);
-  double ratio = get_unclamped_aspect_ratio (self);
+  if (!view)
+    return;
 
-  return CLAMP (ratio, MIN_ASPECT_RATIO, MAX_ASPECT_RATIO);
+  g_queue_unlink (&view->thumbnail_cache, &self->cache_link);
+  g_queue_push_head_link (&view->thumbnail_cache, &self->cache_link);
 }
 
 static void
-snapshot_default_icon (GtkSnapshot *snapshot,
-                       double       width,
-                       double       height,
-                       GtkWidget   *view)
+render_thumbnail (AdwTabPaintable *self)
 {
-  GdkDisplay *display;
-  GtkIconTheme *icon_theme;
-  GIcon *default_icon;
-  GtkIconPaintable *icon;
-  GdkRGBA colors[4];
-  double x, y;
-  double view_width, view_height;
-  double view_ratio, snapshot_ratio;
-  double icon_size;
-  gboolean hc;
+  GtkNative *native;
+  GskRenderer *renderer;
+  GtkSnapshot *snapshot;
+  GskRenderNode *node;
+  int scale_factor, width, height;
+  gint64 start;
 
-  view_width = gtk_widget_get_width (view);
-  view_height = gtk_widget_get_height (view);
+  if (!self->view || self->cached_aspect_ratio <= 0)
+    return;
 
-  view_ratio = view_width / view_height;
-  snapshot_ratio = width / height;
+  native = gtk_widget_get_native (self->view);
 
-  if (view_ratio > snapshot_ratio) {
-    double new_width = height * view_ratio;
+  if (!native)
+    return;
 
-    gtk_snapshot_translate (snapshot,
-                            &GRAPHENE_POINT_INIT ((float) (width - new_width) / 2, 0));
+  renderer = gtk_native_get_renderer (native);
 
-    width = new_width;
-  } else if (view_ratio < snapshot_ratio) {
-    double new_height = width / view_ratio;
+  if (!renderer)
+    return;
 
-    gtk_snapshot_translate (snapshot,
-                            &GRAPHENE_POINT_INIT (0, (float) (height - new_height) / 2));
+  scale_factor = gtk_widget_get_scale_factor (self->view);
+  width = MIN (gtk_widget_get_width (self->view), THUMBNAIL_WIDTH) * scale_factor;
+  height = (int) ceil (width / self->cached_aspect_ratio);
 
-    height = new_height;
+  if (width <= 0 || height <= 0)
+    return;
+
+  start = g_get_monotonic_time ();
+
+  snapshot = gtk_snapshot_new ();
+  gdk_paintable_snapshot (self->cached_paintable, GDK_SNAPSHOT (snapshot), width, height);
+  node = gtk_snapshot_free_to_node (snapshot);
+
+  clear_texture (self);
+
+  if (node) {
+    self->texture = gsk_renderer_render_texture (renderer, node,
+                                                 &GRAPHENE_RECT_INIT (0, 0, width, height));
+    self->texture_scale = scale_factor;
+    self->texture_size = (guint64) width * height * 4;
+
+    gsk_render_node_unref (node);
+
+    add_to_cache (self);
   }
 
-  icon_size = MIN (view_width / 4, view_height / 4);
+  /* Once the texture is in the cache, it's all we need from now on */
+  if (self->cache_view || !node)
+    g_clear_object (&self->cached_paintable);
+
+  record_thumbnail_cost (&ADW_TAB_VIEW (self->view)->thumbnail_render_cost,
+                         g_get_monotonic_time () - start);
+}
+
+static gboolean
+rasterize_thumbnails_cb (AdwTabView *self)
+{
+  gint64 spent = 0;
+
+  /* Same as render_thumbnails_cb(), use the cost of the previous thumbnails to
+   * decide how many to render before returning to the main loop */
+  do {
+    GList *link = g_queue_pop_head_link (&self->rasterize_queue);
+    AdwTabPaintable *paintable;
+
+    if (!link) {
+      self->rasterize_thumbnails_cb = 0;
+
+      return G_SOURCE_REMOVE;
+    }
+
+    paintable = link->data;
+    paintable->rasterize_view = NULL;
+
+    if (paintable->cached_paintable && !is_live (paintable)) {
+      render_thumbnail (paintable);
+
+      spent += self->thumbnail_render_cost;
+    }
+  } while (self->thumbnail_render_cost > 0 &&
+           spent + self->thumbnail_render_cost <= THUMBNAIL_FRAME_BUDGET);
+
+  return G_SOURCE_CONTINUE;
+}
+
+/* Rendering a texture can't happen during snapshot, so it's deferred to an
+ * idle, and the cached paintable is drawn in the meantime */
+static void
+queue_rasterize (AdwTabPaintable *self)
+{
+  AdwTabView *view;
+
+  if (!self->view || self->rasterize_view)
+    return;
+
+  view = ADW_TAB_VIEW (self->view);
+
+  g_queue_push_tail_link (&view->rasterize_queue, &self->rasterize_link);
+  self->rasterize_view = view;
+
+  if (!view->rasterize_thumbnails_cb)
+    view->rasterize_thumbnails_cb =
+      g_idle_add ((GSourceFunc) rasterize_thumbnails_cb, view);
+}
+
+static void
+unqueue_rasterize (AdwTabPaintable *self)
+{
+  if (!self->rasterize_view)
+    return;
+
+  g_queue_unlink (&self->rasterize_view->rasterize_queue, &self->rasterize_link);
+  self->rasterize_view = NULL;
+}
+
+static void
+set_stored_thumbnail (AdwTabPaintable *self,
+                      GdkTexture      *texture)
+{
+  int width = gdk_texture_get_width (texture);
+  int height = gdk_texture_get_height (texture);
+
+  if (self->cached_paintable || self->texture || width <= 0 || height <= 0)
+    return;
+
+  self->texture = g_object_ref (texture);
+  self->texture_scale = 0;
+  self->texture_size = (guint64) width * height * 4;
+  self->cached_aspect_ratio = (double) width / height;
+
+  add_to_cache (self);
+
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+static void
+invalidate_contents_and_clear_cache (AdwTabPaintable *self)
+{
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+
+  if (is_live (self)) {
+    g_clear_object (&self->cached_paintable);
+    clear_texture (self);
+  }
+}
+
+static double
+get_unclamped_aspect_ratio (AdwTabPaintable *self)
+{
+  if (self->frozen || !self->view_paintable)
+    return self->cached_aspect_ratio;
+
+  return gdk_paintable_get_intrinsic_aspect_ratio (self->view_paintable);
+}
+
+static void
+child_unmap_cb (AdwTabPaintable *self)
+{
+  if (self->frozen)
+    return;
+
+  g_clear_object (&self->cached_paintable);
+  clear_texture (self);
+
+  self->cached_paintable = gdk_paintable_get_current_image (self->child_paintable);
+  self->cached_aspect_ratio = get_unclamped_aspect_ratio (self);
+}
+
+static void
+view_scale_factor_changed_cb (AdwTabPaintable *self)
+{
+  if (self->texture &&
+      self->texture_scale &&
+      self->texture_scale != gtk_widget_get_scale_factor (self->view))
+    adw_tab_page_invalidate_thumbnail (self->page);
+}
+
+static void
+connect_to_view (AdwTabPaintable *self)
+{
+  if (self->view || !gtk_widget_get_parent (self->page->bin))
+    return;
+
+  self->view = gtk_widget_get_parent (self->page->bin);
+  self->view_paintable = gtk_widget_paintable_new (self->view);
+
+  g_signal_connect_swapped (self->view_paintable, "invalidate-size",
+                            G_CALLBACK (gdk_paintable_invalidate_size), self);
+  g_signal_connect_swapped (self->view, "notify::scale-factor",
+                            G_CALLBACK (view_scale_factor_changed_cb), self);
+
+  add_to_cache (self);
+}
+
+static void
+disconnect_from_view (AdwTabPaintable *self)
+{
+  remove_from_cache (self);
+  unqueue_rasterize (self);
+
+  if (self->view)
+    g_signal_handlers_disconnect_by_func (self->view,
+                                          view_scale_factor_changed_cb,
+                                          self);
+
+  g_clear_object (&self->view_paintable);
+  self->view = NULL;
+}
+
+static void
+child_parent_changed (AdwTabPaintable *self)
+{
+  disconnect_from_view (self);
+  connect_to_view (self);
+}
+
+static double
+adw_tab_paintable_get_intrinsic_aspect_ratio (GdkPaintable *paintable)
+{
+  AdwTabPaintable *self = ADW_TAB_PAINTABLE (paintable);
+  double ratio = get_unclamped_aspect_ratio (self);
+
+  return CLAMP (ratio, MIN_ASPECT_RATIO, MAX_ASPECT_RATIO);
+}
+
+static void
+snapshot_default_icon (GtkSnapshot *snapshot,
+                       double       width,
+                       double       height,
+                       GtkWidget   *view)
+{
+  GdkDisplay *display;
+  GtkIconTheme *icon_theme;
+  GIcon *default_icon;
+  GtkIconPaintable *icon;
+  GdkRGBA colors[4];
+  double x, y;
+  double view_width, view_height;
+  double view_ratio, snapshot_ratio;
+  double icon_size;
+  gboolean hc;
+
+  view_width = gtk_widget_get_width (view);
+  view_height = gtk_widget_get_height (view);
+
+  view_ratio = view_width / view_height;
+  snapshot_ratio = width / height;
+
+  if (view_ratio > snapshot_ratio) {
+    double new_width = height * view_ratio;
+
+    gtk_snapshot_translate (snapshot,
+                            &GRAPHENE_POINT_INIT ((float) (width - new_width) / 2, 0));
+
+    width = new_width;
+  } else if (view_ratio < snapshot_ratio) {
+    double new_height = width / view_ratio;
+
+    gtk_snapshot_translate (snapshot,
+                            &GRAPHENE_POINT_INIT (0, (float) (height - new_height) / 2));
+
+    height = new_height;
+  }
+
+  icon_size = MIN (view_width / 4, view_height / 4);
 
   display = gtk_widget_get_display (view);
   icon_theme = gtk_icon_theme_get_for_display (display);
@@ -1194,6 +1793,9 @@ adw_tab_paintable_snapshot (GdkPaintable *paintable,
       xalign = 1 - xalign;
   }
 
+  if (self->cached_paintable && !is_live (self))
+    queue_rasterize (self);
+
   if (self->cached_paintable) {
     snapshot_paintable (GTK_SNAPSHOT (snapshot), width, height,
                         self->cached_paintable, self->cached_aspect_ratio,
@@ -1201,6 +1803,24 @@ adw_tab_paintable_snapshot (GdkPaintable *paintable,
     return;
   }
 
+  /* Let the view know this thumbnail is on screen, in case it's waiting to be
+   * rendered */
+  if (!self->frozen && !self->page->thumbnail_requested) {
+    self->page->thumbnail_requested = TRUE;
+
+    if (self->view)
+      invalidate_pending_thumbnails (ADW_TAB_VIEW (self->view));
+  }
+
+  if (self->texture) {
+    touch_cache (self);
+
+    snapshot_paintable (GTK_SNAPSHOT (snapshot), width, height,
+                        GDK_PAINTABLE (self->texture), self->cached_aspect_ratio,
+                        xalign, yalign);
+    return;
+  }
+
   if (child && gtk_widget_get_mapped (child)) {
     double aspect_ratio = get_unclamped_aspect_ratio (self);
 
@@ -1242,6 +1862,7 @@ adw_tab_paintable_dispose (GObject *object)
 
   g_clear_object (&self->child_paintable);
   g_clear_object (&self->cached_paintable);
+  clear_texture (self);
 
   G_OBJECT_CLASS (adw_tab_paintable_parent_class)->dispose (object);
 }
@@ -1257,6 +1878,8 @@ adw_tab_paintable_class_init (AdwTabPaintableClass *klass)
 static void
 adw_tab_paintable_init (AdwTabPaintable *self)
 {
+  self->cache_link.data = self;
+  self->rasterize_link.data = self;
 }
 
 static GdkPaintable *
@@ -1287,6 +1910,11 @@ adw_tab_paintable_new (AdwTabPage *page)
                            G_CALLBACK (child_unmap_cb), self,
                            G_CONNECT_SWAPPED);
 
+  if (page->thumbnail) {
+    set_stored_thumbnail (self, page->thumbnail);
+    g_clear_object (&page->thumbnail);
+  }
+
   return GDK_PAINTABLE (self);
 }
 
@@ -1306,6 +1934,201 @@ adw_tab_paintable_freeze (AdwTabPaintable *self)
   g_clear_object (&self->child_paintable);
 }
 
+static void
+freeze_thumbnail (AdwTabPaintable *self)
+{
+  if (self->cached_paintable && !is_live (self))
+    render_thumbnail (self);
+}
+
+static gboolean
+page_can_hibernate (AdwTabView *self,
+                    AdwTabPage *page)
+{
+  return page->can_hibernate &&
+         page->factory &&
+         page->child &&
+         !page->closing &&
+         page != self->selected_page &&
+         gtk_widget_get_parent (page->bin) == GTK_WIDGET (self) &&
+         !gtk_widget_get_child_visible (page->bin);
+}
+
+static gboolean
+hibernate_page (AdwTabView *self,
+                AdwTabPage *page)
+{
+  gboolean vetoed = FALSE;
+
+  g_signal_emit (self, signals[SIGNAL_HIBERNATE_PAGE], 0, page, &vetoed);
+
+  /* The handler may have closed or selected the page */
+  if (vetoed || !page_can_hibernate (self, page))
+    return FALSE;
+
+  /* Keep showing the page contents in the overview */
+  if (page->paintable)
+    freeze_thumbnail (ADW_TAB_PAINTABLE (page->paintable));
+
+  g_hash_table_remove (self->child_pages, page->child);
+
+  if (page->last_focus) {
+    g_object_remove_weak_pointer (G_OBJECT (page->last_focus),
+                                  (gpointer *) &page->last_focus);
+    page->last_focus = NULL;
+  }
+
+  set_page_child (page, NULL);
+
+  page->hibernated = TRUE;
+  self->n_hibernated++;
+
+  g_object_notify_by_pspec (G_OBJECT (page), page_props[PAGE_PROP_HIBERNATED]);
+
+  return TRUE;
+}
+
+static int
+compare_last_selected (gconstpointer a,
+                       gconstpointer b)
+{
+  AdwTabPage *page_a = *(AdwTabPage **) a;
+  AdwTabPage *page_b = *(AdwTabPage **) b;
+
+  if (page_a->last_selected < page_b->last_selected)
+    return -1;
+
+  if (page_a->last_selected > page_b->last_selected)
+    return 1;
+
+  return 0;
+}
+
+static gboolean
+hibernate_pages_cb (AdwTabView *self)
+{
+  GPtrArray *candidates;
+  int n_live = 0;
+  guint i;
+
+  self->hibernate_pages_cb = 0;
+
+  if (self->max_live_pages <= 0)
+    return G_SOURCE_REMOVE;
+
+  candidates = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < self->n_pages; i++) {
+    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+
+    if (!page->child)
+      continue;
+
+    n_live++;
+
+    if (page_can_hibernate (self, page))
+      g_ptr_array_add (candidates, g_object_ref (page));
+  }
+
+  g_ptr_array_sort (candidates, compare_last_selected);
+
+  for (i = 0; i < candidates->len && n_live > self->max_live_pages; i++) {
+    AdwTabPage *page = g_ptr_array_index (candidates, i);
+
+    if (hibernate_page (self, page))
+      n_live--;
+  }
+
+  g_ptr_array_unref (candidates);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+schedule_hibernation (AdwTabView *self)
+{
+  if (self->hibernate_pages_cb || self->max_live_pages <= 0)
+    return;
+
+  self->hibernate_pages_cb = g_idle_add ((GSourceFunc) hibernate_pages_cb, self);
+}
+
+static void
+set_page_warm (AdwTabView *self,
+               AdwTabPage *page,
+               gboolean    warm)
+{
+  if (page->warm == warm)
+    return;
+
+  page->warm = warm;
+
+  /* Warm pages are mapped, but hidden behind the selected page */
+  gtk_widget_set_can_target (page->bin,
+                             !warm && !adw_tab_view_get_is_transferring_page (self));
+  gtk_widget_set_can_focus (page->bin, !warm);
+
+  if (page == self->selected_page)
+    return;
+
+  gtk_widget_set_child_visible (page->bin,
+                                warm || page_should_be_visible (self, page));
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+}
+
+static void
+update_warm_pages (AdwTabView *self)
+{
+  GPtrArray *candidates = g_ptr_array_new ();
+  guint i;
+
+  for (i = 0; i < self->n_pages; i++) {
+    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+
+    if (self->max_warm_pages > 0 &&
+        page != self->selected_page &&
+        page->child &&
+        page->last_selected > 0)
+      g_ptr_array_add (candidates, page);
+    else
+      set_page_warm (self, page, FALSE);
+  }
+
+  g_ptr_array_sort (candidates, compare_last_selected);
+
+  /* Keep the most recently selected ones, which are at the end */
+  for (i = 0; i < candidates->len; i++) {
+    AdwTabPage *page = g_ptr_array_index (candidates, i);
+
+    set_page_warm (self, page, i + self->max_warm_pages >= candidates->len);
+  }
+
+  g_ptr_array_unref (candidates);
+}
+
+static gboolean
+transfer_to_can_target (GBinding     *binding,
+                        const GValue *from_value,
+                        GValue       *to_value,
+                        AdwTabPage   *page)
+{
+  g_value_set_boolean (to_value, !g_value_get_boolean (from_value) && !page->warm);
+
+  return TRUE;
+}
+
+static void
+switch_after_paint_cb (AdwTabView *self)
+{
+  if (self->switch_start_time)
+    self->last_switch_duration = g_get_monotonic_time () - self->switch_start_time;
+
+  self->switch_start_time = 0;
+
+  g_clear_signal_handler (&self->switch_after_paint_id, self->switch_frame_clock);
+  self->switch_frame_clock = NULL;
+}
+
 #define ADW_TYPE_TAB_PAGES (adw_tab_pages_get_type ())
 
 G_DECLARE_FINAL_TYPE (AdwTabPages, adw_tab_pages, ADW, TAB_PAGES, GObject)
@@ -1515,6 +2338,102 @@ is_descendant_of (AdwTabPage *page,
   return page == parent;
 }
 
+/* Every page knows its own position, so that looking it up is O(1). It has to
+ * be updated for all pages in [from, to) whenever pages are added, removed or
+ * moved. */
+static void
+update_page_positions (AdwTabView *self,
+                       int         from,
+                       int         to)
+{
+  int i;
+
+  for (i = from; i < to; i++) {
+    AdwTabPage *page = g_ptr_array_index (self->children, i);
+
+    page->position = i;
+  }
+}
+
+static void
+move_page (AdwTabView *self,
+           AdwTabPage *page,
+           int         old_pos,
+           int         new_pos)
+{
+  g_ptr_array_steal_index (self->children, old_pos);
+  g_ptr_array_insert (self->children, new_pos, page);
+
+  update_page_positions (self, MIN (old_pos, new_pos), MAX (old_pos, new_pos) + 1);
+}
+
+/* Batches coalesce model changes: pages removed next to each other are
+ * announced with a single items-changed emission, and property notifications
+ * are held until the outermost batch ends. */
+static void
+flush_pending_removals (AdwTabView *self)
+{
+  int pos = self->pending_removal_pos;
+  int n = self->pending_removal_n;
+
+  if (!n)
+    return;
+
+  self->pending_removal_n = 0;
+
+  if (self->pages)
+    g_list_model_items_changed (G_LIST_MODEL (self->pages), pos, n, 0);
+}
+
+static void
+queue_removal (AdwTabView *self,
+               int         pos)
+{
+  if (self->pending_removal_n > 0) {
+    /* The page right after the pending range */
+    if (pos == self->pending_removal_pos) {
+      self->pending_removal_n++;
+
+      return;
+    }
+
+    /* The page right before it */
+    if (pos == self->pending_removal_pos - 1) {
+      self->pending_removal_pos--;
+      self->pending_removal_n++;
+
+      return;
+    }
+
+    flush_pending_removals (self);
+  }
+
+  self->pending_removal_pos = pos;
+  self->pending_removal_n = 1;
+}
+
+static void
+begin_batch (AdwTabView *self)
+{
+  if (self->batch_depth++ == 0)
+    g_object_freeze_notify (G_OBJECT (self));
+}
+
+static void
+end_batch (AdwTabView *self)
+{
+  g_assert (self->batch_depth > 0);
+
+  if (--self->batch_depth > 0)
+    return;
+
+  flush_pending_removals (self);
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  g_object_thaw_notify (G_OBJECT (self));
+}
+
 static void
 attach_page (AdwTabView *self,
              AdwTabPage *page,
@@ -1522,16 +2441,23 @@ attach_page (AdwTabView *self,
 {
   AdwTabPage *parent;
 
-  g_list_store_insert (self->children, position, page);
+  g_ptr_array_insert (self->children, position, g_object_ref (page));
+  update_page_positions (self, position, self->children->len);
+
+  if (page->child)
+    g_hash_table_insert (self->child_pages, page->child, page);
+  else if (page_should_be_visible (self, page))
+    ensure_page_child (self, page);
 
   gtk_widget_set_child_visible (page->bin,
                                 page_should_be_visible (self, page));
   gtk_widget_set_parent (page->bin, GTK_WIDGET (self));
   page->transfer_binding =
-    g_object_bind_property (self, "is-transferring-page",
-                            page->bin, "can-target",
-                            G_BINDING_SYNC_CREATE |
-                            G_BINDING_INVERT_BOOLEAN);
+    g_object_bind_property_full (self, "is-transferring-page",
+                                 page->bin, "can-target",
+                                 G_BINDING_SYNC_CREATE,
+                                 (GBindingTransformFunc) transfer_to_can_target,
+                                 NULL, page, NULL);
   gtk_widget_queue_resize (GTK_WIDGET (self));
 
   g_object_freeze_notify (G_OBJECT (self));
@@ -1548,6 +2474,9 @@ attach_page (AdwTabView *self,
   if (parent && !page_belongs_to_this_view (self, parent))
     set_page_parent (page, NULL);
 
+  if (self->search_index)
+    adw_tab_search_index_add_page (self->search_index, page);
+
   g_signal_emit (self, signals[SIGNAL_PAGE_ATTACHED], 0, page, position);
 }
 
@@ -1563,6 +2492,10 @@ set_selected_page (AdwTabView *self,
   if (self->selected_page == selected_page)
     return;
 
+  /* Selection changes refer to positions, so removals must be announced first */
+  if (notify_pages)
+    flush_pending_removals (self);
+
   if (self->selected_page) {
     GtkRoot *root = gtk_widget_get_root (GTK_WIDGET (self));
     GtkWidget *focus = root ? gtk_root_get_focus (root) : NULL;
@@ -1585,8 +2518,10 @@ set_selected_page (AdwTabView *self,
                                  (gpointer *) &self->selected_page->last_focus);
     }
 
+    /* If it's going to be kept warm, don't unmap it just to map it again */
     if (self->selected_page->bin)
       gtk_widget_set_child_visible (self->selected_page->bin,
+                                    self->max_warm_pages > 0 ||
                                     page_should_be_visible (self, self->selected_page));
 
     set_page_selected (self->selected_page, FALSE);
@@ -1599,6 +2534,8 @@ set_selected_page (AdwTabView *self,
       new_position = adw_tab_view_get_page_position (self, self->selected_page);
 
     if (!gtk_widget_in_destruction (GTK_WIDGET (self))) {
+      ensure_page_child (self, selected_page);
+
       gtk_widget_set_child_visible (selected_page->bin, TRUE);
 
       if (contains_focus) {
@@ -1611,9 +2548,23 @@ set_selected_page (AdwTabView *self,
       gtk_widget_queue_allocate (GTK_WIDGET (self));
     }
 
-    set_page_selected (self->selected_page, TRUE);
+    set_page_selected (self->selected_page, TRUE);
+
+    self->selected_page->last_selected = ++self->selection_serial;
+
+    /* An unmapped view isn't painted, so there's nothing to measure */
+    if (gtk_widget_get_mapped (GTK_WIDGET (self)))
+      self->switch_start_time = g_get_monotonic_time ();
+    else
+      self->switch_start_time = 0;
+
+    if (!gtk_widget_in_destruction (GTK_WIDGET (self)))
+      schedule_hibernation (self);
   }
 
+  if (!gtk_widget_in_destruction (GTK_WIDGET (self)))
+    update_warm_pages (self);
+
   if (notify_pages && self->pages) {
     if (old_position == GTK_INVALID_LIST_POSITION && new_position == GTK_INVALID_LIST_POSITION)
       ; /* nothing to do */
@@ -1688,7 +2639,17 @@ detach_page (AdwTabView *self,
   if (self->n_pages == 1)
     set_selected_page (self, NULL, !in_dispose);
 
-  g_list_store_remove (self->children, pos);
+  if (page->child)
+    g_hash_table_remove (self->child_pages, page->child);
+
+  page->warm = FALSE;
+
+  g_ptr_array_remove_index (self->children, pos);
+  update_page_positions (self, pos, self->children->len);
+  page->position = -1;
+
+  /* The queue doesn't hold references to its pages */
+  invalidate_pending_thumbnails (self);
 
   g_object_freeze_notify (G_OBJECT (self));
 
@@ -1702,12 +2663,17 @@ detach_page (AdwTabView *self,
   g_clear_pointer (&page->transfer_binding, g_binding_unbind);
   gtk_widget_unparent (page->bin);
 
+  if (self->search_index)
+    adw_tab_search_index_remove_page (self->search_index, page);
+
   if (!in_dispose)
     gtk_widget_queue_resize (GTK_WIDGET (self));
 
   g_signal_emit (self, signals[SIGNAL_PAGE_DETACHED], 0, page, pos);
 
-  if (!in_dispose && self->pages)
+  if (!in_dispose && self->batch_depth > 0)
+    queue_removal (self, pos);
+  else if (!in_dispose && self->pages)
     g_list_model_items_changed (G_LIST_MODEL (self->pages), pos, 1, 0);
 
   g_object_unref (page->bin);
@@ -1726,6 +2692,8 @@ insert_page (AdwTabView *self,
   if (!self->selected_page)
     set_selected_page (self, page, FALSE);
 
+  flush_pending_removals (self);
+
   if (self->pages)
     g_list_model_items_changed (G_LIST_MODEL (self->pages), position, 0, 1);
 
@@ -1733,11 +2701,14 @@ insert_page (AdwTabView *self,
 }
 
 static AdwTabPage *
-create_and_insert_page (AdwTabView *self,
-                        GtkWidget  *child,
-                        AdwTabPage *parent,
-                        int         position,
-                        gboolean    pinned)
+create_and_insert_page (AdwTabView            *self,
+                        GtkWidget             *child,
+                        AdwTabPageFactoryFunc  factory,
+                        gpointer               factory_data,
+                        GDestroyNotify         factory_destroy,
+                        AdwTabPage            *parent,
+                        int                    position,
+                        gboolean               pinned)
 {
   AdwTabPage *page =
     g_object_new (ADW_TYPE_TAB_PAGE,
@@ -1745,6 +2716,10 @@ create_and_insert_page (AdwTabView *self,
                   "parent", parent,
                   NULL);
 
+  page->factory = factory;
+  page->factory_data = factory_data;
+  page->factory_destroy = factory_destroy;
+
   set_page_pinned (page, pinned);
 
   insert_page (self, page, position);
@@ -1754,6 +2729,170 @@ create_and_insert_page (AdwTabView *self,
   return page;
 }
 
+/* Restored pages share a single factory, which is destroyed along with the
+ * last page using it */
+typedef struct {
+  AdwTabPageFactoryFunc factory;
+  gpointer user_data;
+  GDestroyNotify destroy;
+} StateFactory;
+
+static GtkWidget *
+state_factory_cb (AdwTabPage *page,
+                  gpointer    user_data)
+{
+  StateFactory *factory = user_data;
+
+  return factory->factory (page, factory->user_data);
+}
+
+static void
+state_factory_clear (StateFactory *factory)
+{
+  if (factory->destroy)
+    factory->destroy (factory->user_data);
+}
+
+static void
+state_factory_release (gpointer data)
+{
+  g_rc_box_release_full (data, (GDestroyNotify) state_factory_clear);
+}
+
+static GdkTexture *
+get_page_thumbnail (AdwTabPage *page)
+{
+  AdwTabPaintable *paintable;
+
+  if (page->thumbnail)
+    return page->thumbnail;
+
+  if (!page->paintable)
+    return NULL;
+
+  paintable = ADW_TAB_PAINTABLE (page->paintable);
+
+  freeze_thumbnail (paintable);
+
+  return paintable->texture;
+}
+
+static GVariant *
+serialize_thumbnail (GdkTexture *texture)
+{
+  int width = gdk_texture_get_width (texture);
+  int height = gdk_texture_get_height (texture);
+  gsize stride = (gsize) width * 4;
+  guchar *data = g_malloc (stride * height);
+  GVariant *pixels;
+  GBytes *bytes;
+
+  gdk_texture_download (texture, data, stride);
+
+  bytes = g_bytes_new_take (data, stride * height);
+  pixels = g_variant_new_from_bytes (G_VARIANT_TYPE_BYTESTRING, bytes, TRUE);
+  g_bytes_unref (bytes);
+
+  return g_variant_new ("(uuuu@ay)",
+                        (guint32) width,
+                        (guint32) height,
+                        (guint32) stride,
+                        (guint32) GDK_MEMORY_DEFAULT,
+                        pixels);
+}
+
+static GdkTexture *
+deserialize_thumbnail (GVariant *variant)
+{
+  guint32 width, height, stride, format;
+  GdkTexture *texture = NULL;
+  GVariant *pixels;
+  GBytes *bytes;
+
+  g_variant_get (variant, "(uuuu@ay)", &width, &height, &stride, &format, &pixels);
+
+  /* The pixels are referenced rather than copied, so if the state is backed by
+   * a mapped file, they are only read once the thumbnail is drawn */
+  bytes = g_variant_get_data_as_bytes (pixels);
+
+  if (format == GDK_MEMORY_DEFAULT &&
+      width > 0 && width <= G_MAXINT / 4 &&
+      height > 0 && height <= G_MAXINT &&
+      stride >= width * 4 &&
+      g_bytes_get_size (bytes) >= (guint64) stride * (height - 1) + width * 4)
+    texture = gdk_memory_texture_new (width, height, GDK_MEMORY_DEFAULT,
+                                      bytes, stride);
+
+  g_bytes_unref (bytes);
+  g_variant_unref (pixels);
+
+  return texture;
+}
+
+static AdwTabPage *
+restore_page (GVariant     *pages,
+              gsize         index,
+              gboolean      pinned,
+              StateFactory *factory)
+{
+  AdwTabPage *page = g_object_new (ADW_TYPE_TAB_PAGE, NULL);
+  const char *title, *tooltip, *keyword, *indicator_tooltip;
+  GVariant *icon, *indicator_icon, *thumbnail;
+  gboolean indicator_activatable;
+  double xalign, yalign;
+
+  g_variant_get_child (pages, index, "(&s&sm&smvmv&sbddm@" STATE_THUMBNAIL_TYPE ")",
+                       &title, &tooltip, &keyword,
+                       &icon, &indicator_icon,
+                       &indicator_tooltip, &indicator_activatable,
+                       &xalign, &yalign, &thumbnail);
+
+  page->factory = state_factory_cb;
+  page->factory_data = g_rc_box_acquire (factory);
+  page->factory_destroy = state_factory_release;
+
+  /* Nothing is connected to the page yet, so setting properties is cheap */
+  set_page_pinned (page, pinned);
+  adw_tab_page_set_title (page, title);
+  adw_tab_page_set_tooltip (page, tooltip);
+  adw_tab_page_set_keyword (page, keyword);
+  adw_tab_page_set_indicator_tooltip (page, indicator_tooltip);
+  adw_tab_page_set_indicator_activatable (page, indicator_activatable);
+  adw_tab_page_set_thumbnail_xalign (page, xalign);
+  adw_tab_page_set_thumbnail_yalign (page, yalign);
+
+  if (icon) {
+    GIcon *gicon = g_icon_deserialize (icon);
+
+    adw_tab_page_set_icon (page, gicon);
+
+    g_clear_object (&gicon);
+    g_variant_unref (icon);
+  }
+
+  if (indicator_icon) {
+    GIcon *gicon = g_icon_deserialize (indicator_icon);
+
+    adw_tab_page_set_indicator_icon (page, gicon);
+
+    g_clear_object (&gicon);
+    g_variant_unref (indicator_icon);
+  }
+
+  if (thumbnail) {
+    GdkTexture *texture = deserialize_thumbnail (thumbnail);
+
+    if (texture) {
+      adw_tab_page_set_thumbnail (page, texture);
+      g_object_unref (texture);
+    }
+
+    g_variant_unref (thumbnail);
+  }
+
+  return page;
+}
+
 static gboolean
 close_page_cb (AdwTabView *self,
                AdwTabPage *page)
@@ -2064,7 +3203,7 @@ unmap_extra_pages (AdwTabView *self)
   for (i = 0; i < self->n_pages; i++) {
     AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
 
-    if (page == self->selected_page)
+    if (page == self->selected_page || page->warm)
       continue;
 
     if (!gtk_widget_get_child_visible (page->bin))
@@ -2091,6 +3230,15 @@ adw_tab_view_snapshot (GtkWidget   *widget,
   if (self->selected_page)
     gtk_widget_snapshot_child (widget, self->selected_page->bin, snapshot);
 
+  if (self->switch_start_time && !self->switch_after_paint_id) {
+    self->switch_frame_clock = gtk_widget_get_frame_clock (widget);
+
+    if (self->switch_frame_clock)
+      self->switch_after_paint_id =
+        g_signal_connect_swapped (self->switch_frame_clock, "after-paint",
+                                  G_CALLBACK (switch_after_paint_cb), self);
+  }
+
   for (i = 0; i < self->n_pages; i++) {
     AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
 
@@ -2102,16 +3250,25 @@ adw_tab_view_snapshot (GtkWidget   *widget,
     if (!gtk_widget_get_child_visible (page->bin))
       continue;
 
+    /* Warm pages are only kept mapped, there's nothing to draw */
+    if (page->warm && !page_should_be_visible (self, page))
+      continue;
+
     if (page->paintable) {
       /* We don't want to actually draw the child, but we do need it
        * to redraw so that it can be displayed by its paintable */
       GtkSnapshot *child_snapshot = gtk_snapshot_new ();
+      gint64 start = g_get_monotonic_time ();
 
       gtk_widget_snapshot_child (widget, page->bin, child_snapshot);
 
       child_unmap_cb (ADW_TAB_PAINTABLE (page->paintable));
 
       g_object_unref (child_snapshot);
+
+      if (page->invalidated)
+        record_thumbnail_cost (&self->thumbnail_snapshot_cost,
+                               g_get_monotonic_time () - start);
     }
 
     page->invalidated = FALSE;
@@ -2132,6 +3289,16 @@ adw_tab_view_dispose (GObject *object)
     self->unmap_extra_pages_cb = 0;
   }
 
+  unschedule_thumbnails (self);
+
+  g_clear_handle_id (&self->hibernate_pages_cb, g_source_remove);
+  g_clear_handle_id (&self->rasterize_thumbnails_cb, g_source_remove);
+
+  if (self->switch_after_paint_id) {
+    g_clear_signal_handler (&self->switch_after_paint_id, self->switch_frame_clock);
+    self->switch_frame_clock = NULL;
+  }
+
   if (self->pages)
     g_list_model_items_changed (G_LIST_MODEL (self->pages), 0, self->n_pages, 0);
 
@@ -2141,7 +3308,9 @@ adw_tab_view_dispose (GObject *object)
     detach_page (self, page, TRUE);
   }
 
-  g_clear_object (&self->children);
+  g_clear_object (&self->search_index);
+  g_clear_pointer (&self->children, g_ptr_array_unref);
+  g_clear_pointer (&self->child_pages, g_hash_table_unref);
 
   G_OBJECT_CLASS (adw_tab_view_parent_class)->dispose (object);
 }
@@ -2157,6 +3326,7 @@ adw_tab_view_finalize (GObject *object)
 
   g_clear_object (&self->default_icon);
   g_clear_object (&self->menu_model);
+  g_clear_pointer (&self->pending_thumbnails, g_ptr_array_unref);
 
   tab_view_list = g_slist_remove (tab_view_list, self);
 
@@ -2204,6 +3374,18 @@ adw_tab_view_get_property (GObject    *object,
     g_value_take_object (value, adw_tab_view_get_pages (self));
     break;
 
+  case PROP_THUMBNAIL_CACHE_SIZE:
+    g_value_set_uint64 (value, adw_tab_view_get_thumbnail_cache_size (self));
+    break;
+
+  case PROP_MAX_LIVE_PAGES:
+    g_value_set_int (value, adw_tab_view_get_max_live_pages (self));
+    break;
+
+  case PROP_MAX_WARM_PAGES:
+    g_value_set_int (value, adw_tab_view_get_max_warm_pages (self));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -2234,6 +3416,18 @@ adw_tab_view_set_property (GObject      *object,
     adw_tab_view_set_shortcuts (self, g_value_get_flags (value));
     break;
 
+  case PROP_THUMBNAIL_CACHE_SIZE:
+    adw_tab_view_set_thumbnail_cache_size (self, g_value_get_uint64 (value));
+    break;
+
+  case PROP_MAX_LIVE_PAGES:
+    adw_tab_view_set_max_live_pages (self, g_value_get_int (value));
+    break;
+
+  case PROP_MAX_WARM_PAGES:
+    adw_tab_view_set_max_warm_pages (self, g_value_get_int (value));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -2374,6 +3568,66 @@ adw_tab_view_class_init (AdwTabViewClass *klass)
                          GTK_TYPE_SELECTION_MODEL,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdwTabView:thumbnail-cache-size: (attributes org.gtk.Property.get=adw_tab_view_get_thumbnail_cache_size org.gtk.Property.set=adw_tab_view_set_thumbnail_cache_size)
+   *
+   * The maximum amount of memory used for cached thumbnails, in bytes.
+   *
+   * Thumbnails of pages that are not live are rendered once into a texture at
+   * thumbnail resolution, and are only rendered again when
+   * [method@TabPage.invalidate_thumbnail] is called, or when the page becomes
+   * live.
+   *
+   * When the cache exceeds this size, the least recently shown thumbnails are
+   * discarded and will be rendered again the next time [class@TabOverview] is
+   * open. Until then, they are replaced with the default icon. The most
+   * recently shown thumbnail is always kept, even if it doesn't fit on its own,
+   * and so are the thumbnails of hibernated pages.
+   *
+   * Since: 1.4
+   */
+  props[PROP_THUMBNAIL_CACHE_SIZE] =
+    g_param_spec_uint64 ("thumbnail-cache-size", NULL, NULL,
+                         0, G_MAXUINT64, DEFAULT_THUMBNAIL_CACHE_SIZE,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwTabView:max-live-pages: (attributes org.gtk.Property.get=adw_tab_view_get_max_live_pages org.gtk.Property.set=adw_tab_view_set_max_live_pages)
+   *
+   * The maximum number of pages that have a child.
+   *
+   * When there are more pages with a child, the least recently selected pages
+   * are hibernated, as long as [property@TabPage:can-hibernate] is `TRUE` for
+   * them. The selected page is never hibernated.
+   *
+   * If set to 0, pages are never hibernated.
+   *
+   * Since: 1.4
+   */
+  props[PROP_MAX_LIVE_PAGES] =
+    g_param_spec_int ("max-live-pages", NULL, NULL,
+                      0, G_MAXINT, 0,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwTabView:max-warm-pages: (attributes org.gtk.Property.get=adw_tab_view_get_max_warm_pages org.gtk.Property.set=adw_tab_view_set_max_warm_pages)
+   *
+   * The number of recently selected pages to keep mapped.
+   *
+   * Non-selected pages are normally unmapped, so switching back to a page
+   * that is expensive to map, such as a web view, can stall the first frame.
+   *
+   * The given number of most recently selected pages stay mapped while hidden
+   * behind the selected page, which makes switching between them instant. They
+   * are never drawn and don't receive input.
+   *
+   * Since: 1.4
+   */
+  props[PROP_MAX_WARM_PAGES] =
+    g_param_spec_int ("max-warm-pages", NULL, NULL,
+                      0, G_MAXINT, 0,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -2577,6 +3831,39 @@ adw_tab_view_class_init (AdwTabViewClass *klass)
                               G_TYPE_FROM_CLASS (klass),
                               adw_marshal_VOID__OBJECTv);
 
+  /**
+   * AdwTabView::hibernate-page:
+   * @self: a tab view
+   * @page: a page of @self
+   *
+   * Emitted before @page is hibernated.
+   *
+   * Return `GDK_EVENT_STOP` to keep the child of @page, for example while it's
+   * playing media or has unsaved changes. Otherwise its thumbnail is frozen,
+   * the child is removed, and will be recreated with its factory when @page is
+   * selected again.
+   *
+   * See [property@TabPage:can-hibernate].
+   *
+   * Returns: `GDK_EVENT_STOP` to prevent hibernating @page
+   *
+   * Since: 1.4
+   */
+  signals[SIGNAL_HIBERNATE_PAGE] =
+    g_signal_new ("hibernate-page",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  g_signal_accumulator_true_handled,
+                  NULL,
+                  adw_marshal_BOOLEAN__OBJECT,
+                  G_TYPE_BOOLEAN,
+                  1,
+                  ADW_TYPE_TAB_PAGE);
+  g_signal_set_va_marshaller (signals[SIGNAL_HIBERNATE_PAGE],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_BOOLEAN__OBJECTv);
+
   g_signal_override_class_handler ("close-page",
                                    G_TYPE_FROM_CLASS (klass),
                                    G_CALLBACK (close_page_cb));
@@ -2590,9 +3877,12 @@ adw_tab_view_init (AdwTabView *self)
 {
   GtkEventController *controller;
 
-  self->children = g_list_store_new (ADW_TYPE_TAB_PAGE);
+  self->children = g_ptr_array_new_with_free_func (g_object_unref);
+  self->pending_thumbnails = g_ptr_array_new ();
+  self->child_pages = g_hash_table_new (NULL, NULL);
   self->default_icon = G_ICON (g_themed_icon_new ("adw-tab-icon-missing-symbolic"));
   self->shortcuts = ADW_TAB_VIEW_SHORTCUT_ALL_SHORTCUTS;
+  self->thumbnail_cache_size = DEFAULT_THUMBNAIL_CACHE_SIZE;
 
   tab_view_list = g_slist_prepend (tab_view_list, self);
 
@@ -3215,110 +4505,295 @@ adw_tab_page_get_thumbnail_yalign (AdwTabPage *self)
  *
  * Sets the vertical alignment of the thumbnail for @self.
  *
- * If the page is so tall that [class@TabOverview] can't display it completely
- * and has to crop it, vertical alignment will determine which part of the page
- * will be visible.
+ * If the page is so tall that [class@TabOverview] can't display it completely
+ * and has to crop it, vertical alignment will determine which part of the page
+ * will be visible.
+ *
+ * For example, 0.5 means the center of the page will be visible, 0 means the
+ * top edge will be visible and 1 means the bottom edge will be visible.
+ *
+ * The default vertical alignment is 0.
+ *
+ * Since: 1.3
+ */
+void
+adw_tab_page_set_thumbnail_yalign (AdwTabPage *self,
+                                   float       yalign)
+{
+  g_return_if_fail (ADW_IS_TAB_PAGE (self));
+
+  yalign = CLAMP (yalign, 0.0, 1.0);
+
+  if (G_APPROX_VALUE (self->thumbnail_yalign, yalign, FLT_EPSILON))
+    return;
+
+  self->thumbnail_yalign = yalign;
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_THUMBNAIL_YALIGN]);
+}
+
+/**
+ * adw_tab_page_get_live_thumbnail: (attributes org.gtk.Method.get_property=live-thumbnail)
+ * @self: a tab overview
+ *
+ * Gets whether to live thumbnail is enabled @self.
+ *
+ * Returns: whether live thumbnail is enabled
+ *
+ * Since: 1.3
+ */
+gboolean
+adw_tab_page_get_live_thumbnail (AdwTabPage *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_PAGE (self), FALSE);
+
+  return self->live_thumbnail;
+}
+
+/**
+ * adw_tab_page_set_live_thumbnail: (attributes org.gtk.Method.set_property=live-thumbnail)
+ * @self: a tab page
+ * @live_thumbnail: whether to enable live thumbnail
+ *
+ * Sets whether to enable live thumbnail for @self.
+ *
+ * When set to `TRUE`, @self's thumbnail in [class@TabOverview] will update
+ * immediately when @self is redrawn or resized.
+ *
+ * If it's set to `FALSE`, the thumbnail will only be live when the @self is
+ * selected, and otherwise it will be static and will only update when
+ * [method@TabPage.invalidate_thumbnail] or
+ * [method@TabView.invalidate_thumbnails] is called.
+ *
+ * Since: 1.3
+ */
+void
+adw_tab_page_set_live_thumbnail (AdwTabPage *self,
+                                 gboolean    live_thumbnail)
+{
+  g_return_if_fail (ADW_IS_TAB_PAGE (self));
+
+  live_thumbnail = !!live_thumbnail;
+
+  if (self->live_thumbnail == live_thumbnail)
+    return;
+
+  self->live_thumbnail = live_thumbnail;
+
+  map_or_unmap_page (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_LIVE_THUMBNAIL]);
+}
+
+
+/**
+ * adw_tab_page_invalidate_thumbnail:
+ * @self: a tab page
+ *
+ * Invalidates thumbnail for @self.
+ *
+ * If an [class@TabOverview] is open, the thumbnail representing @self will be
+ * updated within the next few frames. Otherwise it will be updated when opening
+ * the overview.
+ *
+ * Does nothing if [property@TabPage:live-thumbnail] is set to `TRUE`.
+ *
+ * See also [method@TabView.invalidate_thumbnails].
+ *
+ * Since: 1.3
+ */
+void
+adw_tab_page_invalidate_thumbnail (AdwTabPage *self)
+{
+  g_return_if_fail (ADW_IS_TAB_PAGE (self));
+
+  self->invalidated = TRUE;
+
+  map_or_unmap_page (self);
+}
+
+/**
+ * adw_tab_page_get_can_hibernate: (attributes org.gtk.Method.get_property=can-hibernate)
+ * @self: a tab page
+ *
+ * Gets whether @self can be hibernated.
+ *
+ * Returns: whether @self can be hibernated
+ *
+ * Since: 1.4
+ */
+gboolean
+adw_tab_page_get_can_hibernate (AdwTabPage *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_PAGE (self), FALSE);
+
+  return self->can_hibernate;
+}
+
+/**
+ * adw_tab_page_set_can_hibernate: (attributes org.gtk.Method.set_property=can-hibernate)
+ * @self: a tab page
+ * @can_hibernate: whether @self can be hibernated
+ *
+ * Sets whether @self can be hibernated.
  *
- * For example, 0.5 means the center of the page will be visible, 0 means the
- * top edge will be visible and 1 means the bottom edge will be visible.
+ * Hibernated pages don't have a child. It's recreated with the page's factory
+ * when the page is selected again, so only pages with a factory can be
+ * hibernated, see [method@TabPage.set_child_factory].
  *
- * The default vertical alignment is 0.
+ * Pages are hibernated when [property@TabView:max-live-pages] is exceeded,
+ * starting from the least recently selected one.
  *
- * Since: 1.3
+ * Since: 1.4
  */
 void
-adw_tab_page_set_thumbnail_yalign (AdwTabPage *self,
-                                   float       yalign)
+adw_tab_page_set_can_hibernate (AdwTabPage *self,
+                                gboolean    can_hibernate)
 {
+  GtkWidget *parent;
+
   g_return_if_fail (ADW_IS_TAB_PAGE (self));
 
-  yalign = CLAMP (yalign, 0.0, 1.0);
+  can_hibernate = !!can_hibernate;
 
-  if (G_APPROX_VALUE (self->thumbnail_yalign, yalign, FLT_EPSILON))
+  if (self->can_hibernate == can_hibernate)
     return;
 
-  self->thumbnail_yalign = yalign;
+  self->can_hibernate = can_hibernate;
 
-  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_THUMBNAIL_YALIGN]);
+  parent = gtk_widget_get_parent (self->bin);
+
+  if (can_hibernate && ADW_IS_TAB_VIEW (parent))
+    schedule_hibernation (ADW_TAB_VIEW (parent));
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_CAN_HIBERNATE]);
 }
 
 /**
- * adw_tab_page_get_live_thumbnail: (attributes org.gtk.Method.get_property=live-thumbnail)
- * @self: a tab overview
+ * adw_tab_page_get_hibernated: (attributes org.gtk.Method.get_property=hibernated)
+ * @self: a tab page
  *
- * Gets whether to live thumbnail is enabled @self.
+ * Gets whether @self is currently hibernated.
  *
- * Returns: whether live thumbnail is enabled
+ * Returns: whether @self is hibernated
  *
- * Since: 1.3
+ * Since: 1.4
  */
 gboolean
-adw_tab_page_get_live_thumbnail (AdwTabPage *self)
+adw_tab_page_get_hibernated (AdwTabPage *self)
 {
   g_return_val_if_fail (ADW_IS_TAB_PAGE (self), FALSE);
 
-  return self->live_thumbnail;
+  return self->hibernated;
 }
 
 /**
- * adw_tab_page_set_live_thumbnail: (attributes org.gtk.Method.set_property=live-thumbnail)
+ * adw_tab_page_set_child_factory:
  * @self: a tab page
- * @live_thumbnail: whether to enable live thumbnail
+ * @factory: (nullable) (scope notified): the function to create the child with
+ * @user_data: (closure): the data to be passed to @factory
+ * @destroy: (destroy user_data): the function to be called when @factory is no
+ *   longer needed
  *
- * Sets whether to enable live thumbnail for @self.
+ * Sets the function used to create the child of @self.
  *
- * When set to `TRUE`, @self's thumbnail in [class@TabOverview] will update
- * immediately when @self is redrawn or resized.
+ * It's used to create the child of a lazy page, see
+ * [method@TabView.insert_lazy], and to recreate it after @self has been
+ * hibernated, see [property@TabPage:can-hibernate].
  *
- * If it's set to `FALSE`, the thumbnail will only be live when the @self is
- * selected, and otherwise it will be static and will only update when
- * [method@TabPage.invalidate_thumbnail] or
- * [method@TabView.invalidate_thumbnails] is called.
+ * @factory can only be unset if @self already has a child.
  *
- * Since: 1.3
+ * Since: 1.4
  */
 void
-adw_tab_page_set_live_thumbnail (AdwTabPage *self,
-                                 gboolean    live_thumbnail)
+adw_tab_page_set_child_factory (AdwTabPage            *self,
+                                AdwTabPageFactoryFunc  factory,
+                                gpointer               user_data,
+                                GDestroyNotify         destroy)
 {
   g_return_if_fail (ADW_IS_TAB_PAGE (self));
+  g_return_if_fail (factory != NULL || self->child != NULL);
 
-  live_thumbnail = !!live_thumbnail;
+  clear_page_factory (self);
 
-  if (self->live_thumbnail == live_thumbnail)
-    return;
+  self->factory = factory;
+  self->factory_data = user_data;
+  self->factory_destroy = destroy;
+}
 
-  self->live_thumbnail = live_thumbnail;
+/**
+ * adw_tab_page_set_thumbnail:
+ * @self: a tab page
+ * @thumbnail: a texture with the page contents
+ *
+ * Sets a previously rendered thumbnail for @self.
+ *
+ * This is mostly useful for pages added with [method@TabView.insert_lazy],
+ * since it allows [class@TabOverview] to show their contents without creating
+ * the child.
+ *
+ * The thumbnail is shown until @self is rendered again, and it counts towards
+ * [property@TabView:thumbnail-cache-size]. It's ignored if @self already has a
+ * thumbnail.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_page_set_thumbnail (AdwTabPage *self,
+                            GdkTexture *thumbnail)
+{
+  g_return_if_fail (ADW_IS_TAB_PAGE (self));
+  g_return_if_fail (GDK_IS_TEXTURE (thumbnail));
 
-  map_or_unmap_page (self);
+  if (self->paintable) {
+    set_stored_thumbnail (ADW_TAB_PAINTABLE (self->paintable), thumbnail);
+    return;
+  }
 
-  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_LIVE_THUMBNAIL]);
+  g_set_object (&self->thumbnail, thumbnail);
 }
 
-
 /**
- * adw_tab_page_invalidate_thumbnail:
+ * adw_tab_page_freeze_updates:
  * @self: a tab page
  *
- * Invalidates thumbnail for @self.
- *
- * If an [class@TabOverview] is open, the thumbnail representing @self will be
- * immediately updated. Otherwise it will be update when opening the overview.
+ * Delays property change notifications of @self until
+ * [method@TabPage.thaw_updates] is called.
  *
- * Does nothing if [property@TabPage:live-thumbnail] is set to `TRUE`.
+ * Use it when changing several properties at once, such as
+ * [property@TabPage:title], [property@TabPage:icon] and
+ * [property@TabPage:loading] when a page starts loading. Each changed property
+ * is only notified once on thaw, so tab bars and tab overviews only update
+ * once.
  *
- * See also [method@TabView.invalidate_thumbnails].
+ * Calls can be nested, notifications are emitted after the last
+ * [method@TabPage.thaw_updates] call.
  *
- * Since: 1.3
+ * Since: 1.4
  */
 void
-adw_tab_page_invalidate_thumbnail (AdwTabPage *self)
+adw_tab_page_freeze_updates (AdwTabPage *self)
 {
   g_return_if_fail (ADW_IS_TAB_PAGE (self));
 
-  self->invalidated = TRUE;
+  g_object_freeze_notify (G_OBJECT (self));
+}
 
-  map_or_unmap_page (self);
+/**
+ * adw_tab_page_thaw_updates:
+ * @self: a tab page
+ *
+ * Reverts the effect of a previous call to
+ * [method@TabPage.freeze_updates].
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_page_thaw_updates (AdwTabPage *self)
+{
+  g_return_if_fail (ADW_IS_TAB_PAGE (self));
+
+  g_object_thaw_notify (G_OBJECT (self));
 }
 
 GdkPaintable *
@@ -3807,22 +5282,18 @@ adw_tab_view_set_page_pinned (AdwTabView *self,
 
   old_pos = adw_tab_view_get_page_position (self, page);
 
-  g_object_ref (page);
-
-  g_list_store_remove (self->children, old_pos);
-
   new_pos = self->n_pinned_pages;
 
   if (!pinned)
     new_pos--;
 
-  g_list_store_insert (self->children, new_pos, page);
-
-  g_object_unref (page);
+  move_page (self, page, old_pos, new_pos);
 
   set_n_pinned_pages (self, new_pos + (pinned ? 1 : 0));
   set_page_pinned (page, pinned);
 
+  flush_pending_removals (self);
+
   if (self->pages) {
     int min = MIN (old_pos, new_pos);
     int n_changed = MAX (old_pos, new_pos) - min + 1;
@@ -3844,20 +5315,11 @@ AdwTabPage *
 adw_tab_view_get_page (AdwTabView *self,
                        GtkWidget  *child)
 {
-  int i;
-
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
   g_return_val_if_fail (GTK_IS_WIDGET (child), NULL);
   g_return_val_if_fail (child_belongs_to_this_view (self, child), NULL);
 
-  for (i = 0; i < self->n_pages; i++) {
-    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
-
-    if (adw_tab_page_get_child (page) == child)
-      return page;
-  }
-
-  g_assert_not_reached ();
+  return g_hash_table_lookup (self->child_pages, child);
 }
 
 /**
@@ -3873,17 +5335,11 @@ AdwTabPage *
 adw_tab_view_get_nth_page (AdwTabView *self,
                            int         position)
 {
-  AdwTabPage *page;
-
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
   g_return_val_if_fail (position >= 0, NULL);
   g_return_val_if_fail (position < self->n_pages, NULL);
 
-  page = g_list_model_get_item (G_LIST_MODEL (self->children), (guint) position);
-
-  g_object_unref (page);
-
-  return page;
+  return g_ptr_array_index (self->children, position);
 }
 
 /**
@@ -3899,20 +5355,11 @@ int
 adw_tab_view_get_page_position (AdwTabView *self,
                                 AdwTabPage *page)
 {
-  int i;
-
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), -1);
   g_return_val_if_fail (ADW_IS_TAB_PAGE (page), -1);
   g_return_val_if_fail (page_belongs_to_this_view (self, page), -1);
 
-  for (i = 0; i < self->n_pages; i++) {
-    AdwTabPage *p = adw_tab_view_get_nth_page (self, i);
-
-    if (page == p)
-      return i;
-  }
-
-  g_assert_not_reached ();
+  return page->position;
 }
 
 /**
@@ -3964,7 +5411,7 @@ adw_tab_view_add_page (AdwTabView *self,
     position = self->n_pages;
   }
 
-  return create_and_insert_page (self, child, parent, position, FALSE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, parent, position, FALSE);
 }
 
 /**
@@ -3990,7 +5437,7 @@ adw_tab_view_insert (AdwTabView *self,
   g_return_val_if_fail (position >= self->n_pinned_pages, NULL);
   g_return_val_if_fail (position <= self->n_pages, NULL);
 
-  return create_and_insert_page (self, child, NULL, position, FALSE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, NULL, position, FALSE);
 }
 
 /**
@@ -4009,7 +5456,7 @@ adw_tab_view_prepend (AdwTabView *self,
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
   g_return_val_if_fail (GTK_IS_WIDGET (child), NULL);
 
-  return create_and_insert_page (self, child, NULL, self->n_pinned_pages, FALSE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, NULL, self->n_pinned_pages, FALSE);
 }
 
 /**
@@ -4028,7 +5475,7 @@ adw_tab_view_append (AdwTabView *self,
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
   g_return_val_if_fail (GTK_IS_WIDGET (child), NULL);
 
-  return create_and_insert_page (self, child, NULL, self->n_pages, FALSE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, NULL, self->n_pages, FALSE);
 }
 
 /**
@@ -4054,7 +5501,7 @@ adw_tab_view_insert_pinned (AdwTabView *self,
   g_return_val_if_fail (position >= 0, NULL);
   g_return_val_if_fail (position <= self->n_pinned_pages, NULL);
 
-  return create_and_insert_page (self, child, NULL, position, TRUE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, NULL, position, TRUE);
 }
 
 /**
@@ -4073,7 +5520,7 @@ adw_tab_view_prepend_pinned (AdwTabView *self,
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
   g_return_val_if_fail (GTK_IS_WIDGET (child), NULL);
 
-  return create_and_insert_page (self, child, NULL, 0, TRUE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, NULL, 0, TRUE);
 }
 
 /**
@@ -4092,7 +5539,144 @@ adw_tab_view_append_pinned (AdwTabView *self,
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
   g_return_val_if_fail (GTK_IS_WIDGET (child), NULL);
 
-  return create_and_insert_page (self, child, NULL, self->n_pinned_pages, TRUE);
+  return create_and_insert_page (self, child, NULL, NULL, NULL, NULL, self->n_pinned_pages, TRUE);
+}
+
+/**
+ * adw_tab_view_insert_lazy:
+ * @self: a tab view
+ * @position: the position to add the page at, starting from 0
+ * @factory: (scope notified): the function to create the child with
+ * @user_data: (closure): the data to be passed to @factory
+ * @destroy: (destroy user_data): the function to be called when @factory is no
+ *   longer needed
+ *
+ * Inserts a non-pinned page without a child at @position.
+ *
+ * The child is created by calling @factory the first time the page is
+ * selected, or when its thumbnail is shown in [class@TabOverview] while
+ * [property@TabPage:live-thumbnail] is `TRUE`. Until then,
+ * [property@TabPage:child] is `NULL`.
+ *
+ * This is useful for restoring sessions with a large number of pages: set the
+ * title, icon, tooltip and keyword on the returned page, and optionally a
+ * stored thumbnail with [method@TabPage.set_thumbnail].
+ *
+ * @factory is kept for the lifetime of the page, and is also used to recreate
+ * the child after the page has been hibernated, see
+ * [property@TabPage:can-hibernate].
+ *
+ * It's an error to try to insert a page before a pinned page.
+ *
+ * Returns: (transfer none): the page object
+ *
+ * Since: 1.4
+ */
+AdwTabPage *
+adw_tab_view_insert_lazy (AdwTabView            *self,
+                          int                    position,
+                          AdwTabPageFactoryFunc  factory,
+                          gpointer               user_data,
+                          GDestroyNotify         destroy)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
+  g_return_val_if_fail (factory != NULL, NULL);
+  g_return_val_if_fail (position >= self->n_pinned_pages, NULL);
+  g_return_val_if_fail (position <= self->n_pages, NULL);
+
+  return create_and_insert_page (self, NULL, factory, user_data, destroy,
+                                 NULL, position, FALSE);
+}
+
+/**
+ * adw_tab_view_append_lazy:
+ * @self: a tab view
+ * @factory: (scope notified): the function to create the child with
+ * @user_data: (closure): the data to be passed to @factory
+ * @destroy: (destroy user_data): the function to be called when @factory is no
+ *   longer needed
+ *
+ * Inserts a page without a child as the last non-pinned page.
+ *
+ * See [method@TabView.insert_lazy].
+ *
+ * Returns: (transfer none): the page object
+ *
+ * Since: 1.4
+ */
+AdwTabPage *
+adw_tab_view_append_lazy (AdwTabView            *self,
+                          AdwTabPageFactoryFunc  factory,
+                          gpointer               user_data,
+                          GDestroyNotify         destroy)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
+  g_return_val_if_fail (factory != NULL, NULL);
+
+  return create_and_insert_page (self, NULL, factory, user_data, destroy,
+                                 NULL, self->n_pages, FALSE);
+}
+
+/**
+ * adw_tab_view_insert_pages:
+ * @self: a tab view
+ * @children: (array length=n_children): the widgets to add
+ * @n_children: the number of widgets in @children
+ * @position: the position to add the first page at, starting from 0
+ *
+ * Inserts non-pinned pages for each of @children, starting at @position.
+ *
+ * This is equivalent to calling [method@TabView.insert] for each child, but
+ * the pages are added as a single change: [property@TabView:pages] emits
+ * [signal@Gio.ListModel::items-changed] once, and [class@TabBar] and
+ * [class@TabOverview] add the tabs without animating each of them.
+ *
+ * [signal@TabView::page-attached] is still emitted for every page.
+ *
+ * It's an error to try to insert pages before a pinned page.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_view_insert_pages (AdwTabView  *self,
+                           GtkWidget  **children,
+                           guint        n_children,
+                           int          position)
+{
+  guint i;
+
+  g_return_if_fail (ADW_IS_TAB_VIEW (self));
+  g_return_if_fail (children != NULL || n_children == 0);
+  g_return_if_fail (position >= self->n_pinned_pages);
+  g_return_if_fail (position <= self->n_pages);
+
+  for (i = 0; i < n_children; i++)
+    g_return_if_fail (GTK_IS_WIDGET (children[i]));
+
+  if (!n_children)
+    return;
+
+  begin_batch (self);
+
+  for (i = 0; i < n_children; i++) {
+    AdwTabPage *page = g_object_new (ADW_TYPE_TAB_PAGE,
+                                     "child", children[i],
+                                     NULL);
+
+    attach_page (self, page, position + i);
+
+    if (!self->selected_page)
+      set_selected_page (self, page, FALSE);
+
+    g_object_unref (page);
+  }
+
+  flush_pending_removals (self);
+
+  if (self->pages)
+    g_list_model_items_changed (G_LIST_MODEL (self->pages), position, 0, n_children);
+
+  end_batch (self);
 }
 
 /**
@@ -4193,6 +5777,8 @@ adw_tab_view_close_other_pages (AdwTabView *self,
   g_return_if_fail (ADW_IS_TAB_PAGE (page));
   g_return_if_fail (page_belongs_to_this_view (self, page));
 
+  begin_batch (self);
+
   for (i = self->n_pages - 1; i >= 0; i--) {
     AdwTabPage *p = adw_tab_view_get_nth_page (self, i);
 
@@ -4201,6 +5787,8 @@ adw_tab_view_close_other_pages (AdwTabView *self,
 
     adw_tab_view_close_page (self, p);
   }
+
+  end_batch (self);
 }
 
 /**
@@ -4222,11 +5810,15 @@ adw_tab_view_close_pages_before (AdwTabView *self,
 
   pos = adw_tab_view_get_page_position (self, page);
 
+  begin_batch (self);
+
   for (i = pos - 1; i >= 0; i--) {
     AdwTabPage *p = adw_tab_view_get_nth_page (self, i);
 
     adw_tab_view_close_page (self, p);
   }
+
+  end_batch (self);
 }
 
 /**
@@ -4248,66 +5840,237 @@ adw_tab_view_close_pages_after (AdwTabView *self,
 
   pos = adw_tab_view_get_page_position (self, page);
 
+  begin_batch (self);
+
   for (i = self->n_pages - 1; i > pos; i--) {
     AdwTabPage *p = adw_tab_view_get_nth_page (self, i);
 
-    adw_tab_view_close_page (self, p);
+    adw_tab_view_close_page (self, p);
+  }
+
+  end_batch (self);
+}
+
+static int
+compare_position_descending (gconstpointer a,
+                             gconstpointer b)
+{
+  AdwTabPage *page_a = *(AdwTabPage **) a;
+  AdwTabPage *page_b = *(AdwTabPage **) b;
+
+  return page_b->position - page_a->position;
+}
+
+/**
+ * adw_tab_view_close_pages:
+ * @self: a tab view
+ * @pages: (array length=n_pages): pages of @self
+ * @n_pages: the number of pages in @pages
+ *
+ * Requests to close each page in @pages.
+ *
+ * This is equivalent to calling [method@TabView.close_page] for each page, but
+ * the pages that are closed right away are removed as a single change:
+ * [property@TabView:pages] emits [signal@Gio.ListModel::items-changed] once per
+ * contiguous range of closed pages, and [class@TabBar] and [class@TabOverview]
+ * remove the tabs without animating each of them.
+ *
+ * If the selected page is in @pages, it's closed last, so that the page
+ * selected in its place is one that stays open.
+ *
+ * Pages that are confirmed later with [method@TabView.close_page_finish] are
+ * removed individually.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_view_close_pages (AdwTabView  *self,
+                          AdwTabPage **pages,
+                          guint        n_pages)
+{
+  GPtrArray *sorted;
+  AdwTabPage *selected = NULL;
+  guint i;
+
+  g_return_if_fail (ADW_IS_TAB_VIEW (self));
+  g_return_if_fail (pages != NULL || n_pages == 0);
+
+  for (i = 0; i < n_pages; i++) {
+    g_return_if_fail (ADW_IS_TAB_PAGE (pages[i]));
+    g_return_if_fail (page_belongs_to_this_view (self, pages[i]));
+  }
+
+  if (!n_pages)
+    return;
+
+  sorted = g_ptr_array_new_full (n_pages, g_object_unref);
+
+  for (i = 0; i < n_pages; i++) {
+    if (pages[i] == self->selected_page)
+      selected = pages[i];
+    else
+      g_ptr_array_add (sorted, g_object_ref (pages[i]));
+  }
+
+  /* Closing from the end keeps the positions of the remaining pages valid and
+   * lets adjacent pages coalesce into a single range */
+  g_ptr_array_sort (sorted, compare_position_descending);
+
+  begin_batch (self);
+
+  for (i = 0; i < sorted->len; i++) {
+    AdwTabPage *page = g_ptr_array_index (sorted, i);
+
+    if (page_belongs_to_this_view (self, page))
+      adw_tab_view_close_page (self, page);
+  }
+
+  if (selected && page_belongs_to_this_view (self, selected))
+    adw_tab_view_close_page (self, selected);
+
+  end_batch (self);
+
+  g_ptr_array_unref (sorted);
+}
+
+/**
+ * adw_tab_view_reorder_page:
+ * @self: a tab view
+ * @page: a page of @self
+ * @position: the position to insert the page at, starting at 0
+ *
+ * Reorders @page to @position.
+ *
+ * It's a programmer error to try to reorder a pinned page after a non-pinned
+ * one, or a non-pinned page before a pinned one.
+ *
+ * Returns: whether @page was moved
+ */
+gboolean
+adw_tab_view_reorder_page (AdwTabView *self,
+                           AdwTabPage *page,
+                           int         position)
+{
+  int original_pos;
+
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), FALSE);
+  g_return_val_if_fail (ADW_IS_TAB_PAGE (page), FALSE);
+  g_return_val_if_fail (page_belongs_to_this_view (self, page), FALSE);
+
+  if (adw_tab_page_get_pinned (page)) {
+    g_return_val_if_fail (position >= 0, FALSE);
+    g_return_val_if_fail (position < self->n_pinned_pages, FALSE);
+  } else {
+    g_return_val_if_fail (position >= self->n_pinned_pages, FALSE);
+    g_return_val_if_fail (position < self->n_pages, FALSE);
+  }
+
+  original_pos = adw_tab_view_get_page_position (self, page);
+
+  if (original_pos == position)
+    return FALSE;
+
+  move_page (self, page, original_pos, position);
+
+  g_signal_emit (self, signals[SIGNAL_PAGE_REORDERED], 0, page, position);
+
+  flush_pending_removals (self);
+
+  if (self->pages) {
+    int min = MIN (original_pos, position);
+    int n_changed = MAX (original_pos, position) - min + 1;
+
+    g_list_model_items_changed (G_LIST_MODEL (self->pages), min, n_changed, n_changed);
   }
+
+  return TRUE;
 }
 
 /**
- * adw_tab_view_reorder_page:
+ * adw_tab_view_reorder_pages:
  * @self: a tab view
- * @page: a page of @self
- * @position: the position to insert the page at, starting at 0
+ * @position: the position of the first page to move, starting at 0
+ * @n_pages: the number of pages to move
+ * @new_position: the position to move the first page to, starting at 0
  *
- * Reorders @page to @position.
+ * Moves @n_pages pages starting at @position so that the first of them ends up
+ * at @new_position, keeping their order.
  *
- * It's a programmer error to try to reorder a pinned page after a non-pinned
- * one, or a non-pinned page before a pinned one.
+ * [signal@TabView::page-reordered] is emitted for every moved page, but
+ * [property@TabView:pages] emits [signal@Gio.ListModel::items-changed] once
+ * for the whole affected range.
  *
- * Returns: whether @page was moved
+ * The pages must be either all pinned or all non-pinned. It's a programmer
+ * error to try to move pinned pages after a non-pinned one, or non-pinned
+ * pages before a pinned one.
+ *
+ * Returns: whether the pages were moved
+ *
+ * Since: 1.4
  */
 gboolean
-adw_tab_view_reorder_page (AdwTabView *self,
-                           AdwTabPage *page,
-                           int         position)
+adw_tab_view_reorder_pages (AdwTabView *self,
+                            int         position,
+                            int         n_pages,
+                            int         new_position)
 {
-  int original_pos;
+  gboolean pinned;
+  int i, min;
 
   g_return_val_if_fail (ADW_IS_TAB_VIEW (self), FALSE);
-  g_return_val_if_fail (ADW_IS_TAB_PAGE (page), FALSE);
-  g_return_val_if_fail (page_belongs_to_this_view (self, page), FALSE);
+  g_return_val_if_fail (n_pages > 0, FALSE);
+  g_return_val_if_fail (position >= 0, FALSE);
+  g_return_val_if_fail (position + n_pages <= self->n_pages, FALSE);
 
-  if (adw_tab_page_get_pinned (page)) {
-    g_return_val_if_fail (position >= 0, FALSE);
-    g_return_val_if_fail (position < self->n_pinned_pages, FALSE);
+  pinned = position < self->n_pinned_pages;
+
+  if (pinned) {
+    g_return_val_if_fail (position + n_pages <= self->n_pinned_pages, FALSE);
+    g_return_val_if_fail (new_position >= 0, FALSE);
+    g_return_val_if_fail (new_position + n_pages <= self->n_pinned_pages, FALSE);
   } else {
-    g_return_val_if_fail (position >= self->n_pinned_pages, FALSE);
-    g_return_val_if_fail (position < self->n_pages, FALSE);
+    g_return_val_if_fail (new_position >= self->n_pinned_pages, FALSE);
+    g_return_val_if_fail (new_position + n_pages <= self->n_pages, FALSE);
   }
 
-  original_pos = adw_tab_view_get_page_position (self, page);
-
-  if (original_pos == position)
+  if (position == new_position)
     return FALSE;
 
-  g_object_ref (page);
+  begin_batch (self);
+
+  /* Move the pages one at a time, so that applying each page-reordered
+   * emission in order yields the final order */
+  for (i = 0; i < n_pages; i++) {
+    AdwTabPage *page;
+    int from, to;
+
+    if (new_position > position) {
+      from = position;
+      to = new_position + n_pages - 1;
+    } else {
+      from = position + i;
+      to = new_position + i;
+    }
 
-  g_list_store_remove (self->children, original_pos);
-  g_list_store_insert (self->children, position, page);
+    page = adw_tab_view_get_nth_page (self, from);
 
-  g_object_unref (page);
+    move_page (self, page, from, to);
 
-  g_signal_emit (self, signals[SIGNAL_PAGE_REORDERED], 0, page, position);
+    g_signal_emit (self, signals[SIGNAL_PAGE_REORDERED], 0, page, to);
+  }
+
+  flush_pending_removals (self);
+
+  min = MIN (position, new_position);
 
   if (self->pages) {
-    int min = MIN (original_pos, position);
-    int n_changed = MAX (original_pos, position) - min + 1;
+    int n_changed = MAX (position, new_position) + n_pages - min;
 
     g_list_model_items_changed (G_LIST_MODEL (self->pages), min, n_changed, n_changed);
   }
 
+  end_batch (self);
+
   return TRUE;
 }
 
@@ -4453,6 +6216,8 @@ adw_tab_view_attach_page (AdwTabView *self,
 
   attach_page (self, page, position);
 
+  flush_pending_removals (self);
+
   if (self->pages)
     g_list_model_items_changed (G_LIST_MODEL (self->pages), position, 0, 1);
 
@@ -4528,6 +6293,198 @@ adw_tab_view_get_pages (AdwTabView *self)
   return self->pages;
 }
 
+/**
+ * adw_tab_view_save_state:
+ * @self: a tab view
+ * @flags: what to include
+ *
+ * Saves the pages of @self, so that they can be restored later with
+ * [method@TabView.restore_state].
+ *
+ * The state includes the order of the pages, which of them are pinned and
+ * selected, and their [property@TabPage:title], [property@TabPage:tooltip],
+ * [property@TabPage:keyword], [property@TabPage:icon],
+ * [property@TabPage:indicator-icon], [property@TabPage:indicator-tooltip],
+ * [property@TabPage:indicator-activatable],
+ * [property@TabPage:thumbnail-xalign] and [property@TabPage:thumbnail-yalign].
+ * Icons that can't be serialized with [method@Gio.Icon.serialize] are skipped.
+ *
+ * If @flags includes `ADW_TAB_VIEW_STATE_THUMBNAILS`, thumbnails that are
+ * already rendered, or were set with [method@TabPage.set_thumbnail], are saved
+ * as well. Pages that never had a thumbnail don't get one.
+ *
+ * The page children are not part of the state, applications need to save
+ * their contents separately.
+ *
+ * The returned value can be written to a file with [method@GLib.Variant.get_data]
+ * and [method@GLib.Variant.get_size]. It's only meant to be restored on the
+ * same machine.
+ *
+ * Returns: (transfer full): the saved state
+ *
+ * Since: 1.4
+ */
+GVariant *
+adw_tab_view_save_state (AdwTabView           *self,
+                         AdwTabViewStateFlags  flags)
+{
+  GVariantBuilder builder;
+  int selected = -1;
+  int i;
+
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a" STATE_PAGE_TYPE));
+
+  for (i = 0; i < self->n_pages; i++) {
+    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+    GVariant *icon = NULL, *indicator_icon = NULL, *thumbnail = NULL;
+
+    if (page->icon)
+      icon = g_icon_serialize (page->icon);
+
+    if (page->indicator_icon)
+      indicator_icon = g_icon_serialize (page->indicator_icon);
+
+    if (flags & ADW_TAB_VIEW_STATE_THUMBNAILS) {
+      GdkTexture *texture = get_page_thumbnail (page);
+
+      if (texture)
+        thumbnail = serialize_thumbnail (texture);
+    }
+
+    g_variant_builder_add (&builder, "(ssmsmvmvsbddm@" STATE_THUMBNAIL_TYPE ")",
+                           page->title,
+                           page->tooltip,
+                           page->keyword,
+                           icon,
+                           indicator_icon,
+                           page->indicator_tooltip,
+                           page->indicator_activatable,
+                           (double) page->thumbnail_xalign,
+                           (double) page->thumbnail_yalign,
+                           thumbnail);
+
+    g_clear_pointer (&icon, g_variant_unref);
+    g_clear_pointer (&indicator_icon, g_variant_unref);
+  }
+
+  if (self->selected_page)
+    selected = self->selected_page->position;
+
+  return g_variant_ref_sink (g_variant_new ("(uv)", STATE_VERSION,
+                                            g_variant_new ("(ui@a" STATE_PAGE_TYPE ")",
+                                                           (guint32) self->n_pinned_pages,
+                                                           selected,
+                                                           g_variant_builder_end (&builder))));
+}
+
+/**
+ * adw_tab_view_restore_state:
+ * @self: a tab view without pages
+ * @state: a state saved with [method@TabView.save_state]
+ * @factory: (scope notified): the function to create the page children with
+ * @user_data: (closure): the data to be passed to @factory
+ * @destroy: (destroy user_data): the function to be called when @factory is no
+ *   longer needed
+ *
+ * Adds the pages saved in @state to @self.
+ *
+ * All pages are added as a single change, the same way as with
+ * [method@TabView.insert_pages], and their properties are set before they are
+ * added, so they aren't notified separately.
+ *
+ * The pages are added without children, like with [method@TabView.insert_lazy].
+ * Their children are created by calling @factory when they are needed, starting
+ * with the selected page once all pages have been added. The pages are at the
+ * same positions as when @state was saved, so @factory can use
+ * [method@TabView.get_page_position] to find out what to create.
+ *
+ * @state can be created with [ctor@GLib.Variant.new_from_bytes] from a
+ * [struct@GLib.MappedFile]. In that case, the saved thumbnails are not copied,
+ * and are only read from the file once they are drawn.
+ *
+ * @destroy is called even if @state can't be restored.
+ *
+ * Returns: whether @state was restored. It fails if @state is not a saved
+ *   state, or was saved by an incompatible version of libadwaita
+ *
+ * Since: 1.4
+ */
+gboolean
+adw_tab_view_restore_state (AdwTabView            *self,
+                            GVariant              *state,
+                            AdwTabPageFactoryFunc  factory,
+                            gpointer               user_data,
+                            GDestroyNotify         destroy)
+{
+  StateFactory *state_factory;
+  GVariant *payload, *pages;
+  guint32 version, n_pinned;
+  int selected;
+  gsize i, n;
+
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), FALSE);
+  g_return_val_if_fail (state != NULL, FALSE);
+  g_return_val_if_fail (factory != NULL, FALSE);
+  g_return_val_if_fail (self->n_pages == 0, FALSE);
+
+  state_factory = g_rc_box_new (StateFactory);
+  state_factory->factory = factory;
+  state_factory->user_data = user_data;
+  state_factory->destroy = destroy;
+
+  if (!g_variant_is_of_type (state, G_VARIANT_TYPE ("(uv)"))) {
+    state_factory_release (state_factory);
+
+    return FALSE;
+  }
+
+  g_variant_get (state, "(uv)", &version, &payload);
+
+  if (version != STATE_VERSION ||
+      !g_variant_is_of_type (payload, G_VARIANT_TYPE (STATE_TYPE))) {
+    g_variant_unref (payload);
+    state_factory_release (state_factory);
+
+    return FALSE;
+  }
+
+  g_variant_get (payload, "(ui@a" STATE_PAGE_TYPE ")", &n_pinned, &selected, &pages);
+
+  n = g_variant_n_children (pages);
+
+  if (n > 0) {
+    begin_batch (self);
+
+    for (i = 0; i < n; i++) {
+      AdwTabPage *page = restore_page (pages, i, i < n_pinned, state_factory);
+
+      attach_page (self, page, i);
+
+      g_object_unref (page);
+    }
+
+    if (selected < 0 || selected >= n)
+      selected = 0;
+
+    set_selected_page (self, adw_tab_view_get_nth_page (self, selected), FALSE);
+
+    flush_pending_removals (self);
+
+    if (self->pages)
+      g_list_model_items_changed (G_LIST_MODEL (self->pages), 0, 0, n);
+
+    end_batch (self);
+  }
+
+  g_variant_unref (pages);
+  g_variant_unref (payload);
+  state_factory_release (state_factory);
+
+  return TRUE;
+}
+
 /**
  * adw_tab_view_invalidate_thumbnails:
  * @self: a tab view
@@ -4552,6 +6509,246 @@ adw_tab_view_invalidate_thumbnails (AdwTabView *self)
   }
 }
 
+/**
+ * adw_tab_view_get_thumbnail_cache_size: (attributes org.gtk.Method.get_property=thumbnail-cache-size)
+ * @self: a tab view
+ *
+ * Gets the maximum amount of memory used for cached thumbnails in @self.
+ *
+ * Returns: the thumbnail cache size, in bytes
+ *
+ * Since: 1.4
+ */
+guint64
+adw_tab_view_get_thumbnail_cache_size (AdwTabView *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), 0);
+
+  return self->thumbnail_cache_size;
+}
+
+/**
+ * adw_tab_view_set_thumbnail_cache_size: (attributes org.gtk.Method.set_property=thumbnail-cache-size)
+ * @self: a tab view
+ * @size: the thumbnail cache size, in bytes
+ *
+ * Sets the maximum amount of memory used for cached thumbnails in @self.
+ *
+ * If the cache is already larger than @size, the least recently shown
+ * thumbnails are discarded immediately.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_view_set_thumbnail_cache_size (AdwTabView *self,
+                                       guint64     size)
+{
+  g_return_if_fail (ADW_IS_TAB_VIEW (self));
+
+  if (self->thumbnail_cache_size == size)
+    return;
+
+  self->thumbnail_cache_size = size;
+
+  trim_thumbnail_cache (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_THUMBNAIL_CACHE_SIZE]);
+}
+
+/**
+ * adw_tab_view_get_max_live_pages: (attributes org.gtk.Method.get_property=max-live-pages)
+ * @self: a tab view
+ *
+ * Gets the maximum number of pages in @self that have a child.
+ *
+ * Returns: the maximum number of live pages, or 0 if it's unlimited
+ *
+ * Since: 1.4
+ */
+int
+adw_tab_view_get_max_live_pages (AdwTabView *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), 0);
+
+  return self->max_live_pages;
+}
+
+/**
+ * adw_tab_view_set_max_live_pages: (attributes org.gtk.Method.set_property=max-live-pages)
+ * @self: a tab view
+ * @max_live_pages: the maximum number of live pages
+ *
+ * Sets the maximum number of pages in @self that have a child.
+ *
+ * When there are more pages with a child, the least recently selected pages
+ * are hibernated, as long as [property@TabPage:can-hibernate] is `TRUE` for
+ * them. The selected page is never hibernated.
+ *
+ * If set to 0, pages are never hibernated.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_view_set_max_live_pages (AdwTabView *self,
+                                 int         max_live_pages)
+{
+  g_return_if_fail (ADW_IS_TAB_VIEW (self));
+  g_return_if_fail (max_live_pages >= 0);
+
+  if (self->max_live_pages == max_live_pages)
+    return;
+
+  self->max_live_pages = max_live_pages;
+
+  schedule_hibernation (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_LIVE_PAGES]);
+}
+
+/**
+ * adw_tab_view_get_max_warm_pages: (attributes org.gtk.Method.get_property=max-warm-pages)
+ * @self: a tab view
+ *
+ * Gets the number of recently selected pages to keep mapped in @self.
+ *
+ * Returns: the number of warm pages
+ *
+ * Since: 1.4
+ */
+int
+adw_tab_view_get_max_warm_pages (AdwTabView *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), 0);
+
+  return self->max_warm_pages;
+}
+
+/**
+ * adw_tab_view_set_max_warm_pages: (attributes org.gtk.Method.set_property=max-warm-pages)
+ * @self: a tab view
+ * @max_warm_pages: the number of warm pages
+ *
+ * Sets the number of recently selected pages to keep mapped in @self.
+ *
+ * Non-selected pages are normally unmapped, so switching back to a page
+ * that is expensive to map, such as a web view, can stall the first frame.
+ *
+ * The given number of most recently selected pages stay mapped while hidden
+ * behind the selected page, which makes switching between them instant. They
+ * are never drawn and don't receive input.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_view_set_max_warm_pages (AdwTabView *self,
+                                 int         max_warm_pages)
+{
+  g_return_if_fail (ADW_IS_TAB_VIEW (self));
+  g_return_if_fail (max_warm_pages >= 0);
+
+  if (self->max_warm_pages == max_warm_pages)
+    return;
+
+  self->max_warm_pages = max_warm_pages;
+
+  update_warm_pages (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_WARM_PAGES]);
+}
+
+/*
+ * adw_tab_view_get_last_switch_duration:
+ * @self: a tab view
+ *
+ * Gets how long it took from the last page switch in @self until the first
+ * frame showing the new page was painted.
+ *
+ * Switches that happen while @self is not mapped are not measured.
+ *
+ * Returns: the duration in microseconds, or 0 if it's not known yet
+ */
+gint64
+adw_tab_view_get_last_switch_duration (AdwTabView *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), 0);
+
+  return self->last_switch_duration;
+}
+
+/*
+ * adw_tab_view_get_is_batching:
+ * @self: a tab view
+ *
+ * Gets whether @self is adding, closing or moving several pages at once, such
+ * as in [method@TabView.close_pages].
+ *
+ * Tab bars and grids use it to skip animating the individual tabs.
+ *
+ * Returns: whether a batch is in progress
+ */
+gboolean
+adw_tab_view_get_is_batching (AdwTabView *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), FALSE);
+
+  return self->batch_depth > 0;
+}
+
+/*
+ * adw_tab_view_get_search_index:
+ * @self: a tab view
+ *
+ * Gets the search index of @self, creating it on first use.
+ *
+ * Returns: (transfer none): the search index
+ */
+AdwTabSearchIndex *
+adw_tab_view_get_search_index (AdwTabView *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_VIEW (self), NULL);
+
+  if (!self->search_index) {
+    int i;
+
+    self->search_index = adw_tab_search_index_new ();
+
+    for (i = 0; i < self->n_pages; i++)
+      adw_tab_search_index_add_page (self->search_index,
+                                     adw_tab_view_get_nth_page (self, i));
+  }
+
+  return self->search_index;
+}
+
+/**
+ * adw_tab_view_get_hibernation_counts:
+ * @self: a tab view
+ * @n_hibernated: (out) (optional): return location for the number of
+ *   hibernated pages
+ * @n_restored: (out) (optional): return location for the number of restored
+ *   pages
+ *
+ * Gets how many times pages in @self have been hibernated and restored.
+ *
+ * This is meant for measuring how well [property@TabView:max-live-pages] fits
+ * the application.
+ *
+ * Since: 1.4
+ */
+void
+adw_tab_view_get_hibernation_counts (AdwTabView *self,
+                                     guint      *n_hibernated,
+                                     guint      *n_restored)
+{
+  g_return_if_fail (ADW_IS_TAB_VIEW (self));
+
+  if (n_hibernated)
+    *n_hibernated = self->n_hibernated;
+
+  if (n_restored)
+    *n_restored = self->n_restored;
+}
+
 AdwTabView *
 adw_tab_view_create_window (AdwTabView *self)
 {
@@ -4575,20 +6772,21 @@ adw_tab_view_open_overview (AdwTabView *self)
 {
   g_return_if_fail (ADW_IS_TAB_VIEW (self));
 
-  if (self->overview_count == 0) {
+  self->overview_count++;
+
+  if (self->overview_count == 1) {
     int i;
 
+    /* Render thumbnails progressively instead of all in the first frame of
+     * the open transition. Until then they show placeholders */
     for (i = 0; i < self->n_pages; i++) {
       AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
 
-      if (page->live_thumbnail || page->invalidated)
-        gtk_widget_set_child_visible (page->bin, TRUE);
+      page->thumbnail_requested = FALSE;
     }
 
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    schedule_thumbnails (self);
   }
-
-  self->overview_count++;
 }
 
 void
@@ -4601,12 +6799,14 @@ adw_tab_view_close_overview (AdwTabView *self)
   if (self->overview_count == 0) {
     int i;
 
+    unschedule_thumbnails (self);
+
     for (i = 0; i < self->n_pages; i++) {
       AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
 
       if (page->live_thumbnail || page->invalidated)
         gtk_widget_set_child_visible (page->bin,
-                                      page == self->selected_page);
+                                      page == self->selected_page || page->warm);
     }
 
     gtk_widget_queue_allocate (GTK_WIDGET (self));
@@ -36,6 +36,11 @@ typedef enum /*< flags >*/ {
   ADW_TAB_VIEW_SHORTCUT_ALL_SHORTCUTS           = 0xFFF
 } AdwTabViewShortcuts;
 
+typedef enum /*< flags >*/ {
+  ADW_TAB_VIEW_STATE_NONE       = 0,
+  ADW_TAB_VIEW_STATE_THUMBNAILS = 1 << 0,
+} AdwTabViewStateFlags;
+
 #define ADW_TYPE_TAB_PAGE (adw_tab_page_get_type())
 
 ADW_AVAILABLE_IN_ALL
@@ -128,6 +133,45 @@ void     adw_tab_page_set_live_thumbnail (AdwTabPage *self,
 ADW_AVAILABLE_IN_1_3
 void adw_tab_page_invalidate_thumbnail (AdwTabPage *self);
 
+ADW_AVAILABLE_IN_1_4
+void adw_tab_page_set_thumbnail (AdwTabPage *self,
+                                 GdkTexture *thumbnail);
+
+ADW_AVAILABLE_IN_1_4
+gboolean adw_tab_page_get_can_hibernate (AdwTabPage *self);
+ADW_AVAILABLE_IN_1_4
+void     adw_tab_page_set_can_hibernate (AdwTabPage *self,
+                                         gboolean    can_hibernate);
+
+ADW_AVAILABLE_IN_1_4
+gboolean adw_tab_page_get_hibernated (AdwTabPage *self);
+
+/**
+ * AdwTabPageFactoryFunc:
+ * @page: the page to create the child for
+ * @user_data: (nullable): the user data provided when adding the page
+ *
+ * Prototype for creating the child of a page added with
+ * [method@TabView.insert_lazy].
+ *
+ * Returns: (transfer floating): the child widget
+ *
+ * Since: 1.4
+ */
+typedef GtkWidget *(*AdwTabPageFactoryFunc) (AdwTabPage *page,
+                                             gpointer    user_data);
+
+ADW_AVAILABLE_IN_1_4
+void adw_tab_page_set_child_factory (AdwTabPage            *self,
+                                     AdwTabPageFactoryFunc  factory,
+                                     gpointer               user_data,
+                                     GDestroyNotify         destroy);
+
+ADW_AVAILABLE_IN_1_4
+void adw_tab_page_freeze_updates (AdwTabPage *self);
+ADW_AVAILABLE_IN_1_4
+void adw_tab_page_thaw_updates   (AdwTabPage *self);
+
 #define ADW_TYPE_TAB_VIEW (adw_tab_view_get_type())
 
 ADW_AVAILABLE_IN_ALL
@@ -223,6 +267,24 @@ ADW_AVAILABLE_IN_ALL
 AdwTabPage *adw_tab_view_append_pinned  (AdwTabView *self,
                                          GtkWidget  *child);
 
+ADW_AVAILABLE_IN_1_4
+AdwTabPage *adw_tab_view_insert_lazy (AdwTabView            *self,
+                                      int                    position,
+                                      AdwTabPageFactoryFunc  factory,
+                                      gpointer               user_data,
+                                      GDestroyNotify         destroy);
+ADW_AVAILABLE_IN_1_4
+AdwTabPage *adw_tab_view_append_lazy (AdwTabView            *self,
+                                      AdwTabPageFactoryFunc  factory,
+                                      gpointer               user_data,
+                                      GDestroyNotify         destroy);
+
+ADW_AVAILABLE_IN_1_4
+void adw_tab_view_insert_pages (AdwTabView  *self,
+                                GtkWidget  **children,
+                                guint        n_children,
+                                int          position);
+
 ADW_AVAILABLE_IN_ALL
 void adw_tab_view_close_page        (AdwTabView *self,
                                      AdwTabPage *page);
@@ -241,6 +303,11 @@ ADW_AVAILABLE_IN_ALL
 void adw_tab_view_close_pages_after  (AdwTabView *self,
                                       AdwTabPage *page);
 
+ADW_AVAILABLE_IN_1_4
+void adw_tab_view_close_pages (AdwTabView  *self,
+                               AdwTabPage **pages,
+                               guint        n_pages);
+
 ADW_AVAILABLE_IN_ALL
 gboolean adw_tab_view_reorder_page     (AdwTabView *self,
                                         AdwTabPage *page,
@@ -258,6 +325,12 @@ ADW_AVAILABLE_IN_ALL
 gboolean adw_tab_view_reorder_last     (AdwTabView *self,
                                         AdwTabPage *page);
 
+ADW_AVAILABLE_IN_1_4
+gboolean adw_tab_view_reorder_pages (AdwTabView *self,
+                                     int         position,
+                                     int         n_pages,
+                                     int         new_position);
+
 ADW_AVAILABLE_IN_ALL
 void adw_tab_view_transfer_page (AdwTabView *self,
                                  AdwTabPage *page,
@@ -267,7 +340,40 @@ void adw_tab_view_transfer_page (AdwTabView *self,
 ADW_AVAILABLE_IN_ALL
 GtkSelectionModel *adw_tab_view_get_pages (AdwTabView *self) G_GNUC_WARN_UNUSED_RESULT;
 
+ADW_AVAILABLE_IN_1_4
+GVariant *adw_tab_view_save_state    (AdwTabView            *self,
+                                      AdwTabViewStateFlags   flags) G_GNUC_WARN_UNUSED_RESULT;
+ADW_AVAILABLE_IN_1_4
+gboolean  adw_tab_view_restore_state (AdwTabView            *self,
+                                      GVariant              *state,
+                                      AdwTabPageFactoryFunc  factory,
+                                      gpointer               user_data,
+                                      GDestroyNotify         destroy);
+
 ADW_AVAILABLE_IN_1_3
 void adw_tab_view_invalidate_thumbnails (AdwTabView *self);
 
+ADW_AVAILABLE_IN_1_4
+guint64 adw_tab_view_get_thumbnail_cache_size (AdwTabView *self);
+ADW_AVAILABLE_IN_1_4
+void    adw_tab_view_set_thumbnail_cache_size (AdwTabView *self,
+                                               guint64     size);
+
+ADW_AVAILABLE_IN_1_4
+int  adw_tab_view_get_max_live_pages (AdwTabView *self);
+ADW_AVAILABLE_IN_1_4
+void adw_tab_view_set_max_live_pages (AdwTabView *self,
+                                      int         max_live_pages);
+
+ADW_AVAILABLE_IN_1_4
+int  adw_tab_view_get_max_warm_pages (AdwTabView *self);
+ADW_AVAILABLE_IN_1_4
+void adw_tab_view_set_max_warm_pages (AdwTabView *self,
+                                      int         max_warm_pages);
+
+ADW_AVAILABLE_IN_1_4
+void adw_tab_view_get_hibernation_counts (AdwTabView *self,
+                                          guint      *n_hibernated,
+                                          guint      *n_restored);
+
 G_END_DECLS
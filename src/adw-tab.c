@@ -12,6 +12,7 @@
 #include "adw-bidi-private.h"
 #include "adw-fading-label-private.h"
 #include "adw-gizmo-private.h"
+#include "adw-spinner-paintable-private.h"
 #include "adw-timed-animation.h"
 
 #define FADE_WIDTH 18.0f
@@ -26,6 +27,15 @@
 #define ATTENTION_INDICATOR_MAX_WIDTH 180
 #define ATTENTION_INDICATOR_ANIMATION_DURATION 250
 
+typedef enum {
+  TAB_UPDATE_TITLE           = 1 << 0,
+  TAB_UPDATE_TOOLTIP         = 1 << 1,
+  TAB_UPDATE_ICONS           = 1 << 2,
+  TAB_UPDATE_INDICATOR       = 1 << 3,
+  TAB_UPDATE_NEEDS_ATTENTION = 1 << 4,
+  TAB_UPDATE_LOADING         = 1 << 5,
+} TabUpdateFlags;
+
 struct _AdwTab
 {
   GtkWidget parent_instance;
@@ -33,7 +43,7 @@ struct _AdwTab
   GtkWidget *title;
   GtkWidget *icon_stack;
   GtkImage *icon;
-  GtkSpinner *spinner;
+  GtkImage *spinner;
   GtkImage *indicator_icon;
   GtkWidget *indicator_btn;
   GtkWidget *close_btn;
@@ -53,9 +63,16 @@ struct _AdwTab
   gboolean close_overlap;
   gboolean show_close;
   gboolean fully_visible;
+  gboolean onscreen;
 
   AdwAnimation *close_btn_animation;
   AdwAnimation *needs_attention_animation;
+
+  GdkPaintable *spinner_paintable;
+
+  /* Page changes are applied once per frame */
+  TabUpdateFlags pending_updates;
+  guint update_cb_id;
 };
 
 G_DEFINE_FINAL_TYPE (AdwTab, adw_tab, GTK_TYPE_WIDGET)
@@ -161,6 +178,8 @@ update_title (AdwTab *self)
     (title_direction == PANGO_DIRECTION_LTR && direction == GTK_TEXT_DIR_RTL) ||
     (title_direction == PANGO_DIRECTION_RTL && direction == GTK_TEXT_DIR_LTR);
 
+  adw_fading_label_set_label (ADW_FADING_LABEL (self->title), title);
+
   if (self->title_inverted != title_inverted) {
     self->title_inverted = title_inverted;
     gtk_widget_queue_allocate (GTK_WIDGET (self));
@@ -174,9 +193,19 @@ update_spinner (AdwTab *self)
 {
   gboolean loading = self->page && adw_tab_page_get_loading (self->page);
   gboolean mapped = gtk_widget_get_mapped (GTK_WIDGET (self));
+  gboolean spinning = loading && mapped && self->onscreen;
 
   /* Don't use CPU when not needed */
-  gtk_spinner_set_spinning (self->spinner, loading && mapped);
+  if (spinning == (self->spinner_paintable != NULL))
+    return;
+
+  if (spinning) {
+    self->spinner_paintable = adw_spinner_paintable_new_for_widget (GTK_WIDGET (self));
+    gtk_image_set_from_paintable (self->spinner, self->spinner_paintable);
+  } else {
+    gtk_image_clear (self->spinner);
+    g_clear_object (&self->spinner_paintable);
+  }
 }
 
 static void
@@ -196,6 +225,7 @@ update_icons (AdwTab *self)
                           (!self->pinned || indicator == NULL));
   gtk_stack_set_visible_child_name (GTK_STACK (self->icon_stack), name);
 
+  gtk_image_set_from_gicon (self->indicator_icon, indicator);
   gtk_widget_set_visible (self->indicator_btn, indicator != NULL);
 }
 
@@ -231,6 +261,96 @@ update_loading (AdwTab *self)
                    adw_tab_page_get_loading (self->page));
 }
 
+static gboolean
+update_cb (GtkWidget     *widget,
+           GdkFrameClock *frame_clock,
+           gpointer       user_data)
+{
+  AdwTab *self = ADW_TAB (widget);
+  TabUpdateFlags flags = self->pending_updates;
+
+  self->pending_updates = 0;
+  self->update_cb_id = 0;
+
+  if (!self->page)
+    return G_SOURCE_REMOVE;
+
+  if (flags & TAB_UPDATE_TITLE)
+    update_title (self);
+  else if (flags & TAB_UPDATE_TOOLTIP)
+    update_tooltip (self);
+
+  if (flags & TAB_UPDATE_LOADING)
+    update_loading (self);
+  else if (flags & TAB_UPDATE_ICONS)
+    update_icons (self);
+
+  if (flags & TAB_UPDATE_INDICATOR)
+    update_indicator (self);
+
+  if (flags & TAB_UPDATE_NEEDS_ATTENTION)
+    update_needs_attention (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+queue_update (AdwTab         *self,
+              TabUpdateFlags  flags)
+{
+  self->pending_updates |= flags;
+
+  if (!self->update_cb_id)
+    self->update_cb_id = gtk_widget_add_tick_callback (GTK_WIDGET (self), update_cb, NULL, NULL);
+}
+
+static void
+cancel_updates (AdwTab *self)
+{
+  self->pending_updates = 0;
+
+  if (self->update_cb_id) {
+    gtk_widget_remove_tick_callback (GTK_WIDGET (self), self->update_cb_id);
+    self->update_cb_id = 0;
+  }
+}
+
+static void
+page_notify_title_cb (AdwTab *self)
+{
+  queue_update (self, TAB_UPDATE_TITLE);
+}
+
+static void
+page_notify_tooltip_cb (AdwTab *self)
+{
+  queue_update (self, TAB_UPDATE_TOOLTIP);
+}
+
+static void
+page_notify_icon_cb (AdwTab *self)
+{
+  queue_update (self, TAB_UPDATE_ICONS);
+}
+
+static void
+page_notify_indicator_activatable_cb (AdwTab *self)
+{
+  queue_update (self, TAB_UPDATE_INDICATOR);
+}
+
+static void
+page_notify_needs_attention_cb (AdwTab *self)
+{
+  queue_update (self, TAB_UPDATE_NEEDS_ATTENTION);
+}
+
+static void
+page_notify_loading_cb (AdwTab *self)
+{
+  queue_update (self, TAB_UPDATE_LOADING);
+}
+
 static void
 update_selected (AdwTab *self)
 {
@@ -373,6 +493,10 @@ activate_cb (AdwTab   *self,
 
   child = adw_tab_page_get_child (self->page);
 
+  /* Lazy pages don't have a child until they are selected */
+  if (!child)
+    return GDK_EVENT_PROPAGATE;
+
   gtk_widget_grab_focus (child);
 
   return GDK_EVENT_STOP;
@@ -660,7 +784,7 @@ adw_tab_constructed (GObject *object)
   }
 
   g_signal_connect_object (self->view, "notify::default-icon",
-                           G_CALLBACK (update_icons), self,
+                           G_CALLBACK (page_notify_icon_cb), self,
                            G_CONNECT_SWAPPED);
 }
 
@@ -741,6 +865,7 @@ adw_tab_dispose (GObject *object)
 
   g_clear_object (&self->close_btn_animation);
   g_clear_object (&self->needs_attention_animation);
+  g_clear_object (&self->spinner_paintable);
 
   gtk_widget_dispose_template (GTK_WIDGET (self), ADW_TYPE_TAB);
 
@@ -852,6 +977,8 @@ adw_tab_init (AdwTab *self)
 {
   AdwAnimationTarget *target;
 
+  self->onscreen = TRUE;
+
   gtk_widget_init_template (GTK_WIDGET (self));
 
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
@@ -907,14 +1034,17 @@ adw_tab_set_page (AdwTab     *self,
 
   if (self->page) {
     g_signal_handlers_disconnect_by_func (self->page, update_selected, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_title, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_tooltip, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_icons, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_indicator, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_needs_attention, self);
-    g_signal_handlers_disconnect_by_func (self->page, update_loading, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_title_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_tooltip_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_icon_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_indicator_activatable_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_needs_attention_cb, self);
+    g_signal_handlers_disconnect_by_func (self->page, page_notify_loading_cb, self);
   }
 
+  /* Everything is updated right away below */
+  cancel_updates (self);
+
   g_set_object (&self->page, page);
 
   if (self->page) {
@@ -932,26 +1062,29 @@ adw_tab_set_page (AdwTab     *self,
                              G_CALLBACK (update_selected), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::title",
-                             G_CALLBACK (update_title), self,
+                             G_CALLBACK (page_notify_title_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::tooltip",
-                             G_CALLBACK (update_tooltip), self,
+                             G_CALLBACK (page_notify_tooltip_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::icon",
-                             G_CALLBACK (update_icons), self,
+                             G_CALLBACK (page_notify_icon_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::indicator-icon",
-                             G_CALLBACK (update_icons), self,
+                             G_CALLBACK (page_notify_icon_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::indicator-activatable",
-                             G_CALLBACK (update_indicator), self,
+                             G_CALLBACK (page_notify_indicator_activatable_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::needs-attention",
-                             G_CALLBACK (update_needs_attention), self,
+                             G_CALLBACK (page_notify_needs_attention_cb), self,
                              G_CONNECT_SWAPPED);
     g_signal_connect_object (self->page, "notify::loading",
-                             G_CALLBACK (update_loading), self,
+                             G_CALLBACK (page_notify_loading_cb), self,
                              G_CONNECT_SWAPPED);
+  } else {
+    adw_fading_label_set_label (ADW_FADING_LABEL (self->title), NULL);
+    gtk_image_clear (self->indicator_icon);
   }
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_PAGE]);
@@ -1027,6 +1160,22 @@ adw_tab_set_fully_visible (AdwTab   *self,
   update_indicator (self);
 }
 
+void
+adw_tab_set_onscreen (AdwTab   *self,
+                      gboolean  onscreen)
+{
+  g_return_if_fail (ADW_IS_TAB (self));
+
+  onscreen = !!onscreen;
+
+  if (self->onscreen == onscreen)
+    return;
+
+  self->onscreen = onscreen;
+
+  update_spinner (self);
+}
+
 void
 adw_tab_setup_extra_drop_target (AdwTab        *self,
                                  GdkDragAction  actions,
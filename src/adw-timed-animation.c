@@ -10,6 +10,9 @@
 
 #include "adw-animation-private.h"
 #include "adw-animation-util.h"
+#include "adw-cubic-bezier-private.h"
+
+#include <math.h>
 
 /**
  * AdwTimedAnimation:
@@ -30,6 +33,11 @@
  * on the [property@TimedAnimation:repeat-count] value. If
  * [property@TimedAnimation:alternate] is set to `TRUE`, it will also change the
  * direction every other iteration.
+ *
+ * Instead of one of the predefined [enum@Easing] curves, the animation can also
+ * use a CSS-style cubic Bézier curve, set via
+ * [property@TimedAnimation:cubic-bezier]. Whichever of the two was set last is
+ * used.
  */
 
 struct _AdwTimedAnimation
@@ -40,6 +48,7 @@ struct _AdwTimedAnimation
   double value_to;
   guint duration; /* ms */
   AdwEasing easing;
+  AdwCubicBezier *cubic_bezier;
   guint repeat_count;
   gboolean reverse;
   gboolean alternate;
@@ -58,6 +67,7 @@ enum {
   PROP_VALUE_TO,
   PROP_DURATION,
   PROP_EASING,
+  PROP_CUBIC_BEZIER,
   PROP_REPEAT_COUNT,
   PROP_REVERSE,
   PROP_ALTERNATE,
@@ -106,11 +116,24 @@ adw_timed_animation_calculate_value (AdwAnimation *animation,
 
   progress = reverse ? (1 - progress) : progress;
 
-  value = adw_easing_ease (self->easing, progress);
+  if (self->cubic_bezier)
+    value = adw_cubic_bezier_ease (self->cubic_bezier, progress);
+  else
+    value = adw_easing_ease (self->easing, progress);
 
   return adw_lerp (self->value_from, self->value_to, value);
 }
 
+static void
+adw_timed_animation_finalize (GObject *object)
+{
+  AdwTimedAnimation *self = ADW_TIMED_ANIMATION (object);
+
+  g_clear_pointer (&self->cubic_bezier, adw_cubic_bezier_unref);
+
+  G_OBJECT_CLASS (adw_timed_animation_parent_class)->finalize (object);
+}
+
 static void
 adw_timed_animation_get_property (GObject    *object,
                                   guint       prop_id,
@@ -136,6 +159,17 @@ adw_timed_animation_get_property (GObject    *object,
     g_value_set_enum (value, adw_timed_animation_get_easing (self));
     break;
 
+  case PROP_CUBIC_BEZIER:
+    if (self->cubic_bezier) {
+      double x1, y1, x2, y2;
+
+      adw_cubic_bezier_get_control_points (self->cubic_bezier, &x1, &y1, &x2, &y2);
+      g_value_set_variant (value, g_variant_new ("(dddd)", x1, y1, x2, y2));
+    } else {
+      g_value_set_variant (value, NULL);
+    }
+    break;
+
   case PROP_REPEAT_COUNT:
     g_value_set_uint (value, adw_timed_animation_get_repeat_count (self));
     break;
@@ -178,6 +212,21 @@ adw_timed_animation_set_property (GObject      *object,
     adw_timed_animation_set_easing (self, g_value_get_enum (value));
     break;
 
+  case PROP_CUBIC_BEZIER:
+    {
+      GVariant *variant = g_value_get_variant (value);
+      double x1, y1, x2, y2;
+
+      if (variant) {
+        g_variant_get (variant, "(dddd)", &x1, &y1, &x2, &y2);
+        g_return_if_fail (isfinite (y1) && isfinite (y2));
+        adw_timed_animation_set_cubic_bezier (self, x1, y1, x2, y2);
+      } else if (self->cubic_bezier) {
+        adw_timed_animation_set_easing (self, self->easing);
+      }
+    }
+    break;
+
   case PROP_REPEAT_COUNT:
     adw_timed_animation_set_repeat_count (self, g_value_get_uint (value));
     break;
@@ -201,6 +250,7 @@ adw_timed_animation_class_init (AdwTimedAnimationClass *klass)
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
   AdwAnimationClass *animation_class = ADW_ANIMATION_CLASS (klass);
 
+  object_class->finalize = adw_timed_animation_finalize;
   object_class->set_property = adw_timed_animation_set_property;
   object_class->get_property = adw_timed_animation_get_property;
 
@@ -275,6 +325,26 @@ adw_timed_animation_class_init (AdwTimedAnimationClass *klass)
                        ADW_EASE_OUT_CUBIC,
                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwTimedAnimation:cubic-bezier:
+   *
+   * The cubic Bézier curve used in the animation, if any.
+   *
+   * The curve is stored as a `(dddd)` variant holding the control points
+   * `(x1, y1, x2, y2)`, see [method@TimedAnimation.set_cubic_bezier].
+   *
+   * When set, the curve is used instead of [property@TimedAnimation:easing].
+   * Setting [property@TimedAnimation:easing] or setting this property to `NULL`
+   * unsets the curve. If both are set on construction, the curve is used.
+   *
+   * Since: 1.4
+   */
+  props[PROP_CUBIC_BEZIER] =
+    g_param_spec_variant ("cubic-bezier", NULL, NULL,
+                          G_VARIANT_TYPE ("(dddd)"),
+                          NULL,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   /**
    * AdwTimedAnimation:repeat-count: (attributes org.gtk.Property.get=adw_timed_animation_get_repeat_count org.gtk.Property.set=adw_timed_animation_set_repeat_count)
    *
@@ -505,20 +575,132 @@ adw_timed_animation_get_easing (AdwTimedAnimation *self)
  * Sets the easing function @self will use.
  *
  * See [enum@Easing] for the description of specific easing functions.
+ *
+ * This unsets [property@TimedAnimation:cubic-bezier].
  */
 void
 adw_timed_animation_set_easing (AdwTimedAnimation *self,
                                 AdwEasing          easing)
 {
+  gboolean had_cubic_bezier;
+
   g_return_if_fail (ADW_IS_TIMED_ANIMATION (self));
   g_return_if_fail (easing <= ADW_EASE_IN_OUT_BOUNCE);
 
-  if (self->easing == easing)
+  if (self->easing == easing && !self->cubic_bezier)
     return;
 
+  had_cubic_bezier = !!self->cubic_bezier;
+
+  g_clear_pointer (&self->cubic_bezier, adw_cubic_bezier_unref);
   self->easing = easing;
 
+  g_object_freeze_notify (G_OBJECT (self));
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_EASING]);
+
+  if (had_cubic_bezier)
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CUBIC_BEZIER]);
+
+  g_object_thaw_notify (G_OBJECT (self));
+}
+
+/**
+ * adw_timed_animation_get_cubic_bezier:
+ * @self: a timed animation
+ * @x1: (out) (optional): return location for the x coordinate of the first
+ *   control point
+ * @y1: (out) (optional): return location for the y coordinate of the first
+ *   control point
+ * @x2: (out) (optional): return location for the x coordinate of the second
+ *   control point
+ * @y2: (out) (optional): return location for the y coordinate of the second
+ *   control point
+ *
+ * Gets the cubic Bézier curve @self uses, if any.
+ *
+ * See [method@TimedAnimation.set_cubic_bezier].
+ *
+ * Returns: whether @self uses a cubic Bézier curve
+ *
+ * Since: 1.4
+ */
+gboolean
+adw_timed_animation_get_cubic_bezier (AdwTimedAnimation *self,
+                                      double            *x1,
+                                      double            *y1,
+                                      double            *x2,
+                                      double            *y2)
+{
+  g_return_val_if_fail (ADW_IS_TIMED_ANIMATION (self), FALSE);
+
+  if (!self->cubic_bezier)
+    return FALSE;
+
+  adw_cubic_bezier_get_control_points (self->cubic_bezier, x1, y1, x2, y2);
+
+  return TRUE;
+}
+
+/**
+ * adw_timed_animation_set_cubic_bezier:
+ * @self: a timed animation
+ * @x1: the x coordinate of the first control point, in the [0, 1] range
+ * @y1: the y coordinate of the first control point, must be finite
+ * @x2: the x coordinate of the second control point, in the [0, 1] range
+ * @y2: the y coordinate of the second control point, must be finite
+ *
+ * Sets a cubic Bézier curve for @self to use instead of
+ * [property@TimedAnimation:easing].
+ *
+ * The curve goes from (0, 0) to (1, 1) with the control points (@x1, @y1) and
+ * (@x2, @y2), the same way as the `cubic-bezier()` CSS easing function.
+ *
+ * The curve is sampled once and shared between all animations using the same
+ * control points, so it's as cheap to evaluate as the predefined easing
+ * functions.
+ *
+ * Setting [property@TimedAnimation:easing] unsets the curve, and the curve
+ * replaces the easing function until then.
+ *
+ * Since: 1.4
+ */
+void
+adw_timed_animation_set_cubic_bezier (AdwTimedAnimation *self,
+                                      double             x1,
+                                      double             y1,
+                                      double             x2,
+                                      double             y2)
+{
+  AdwCubicBezier *cubic_bezier;
+  gboolean had_cubic_bezier;
+
+  g_return_if_fail (ADW_IS_TIMED_ANIMATION (self));
+  g_return_if_fail (x1 >= 0 && x1 <= 1);
+  g_return_if_fail (x2 >= 0 && x2 <= 1);
+  g_return_if_fail (isfinite (y1) && isfinite (y2));
+
+  cubic_bezier = adw_cubic_bezier_get (x1, y1, x2, y2);
+
+  /* Curves with the same control points are shared */
+  if (self->cubic_bezier == cubic_bezier) {
+    adw_cubic_bezier_unref (cubic_bezier);
+    return;
+  }
+
+  had_cubic_bezier = !!self->cubic_bezier;
+
+  g_clear_pointer (&self->cubic_bezier, adw_cubic_bezier_unref);
+  self->cubic_bezier = cubic_bezier;
+
+  g_object_freeze_notify (G_OBJECT (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CUBIC_BEZIER]);
+
+  if (!had_cubic_bezier)
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_EASING]);
+
+  g_object_thaw_notify (G_OBJECT (self));
 }
 
 /**
@@ -55,6 +55,19 @@ ADW_AVAILABLE_IN_ALL
 void      adw_timed_animation_set_easing (AdwTimedAnimation *self,
                                           AdwEasing          easing);
 
+ADW_AVAILABLE_IN_1_4
+gboolean adw_timed_animation_get_cubic_bezier (AdwTimedAnimation *self,
+                                               double            *x1,
+                                               double            *y1,
+                                               double            *x2,
+                                               double            *y2);
+ADW_AVAILABLE_IN_1_4
+void     adw_timed_animation_set_cubic_bezier (AdwTimedAnimation *self,
+                                               double             x1,
+                                               double             y1,
+                                               double             x2,
+                                               double             y2);
+
 ADW_AVAILABLE_IN_ALL
 guint adw_timed_animation_get_repeat_count (AdwTimedAnimation *self);
 ADW_AVAILABLE_IN_ALL
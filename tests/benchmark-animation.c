@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+#include "adw-animation-private.h"
+#include "adw-animation-scheduler-private.h"
+#include "adw-animation-target-private.h"
+
+/* AdwAnimation needs a mapped widget to play, which needs a display. Instead,
+ * the animations are created without a widget and ticked the same way
+ * AdwAnimation does it: one entry per animation on the virtual clock, which
+ * doesn't need a frame clock, calculating the value and passing it to the
+ * target on every frame. */
+
+#define REFRESH_RATE 60
+#define N_WARMUP_FRAMES 10
+#define N_FRAMES 240
+
+typedef enum {
+  KIND_TIMED,
+  KIND_SPRING,
+} AnimationKind;
+
+typedef enum {
+  TARGET_CALLBACK,
+  TARGET_PROPERTY,
+} TargetKind;
+
+typedef struct _BenchmarkEntry BenchmarkEntry;
+
+struct _BenchmarkEntry {
+  AdwAnimation *animation;
+  AdwAnimationSchedulerEntry *entry;
+  gint64 start_time;
+};
+
+static void
+value_cb (double   value,
+          gpointer user_data)
+{
+  double *sink = user_data;
+
+  *sink = value;
+}
+
+static void
+tick_cb (gint64          frame_time,
+         BenchmarkEntry *data)
+{
+  guint t = (guint) ((frame_time - data->start_time) / 1000); /* ms */
+  double value;
+
+  value = ADW_ANIMATION_GET_CLASS (data->animation)->calculate_value (data->animation, t);
+
+  adw_animation_target_set_value (adw_animation_get_target (data->animation), value);
+}
+
+static AdwAnimation *
+create_animation (GObject       *object,
+                  AnimationKind  kind,
+                  TargetKind     target_kind,
+                  double        *sink)
+{
+  AdwAnimationTarget *target;
+  AdwAnimation *animation;
+
+  if (target_kind == TARGET_CALLBACK)
+    target = adw_callback_animation_target_new (value_cb, sink, NULL);
+  else
+    target = adw_property_animation_target_new (object, "value");
+
+  /* Both last for longer than the measured frames */
+  if (kind == KIND_TIMED) {
+    animation = g_object_new (ADW_TYPE_TIMED_ANIMATION,
+                              "value-from", 0.0,
+                              "value-to", 1.0,
+                              "duration", 10000,
+                              "target", target,
+                              NULL);
+  } else {
+    AdwSpringParams *params = adw_spring_params_new (0.1, 1, 100);
+
+    animation = g_object_new (ADW_TYPE_SPRING_ANIMATION,
+                              "value-from", 0.0,
+                              "value-to", 1.0,
+                              "spring-params", params,
+                              "target", target,
+                              NULL);
+
+    adw_spring_params_unref (params);
+  }
+
+  g_object_unref (target);
+
+  return animation;
+}
+
+static double
+run (GObject       *object,
+     AnimationKind  kind,
+     TargetKind     target_kind,
+     guint          n_animations)
+{
+  BenchmarkEntry *entries = g_new (BenchmarkEntry, n_animations);
+  double sink = 0;
+  gint64 start;
+  guint i;
+
+  adw_animation_scheduler_start_override ();
+
+  for (i = 0; i < n_animations; i++) {
+    entries[i].animation = create_animation (object, kind, target_kind, &sink);
+    entries[i].start_time = adw_animation_scheduler_get_frame_time (NULL);
+    entries[i].entry =
+      adw_animation_scheduler_add (NULL,
+                                   (AdwAnimationSchedulerFunc) tick_cb,
+                                   &entries[i]);
+  }
+
+  for (i = 0; i < N_WARMUP_FRAMES; i++)
+    adw_animation_scheduler_override_step (REFRESH_RATE);
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < N_FRAMES; i++)
+    adw_animation_scheduler_override_step (REFRESH_RATE);
+
+  start = g_get_monotonic_time () - start;
+
+  g_assert_cmpuint (adw_animation_scheduler_get_n_entries (NULL), ==, n_animations);
+
+  for (i = 0; i < n_animations; i++) {
+    adw_animation_scheduler_remove (entries[i].entry);
+    g_object_unref (entries[i].animation);
+  }
+
+  adw_animation_scheduler_end_override ();
+
+  g_free (entries);
+
+  return start * 1000.0 / N_FRAMES;
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  const char *kind_names[] = { "timed", "spring" };
+  const char *target_names[] = { "callback", "property" };
+  guint n_animations[] = { 1, 100, 10000 };
+  GtkAdjustment *adjustment;
+  guint i, j, k;
+
+  /* Any object with a double property works for the property target, and
+   * unlike a widget an adjustment doesn't need GTK to be initialized */
+  adjustment = g_object_ref_sink (gtk_adjustment_new (0, -1, 2, 0, 0, 0));
+
+  g_print ("%-8s %-10s %12s %16s %20s\n",
+           "kind", "target", "animations", "ns per tick", "ns per animation");
+
+  for (i = 0; i < G_N_ELEMENTS (kind_names); i++) {
+    for (j = 0; j < G_N_ELEMENTS (target_names); j++) {
+      for (k = 0; k < G_N_ELEMENTS (n_animations); k++) {
+        double ns = run (G_OBJECT (adjustment), i, j, n_animations[k]);
+
+        g_print ("%-8s %-10s %12u %16.0f %20.2f\n",
+                 kind_names[i], target_names[j], n_animations[k],
+                 ns, ns / n_animations[k]);
+      }
+    }
+  }
+
+  g_object_unref (adjustment);
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#define N_VALUES 1024
+#define N_ROUNDS 2000
+
+static double
+run_scalar (AdwEasing     easing,
+            const double *values,
+            double       *results)
+{
+  gint64 start = g_get_monotonic_time ();
+  guint i, j;
+
+  for (i = 0; i < N_ROUNDS; i++)
+    for (j = 0; j < N_VALUES; j++)
+      results[j] = adw_easing_ease (easing, values[j]);
+
+  return (g_get_monotonic_time () - start) * 1000.0 / (N_ROUNDS * N_VALUES);
+}
+
+static double
+run_batch (AdwEasing     easing,
+           const double *values,
+           double       *results)
+{
+  gint64 start = g_get_monotonic_time ();
+  guint i;
+
+  for (i = 0; i < N_ROUNDS; i++)
+    adw_easing_ease_n (easing, values, results, N_VALUES);
+
+  return (g_get_monotonic_time () - start) * 1000.0 / (N_ROUNDS * N_VALUES);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GEnumClass *enum_class;
+  double values[N_VALUES], results[N_VALUES];
+  guint i;
+
+  for (i = 0; i < N_VALUES; i++)
+    values[i] = (double) i / (N_VALUES - 1);
+
+  enum_class = g_type_class_ref (ADW_TYPE_EASING);
+
+  g_print ("%-24s %12s %12s %8s\n", "easing", "scalar (ns)", "batch (ns)", "speedup");
+
+  for (i = 0; i < enum_class->n_values; i++) {
+    GEnumValue *value = &enum_class->values[i];
+    double scalar = run_scalar (value->value, values, results);
+    double batch = run_batch (value->value, values, results);
+
+    g_print ("%-24s %12.2f %12.2f %7.2fx\n",
+             value->value_nick, scalar, batch, scalar / MAX (batch, 0.01));
+  }
+
+  g_type_class_unref (enum_class);
+
+  return 0;
+}
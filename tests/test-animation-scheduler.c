@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+#include "adw-animation-scheduler-private.h"
+
+/* The virtual clock doesn't need a frame clock, so unlike the other tests this
+ * one doesn't need a display either */
+
+typedef struct _TestEntry TestEntry;
+
+struct _TestEntry {
+  AdwAnimationSchedulerEntry *entry;
+  int n_calls;
+  gint64 frame_time;
+
+  /* Removed when this entry is called */
+  AdwAnimationSchedulerEntry *remove;
+  gboolean remove_self;
+  /* Added when this entry is called */
+  TestEntry *add;
+};
+
+static void
+entry_cb (gint64   frame_time,
+          gpointer user_data)
+{
+  TestEntry *data = user_data;
+
+  data->n_calls++;
+  data->frame_time = frame_time;
+
+  if (data->remove) {
+    adw_animation_scheduler_remove (data->remove);
+    data->remove = NULL;
+  }
+
+  if (data->add) {
+    TestEntry *add = data->add;
+
+    add->entry = adw_animation_scheduler_add (NULL, entry_cb, add);
+    data->add = NULL;
+  }
+
+  if (data->remove_self) {
+    adw_animation_scheduler_remove (data->entry);
+    data->entry = NULL;
+    data->remove_self = FALSE;
+  }
+}
+
+static void
+test_adw_animation_scheduler_override (void)
+{
+  TestEntry a = { 0 }, b = { 0 };
+
+  g_assert_false (adw_animation_scheduler_get_overridden ());
+
+  adw_animation_scheduler_start_override ();
+
+  g_assert_true (adw_animation_scheduler_get_overridden ());
+  g_assert_cmpint (adw_animation_scheduler_get_frame_time (NULL), ==, 0);
+  g_assert_cmpint (adw_animation_scheduler_get_n_entries (NULL), ==, 0);
+
+  a.entry = adw_animation_scheduler_add (NULL, entry_cb, &a);
+  b.entry = adw_animation_scheduler_add (NULL, entry_cb, &b);
+  g_assert_cmpint (adw_animation_scheduler_get_n_entries (NULL), ==, 2);
+
+  /* The virtual clock advances by one frame at the given refresh rate */
+  g_assert_cmpint (adw_animation_scheduler_override_step (100), ==, 10000);
+  g_assert_cmpint (adw_animation_scheduler_get_frame_time (NULL), ==, 10000);
+  g_assert_cmpint (a.n_calls, ==, 1);
+  g_assert_cmpint (a.frame_time, ==, 10000);
+  g_assert_cmpint (b.n_calls, ==, 1);
+  g_assert_cmpint (b.frame_time, ==, 10000);
+
+  g_assert_cmpint (adw_animation_scheduler_override_step (50), ==, 30000);
+  g_assert_cmpint (a.n_calls, ==, 2);
+  g_assert_cmpint (b.frame_time, ==, 30000);
+
+  adw_animation_scheduler_remove (a.entry);
+  g_assert_cmpint (adw_animation_scheduler_get_n_entries (NULL), ==, 1);
+
+  adw_animation_scheduler_override_step (100);
+  g_assert_cmpint (a.n_calls, ==, 2);
+  g_assert_cmpint (b.n_calls, ==, 3);
+
+  adw_animation_scheduler_remove (b.entry);
+  g_assert_cmpint (adw_animation_scheduler_get_n_entries (NULL), ==, 0);
+
+  adw_animation_scheduler_end_override ();
+
+  g_assert_false (adw_animation_scheduler_get_overridden ());
+}
+
+static void
+test_adw_animation_scheduler_reentrancy (void)
+{
+  TestEntry a = { 0 }, b = { 0 }, c = { 0 }, d = { 0 };
+
+  adw_animation_scheduler_start_override ();
+
+  a.entry = adw_animation_scheduler_add (NULL, entry_cb, &a);
+  b.entry = adw_animation_scheduler_add (NULL, entry_cb, &b);
+  c.entry = adw_animation_scheduler_add (NULL, entry_cb, &c);
+
+  /* a removes c before it's called, and b adds d and removes itself. d must
+   * only be called starting from the next frame */
+  a.remove = c.entry;
+  b.remove_self = TRUE;
+  b.add = &d;
+
+  adw_animation_scheduler_override_step (60);
+
+  g_assert_cmpint (a.n_calls, ==, 1);
+  g_assert_cmpint (b.n_calls, ==, 1);
+  g_assert_cmpint (c.n_calls, ==, 0);
+  g_assert_cmpint (d.n_calls, ==, 0);
+  g_assert_null (b.entry);
+  g_assert_nonnull (d.entry);
+  g_assert_cmpint (adw_animation_scheduler_get_n_entries (NULL), ==, 2);
+
+  adw_animation_scheduler_override_step (60);
+
+  g_assert_cmpint (a.n_calls, ==, 2);
+  g_assert_cmpint (b.n_calls, ==, 1);
+  g_assert_cmpint (d.n_calls, ==, 1);
+
+  adw_animation_scheduler_remove (a.entry);
+  adw_animation_scheduler_remove (d.entry);
+
+  adw_animation_scheduler_end_override ();
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func("/Adwaita/AnimationScheduler/override", test_adw_animation_scheduler_override);
+  g_test_add_func("/Adwaita/AnimationScheduler/reentrancy", test_adw_animation_scheduler_reentrancy);
+
+  return g_test_run();
+}
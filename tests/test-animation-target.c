@@ -55,6 +55,52 @@ test_adw_property_animation_target_basic (void)
   g_assert_finalize_object (widget);
 }
 
+static void
+test_adw_property_animation_target_types (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_scale_new (GTK_ORIENTATION_HORIZONTAL, NULL));
+  AdwAnimationTarget *int_target =
+    adw_property_animation_target_new (G_OBJECT (widget), "margin-start");
+  AdwAnimationTarget *double_target =
+    adw_property_animation_target_new (G_OBJECT (widget), "fill-level");
+  AdwAnimation *int_animation =
+    adw_timed_animation_new (widget, 0, 10, 100, g_object_ref (int_target));
+  AdwAnimation *double_animation =
+    adw_timed_animation_new (widget, 0, 5, 100, g_object_ref (double_target));
+  AdwAnimationTarget *object_target;
+
+  adw_animation_play (int_animation);
+  adw_animation_play (double_animation);
+
+  /* Since the widget is not mapped, the animations will immediately finish */
+  g_assert_cmpint (gtk_widget_get_margin_start (widget), ==, 10);
+  g_assert_true (G_APPROX_VALUE (gtk_range_get_fill_level (GTK_RANGE (widget)), 5, DBL_EPSILON));
+
+  adw_animation_reset (int_animation);
+  adw_animation_reset (double_animation);
+
+  g_assert_cmpint (gtk_widget_get_margin_start (widget), ==, 0);
+  g_assert_true (G_APPROX_VALUE (gtk_range_get_fill_level (GTK_RANGE (widget)), 0, DBL_EPSILON));
+
+  /* Values set by the target must not be skipped after the property was
+   * changed from elsewhere */
+  gtk_widget_set_margin_start (widget, 3);
+  adw_animation_reset (int_animation);
+  g_assert_cmpint (gtk_widget_get_margin_start (widget), ==, 0);
+
+  /* Properties that can't be converted from double are rejected upfront */
+  g_test_expect_message (ADW_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "Cannot animate GtkWidget:layout-manager*");
+  object_target = adw_property_animation_target_new (G_OBJECT (widget), "layout-manager");
+  g_test_assert_expected_messages ();
+
+  g_assert_finalize_object (object_target);
+  g_assert_finalize_object (int_animation);
+  g_assert_finalize_object (double_animation);
+  g_assert_finalize_object (int_target);
+  g_assert_finalize_object (double_target);
+  g_assert_finalize_object (widget);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -66,6 +112,8 @@ main (int   argc,
                   test_adw_property_animation_target_construct);
   g_test_add_func("/Adwaita/PropertyAnimationTarget/basic",
                   test_adw_property_animation_target_basic);
+  g_test_add_func("/Adwaita/PropertyAnimationTarget/types",
+                  test_adw_property_animation_target_types);
 
   return g_test_run();
 }
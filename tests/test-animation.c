@@ -7,6 +7,7 @@
  */
 
 #include <adwaita.h>
+#include "adw-animation-scheduler-private.h"
 
 static double last_value;
 static int done_count;
@@ -24,6 +25,14 @@ done_cb (gpointer user_data)
   done_count++;
 }
 
+static void
+notify_cb (GObject    *object,
+           GParamSpec *pspec,
+           int        *count)
+{
+  (*count)++;
+}
+
 static void
 test_adw_animation_general (void)
 {
@@ -83,6 +92,132 @@ test_adw_animation_general (void)
   g_assert_cmpint (done_count, ==, 2);
 }
 
+static void
+test_adw_animation_quiet (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwAnimation *animation =
+    adw_timed_animation_new (widget, 10, 20, 100,
+                             adw_callback_animation_target_new (value_cb, NULL, NULL));
+  int notified = 0, value_notified = 0;
+
+  g_signal_connect (animation, "notify::quiet", G_CALLBACK (notify_cb), &notified);
+  g_signal_connect (animation, "notify::value", G_CALLBACK (notify_cb), &value_notified);
+
+  g_assert_false (adw_animation_get_quiet (animation));
+
+  adw_animation_set_quiet (animation, TRUE);
+  g_assert_true (adw_animation_get_quiet (animation));
+  g_assert_cmpint (notified, ==, 1);
+
+  adw_animation_set_quiet (animation, TRUE);
+  g_assert_cmpint (notified, ==, 1);
+
+  last_value = 0;
+
+  adw_animation_play (animation);
+
+  /* The target still receives values, but the property isn't notified */
+  g_assert_true (G_APPROX_VALUE (adw_animation_get_value (animation), 20, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (last_value, 20, DBL_EPSILON));
+  g_assert_cmpint (value_notified, ==, 0);
+
+  adw_animation_set_quiet (animation, FALSE);
+  g_assert_cmpint (notified, ==, 2);
+
+  adw_animation_reset (animation);
+  g_assert_cmpint (value_notified, ==, 1);
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (widget);
+}
+
+static void
+test_adw_animation_frame_rate (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwAnimation *animation =
+    adw_timed_animation_new (widget, 10, 20, 100,
+                             adw_callback_animation_target_new (value_cb, NULL, NULL));
+  int notified = 0;
+
+  g_signal_connect (animation, "notify::max-frame-rate", G_CALLBACK (notify_cb), &notified);
+  g_signal_connect (animation, "notify::essential", G_CALLBACK (notify_cb), &notified);
+
+  g_assert_cmpuint (adw_animation_get_max_frame_rate (animation), ==, 0);
+  g_assert_false (adw_animation_get_essential (animation));
+
+  adw_animation_set_max_frame_rate (animation, 30);
+  g_assert_cmpuint (adw_animation_get_max_frame_rate (animation), ==, 30);
+  g_assert_cmpint (notified, ==, 1);
+
+  adw_animation_set_max_frame_rate (animation, 30);
+  g_assert_cmpint (notified, ==, 1);
+
+  adw_animation_set_essential (animation, TRUE);
+  g_assert_true (adw_animation_get_essential (animation));
+  g_assert_cmpint (notified, ==, 2);
+
+  /* A frame rate limit doesn't prevent the animation from finishing */
+  last_value = 0;
+  adw_animation_play (animation);
+
+  g_assert_cmpint (adw_animation_get_state (animation), ==, ADW_ANIMATION_FINISHED);
+  g_assert_true (G_APPROX_VALUE (last_value, 20, DBL_EPSILON));
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (widget);
+}
+
+static void
+test_adw_animation_virtual_clock (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwAnimation *animation =
+    adw_timed_animation_new (widget, 10, 20, 100,
+                             adw_callback_animation_target_new (value_cb, NULL, NULL));
+  int i;
+
+  adw_timed_animation_set_easing (ADW_TIMED_ANIMATION (animation), ADW_LINEAR);
+
+  last_value = 0;
+  done_count = 0;
+
+  g_signal_connect (animation, "done", G_CALLBACK (done_cb), NULL);
+
+  adw_animation_scheduler_start_override ();
+
+  /* The widget is not mapped, but the virtual clock drives it anyway */
+  adw_animation_play (animation);
+  g_assert_cmpint (adw_animation_get_state (animation), ==, ADW_ANIMATION_PLAYING);
+
+  for (i = 0; i < 5; i++)
+    adw_animation_scheduler_override_step (100);
+
+  g_assert_cmpint (adw_animation_get_state (animation), ==, ADW_ANIMATION_PLAYING);
+  g_assert_true (G_APPROX_VALUE (last_value, 15, 0.0001));
+  g_assert_cmpint (done_count, ==, 0);
+
+  /* Limiting the frame rate skips every other frame */
+  adw_animation_set_max_frame_rate (animation, 50);
+  adw_animation_scheduler_override_step (100);
+  g_assert_true (G_APPROX_VALUE (last_value, 15, 0.0001));
+  adw_animation_scheduler_override_step (100);
+  g_assert_true (G_APPROX_VALUE (last_value, 17, 0.0001));
+
+  for (i = 0; i < 3; i++)
+    adw_animation_scheduler_override_step (100);
+
+  g_assert_cmpint (adw_animation_get_state (animation), ==, ADW_ANIMATION_FINISHED);
+  g_assert_true (G_APPROX_VALUE (last_value, 20, DBL_EPSILON));
+  g_assert_cmpint (done_count, ==, 1);
+
+  adw_animation_scheduler_end_override ();
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (widget);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -91,6 +226,9 @@ main (int   argc,
   adw_init ();
 
   g_test_add_func("/Adwaita/Animation/general", test_adw_animation_general);
+  g_test_add_func("/Adwaita/Animation/quiet", test_adw_animation_quiet);
+  g_test_add_func("/Adwaita/Animation/frame_rate", test_adw_animation_frame_rate);
+  g_test_add_func("/Adwaita/Animation/virtual_clock", test_adw_animation_virtual_clock);
 
   return g_test_run();
 }
@@ -8,6 +8,8 @@
 
 #include <adwaita.h>
 
+#include <math.h>
+
 static void
 test_easing_ease (gconstpointer data)
 {
@@ -17,6 +19,50 @@ test_easing_ease (gconstpointer data)
   g_assert_cmpfloat_with_epsilon (adw_easing_ease (easing, 1), 1, 0.005);
 }
 
+static void
+test_easing_ease_n (gconstpointer data)
+{
+  AdwEasing easing = GPOINTER_TO_INT (data);
+  double values[201], results[201];
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (values); i++)
+    values[i] = -0.5 + i / 100.0;
+
+  adw_easing_ease_n (easing, values, results, G_N_ELEMENTS (values));
+
+  for (i = 0; i < G_N_ELEMENTS (values); i++) {
+    double expected = adw_easing_ease (easing, values[i]);
+
+    if (isnan (expected))
+      g_assert_true (isnan (results[i]));
+    else
+      g_assert_cmpfloat_with_epsilon (results[i], expected, 1e-12);
+  }
+}
+
+static void
+test_easing_ease_n_in_place (gconstpointer data)
+{
+  AdwEasing easing = GPOINTER_TO_INT (data);
+  double values[201], results[201];
+  gsize i;
+
+  /* More than one chunk, with values below 0 and above 1 in both */
+  for (i = 0; i < G_N_ELEMENTS (values); i++)
+    values[i] = i % 2 ? -0.5 + i / 100.0 : 1.5 - i / 100.0;
+
+  adw_easing_ease_n (easing, values, results, G_N_ELEMENTS (values));
+  adw_easing_ease_n (easing, values, values, G_N_ELEMENTS (values));
+
+  for (i = 0; i < G_N_ELEMENTS (values); i++) {
+    if (isnan (results[i]))
+      g_assert_true (isnan (values[i]));
+    else
+      g_assert_cmpfloat_with_epsilon (values[i], results[i], 1e-12);
+  }
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -32,10 +78,16 @@ main (int   argc,
   for (i = 0; i < enum_class->n_values; i++) {
     GEnumValue *value = &enum_class->values[i];
     char *path = g_strdup_printf ("/Adwaita/Easing/%s", value->value_nick);
+    char *path_n = g_strdup_printf ("/Adwaita/Easing/%s/batch", value->value_nick);
+    char *path_in_place = g_strdup_printf ("/Adwaita/Easing/%s/batch_in_place", value->value_nick);
 
     g_test_add_data_func (path, GINT_TO_POINTER (value->value), test_easing_ease);
+    g_test_add_data_func (path_n, GINT_TO_POINTER (value->value), test_easing_ease_n);
+    g_test_add_data_func (path_in_place, GINT_TO_POINTER (value->value), test_easing_ease_n_in_place);
 
     g_free (path);
+    g_free (path_n);
+    g_free (path_in_place);
   }
 
   g_type_class_unref (enum_class);
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+#include "adw-animation-scheduler-private.h"
+
+static void
+value_cb (double   value,
+          gpointer user_data)
+{
+}
+
+static AdwSpringAnimation *
+create_animation (GtkWidget *widget,
+                  double     from,
+                  double     to,
+                  double     velocity,
+                  double     damping_ratio,
+                  gboolean   clamp)
+{
+  AdwAnimation *animation =
+    adw_spring_animation_new (widget, from, to,
+                              adw_spring_params_new (damping_ratio, 1, 100),
+                              adw_callback_animation_target_new (value_cb, NULL, NULL));
+
+  adw_spring_animation_set_initial_velocity (ADW_SPRING_ANIMATION (animation), velocity);
+  adw_spring_animation_set_clamp (ADW_SPRING_ANIMATION (animation), clamp);
+
+  return ADW_SPRING_ANIMATION (animation);
+}
+
+static guint
+scan_first_zero (AdwSpringAnimation *animation)
+{
+  double from = adw_spring_animation_get_value_from (animation);
+  double to = adw_spring_animation_get_value_to (animation);
+  double epsilon = adw_spring_animation_get_epsilon (animation);
+  guint i;
+
+  for (i = 1; i <= 20000; i++) {
+    double value = adw_spring_animation_calculate_value (animation, i);
+
+    if (from < to && to - value <= epsilon)
+      return i;
+
+    if (from > to && value - to <= epsilon)
+      return i;
+  }
+
+  return 0;
+}
+
+static void
+test_adw_spring_animation_clamp_duration (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  double damping_ratios[] = { 0.2, 0.5, 1, 2, 5 };
+  double velocities[] = { -2000, -50, 0, 50, 2000 };
+  gsize i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (damping_ratios); i++) {
+    for (j = 0; j < G_N_ELEMENTS (velocities); j++) {
+      AdwSpringAnimation *animation =
+        create_animation (widget, 0, 100, velocities[j], damping_ratios[i], TRUE);
+
+      g_assert_cmpuint (adw_spring_animation_get_estimated_duration (animation), ==,
+                        scan_first_zero (animation));
+
+      adw_spring_animation_set_value_from (animation, 150);
+      adw_spring_animation_set_value_to (animation, -50);
+
+      g_assert_cmpuint (adw_spring_animation_get_estimated_duration (animation), ==,
+                        scan_first_zero (animation));
+
+      g_assert_finalize_object (animation);
+    }
+  }
+
+  g_assert_finalize_object (widget);
+}
+
+static void
+test_adw_spring_animation_overdamped_duration (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  double velocities[] = { -2000, -50, 0, 50, 2000 };
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (velocities); i++) {
+    AdwSpringAnimation *animation =
+      create_animation (widget, 0, 100, velocities[i], 3, FALSE);
+    guint duration = adw_spring_animation_get_estimated_duration (animation);
+    double epsilon = adw_spring_animation_get_epsilon (animation);
+
+    g_assert_cmpuint (duration, >, 0);
+    g_assert_cmpfloat (ABS (adw_spring_animation_calculate_value (animation, duration) - 100), <=, epsilon);
+    g_assert_cmpfloat (ABS (adw_spring_animation_calculate_value (animation, duration - 1) - 100), >, epsilon);
+
+    g_assert_finalize_object (animation);
+  }
+
+  g_assert_finalize_object (widget);
+}
+
+static void
+test_adw_spring_animation_retarget (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwSpringAnimation *animation = create_animation (widget, 0, 100, 0, 3, FALSE);
+  guint duration = adw_spring_animation_get_estimated_duration (animation);
+
+  /* Same spring and the same normalized distance must give the same duration */
+  adw_spring_animation_set_epsilon (animation, 0.002);
+  adw_spring_animation_set_value_to (animation, 200);
+  g_assert_cmpuint (adw_spring_animation_get_estimated_duration (animation), ==, duration);
+
+  adw_spring_animation_set_value_to (animation, 100);
+  g_assert_cmpuint (adw_spring_animation_get_estimated_duration (animation), !=, duration);
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (widget);
+}
+
+static void
+notify_cb (GObject    *object,
+           GParamSpec *pspec,
+           int        *count)
+{
+  (*count)++;
+}
+
+static void
+test_adw_spring_animation_quiet_velocity (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwSpringAnimation *animation = create_animation (widget, 0, 100, 500, 0.5, FALSE);
+  int notified = 0;
+
+  g_signal_connect (animation, "notify::velocity", G_CALLBACK (notify_cb), &notified);
+
+  adw_animation_play (ADW_ANIMATION (animation));
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_true (G_APPROX_VALUE (adw_spring_animation_get_velocity (animation), 0, DBL_EPSILON));
+
+  adw_animation_set_quiet (ADW_ANIMATION (animation), TRUE);
+
+  /* Since the widget is not mapped, the animation will immediately finish,
+   * and the velocity is only computed when requested */
+  adw_animation_reset (ADW_ANIMATION (animation));
+  g_assert_true (G_APPROX_VALUE (adw_spring_animation_get_velocity (animation), 500, 1e-6));
+
+  adw_animation_play (ADW_ANIMATION (animation));
+  g_assert_true (G_APPROX_VALUE (adw_spring_animation_get_velocity (animation), 0, DBL_EPSILON));
+  g_assert_cmpint (notified, ==, 1);
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (widget);
+}
+
+static void
+test_adw_spring_animation_quiet_velocity_retarget (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwSpringAnimation *animation = create_animation (widget, 0, 100, 0, 0.5, FALSE);
+  AdwSpringAnimation *quiet_animation = create_animation (widget, 0, 100, 0, 0.5, FALSE);
+  AdwSpringParams *params;
+  int i;
+
+  adw_animation_set_quiet (ADW_ANIMATION (quiet_animation), TRUE);
+
+  adw_animation_scheduler_start_override ();
+
+  adw_animation_play (ADW_ANIMATION (animation));
+  adw_animation_play (ADW_ANIMATION (quiet_animation));
+
+  for (i = 0; i < 5; i++)
+    adw_animation_scheduler_override_step (60);
+
+  /* The velocity must still be the one of the spring that was running */
+  adw_spring_animation_set_value_to (animation, 300);
+  adw_spring_animation_set_value_to (quiet_animation, 300);
+  params = adw_spring_params_new (1, 1, 200);
+  adw_spring_animation_set_spring_params (quiet_animation, params);
+  adw_spring_params_unref (params);
+
+  g_assert_cmpfloat (ABS (adw_spring_animation_get_velocity (animation)), >, 0);
+  g_assert_cmpfloat_with_epsilon (adw_spring_animation_get_velocity (quiet_animation),
+                                  adw_spring_animation_get_velocity (animation),
+                                  1e-6);
+
+  adw_animation_skip (ADW_ANIMATION (animation));
+  adw_animation_skip (ADW_ANIMATION (quiet_animation));
+
+  adw_animation_scheduler_end_override ();
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (quiet_animation);
+  g_assert_finalize_object (widget);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func("/Adwaita/SpringAnimation/clamp_duration", test_adw_spring_animation_clamp_duration);
+  g_test_add_func("/Adwaita/SpringAnimation/overdamped_duration", test_adw_spring_animation_overdamped_duration);
+  g_test_add_func("/Adwaita/SpringAnimation/retarget", test_adw_spring_animation_retarget);
+  g_test_add_func("/Adwaita/SpringAnimation/quiet_velocity", test_adw_spring_animation_quiet_velocity);
+  g_test_add_func("/Adwaita/SpringAnimation/quiet_velocity_retarget", test_adw_spring_animation_quiet_velocity_retarget);
+
+  return g_test_run();
+}
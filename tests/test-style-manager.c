@@ -208,6 +208,39 @@ test_adw_style_manager_inheritance (void)
   adw_style_manager_set_color_scheme (default_manager, ADW_COLOR_SCHEME_DEFAULT);
 }
 
+static void
+test_adw_style_manager_animation_cost (void)
+{
+  AdwStyleManager *manager = adw_style_manager_get_default ();
+  guint frame_rate;
+  gboolean reduce_animation_cost;
+
+  notified = 0;
+  g_signal_connect (manager, "notify::max-animation-frame-rate", G_CALLBACK (notify_cb), NULL);
+  g_signal_connect (manager, "notify::reduce-animation-cost", G_CALLBACK (notify_cb), NULL);
+
+  g_object_get (manager, "max-animation-frame-rate", &frame_rate, NULL);
+  g_assert_cmpuint (frame_rate, ==, 0);
+
+  adw_style_manager_set_max_animation_frame_rate (manager, 30);
+  g_assert_cmpuint (adw_style_manager_get_max_animation_frame_rate (manager), ==, 30);
+  g_assert_cmpint (notified, ==, 1);
+
+  adw_style_manager_set_max_animation_frame_rate (manager, 30);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_get (manager, "reduce-animation-cost", &reduce_animation_cost, NULL);
+  g_assert_false (reduce_animation_cost);
+
+  g_object_set (manager, "reduce-animation-cost", TRUE, NULL);
+  g_assert_true (adw_style_manager_get_reduce_animation_cost (manager));
+  g_assert_cmpint (notified, ==, 2);
+
+  g_signal_handlers_disconnect_by_func (manager, G_CALLBACK (notify_cb), NULL);
+  adw_style_manager_set_max_animation_frame_rate (manager, 0);
+  adw_style_manager_set_reduce_animation_cost (manager, FALSE);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -220,6 +253,7 @@ main (int   argc,
   g_test_add_func("/Adwaita/StyleManager/high_contrast", test_adw_style_manager_high_contrast);
   g_test_add_func("/Adwaita/StyleManager/system_supports_color_schemes", test_adw_style_manager_system_supports_color_schemes);
   g_test_add_func("/Adwaita/StyleManager/inheritance", test_adw_style_manager_inheritance);
+  g_test_add_func("/Adwaita/StyleManager/animation_cost", test_adw_style_manager_animation_cost);
 
   return g_test_run();
 }
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+#include "adw-tab-search-filter-private.h"
+#include "adw-tab-search-index-private.h"
+
+static AdwTabPage *
+add_page (AdwTabView *view,
+          const char *title,
+          const char *keyword)
+{
+  AdwTabPage *page = adw_tab_view_append (view, gtk_button_new ());
+
+  adw_tab_page_set_title (page, title);
+  adw_tab_page_set_keyword (page, keyword);
+
+  return page;
+}
+
+static gboolean
+query_matches (AdwTabSearchIndex *index,
+               const char        *search,
+               guint              n_pages,
+               ...)
+{
+  GHashTable *result;
+  char *prepared = adw_tab_search_index_prepare (search);
+  gboolean ret;
+  va_list args;
+  guint i;
+
+  result = adw_tab_search_index_query (index, prepared);
+  ret = g_hash_table_size (result) == n_pages;
+
+  va_start (args, n_pages);
+
+  for (i = 0; i < n_pages; i++) {
+    AdwTabPage *page = va_arg (args, AdwTabPage *);
+
+    if (!g_hash_table_contains (result, page))
+      ret = FALSE;
+
+    g_assert_true (adw_tab_search_index_match (index, page, prepared) ==
+                   g_hash_table_contains (result, page));
+  }
+
+  va_end (args);
+
+  g_hash_table_unref (result);
+  g_free (prepared);
+
+  return ret;
+}
+
+static void
+test_adw_tab_search_index_query (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabSearchIndex *index = adw_tab_search_index_new ();
+  AdwTabPage *pages[3];
+  int i;
+
+  pages[0] = add_page (view, "GNOME", "https://gnome.org");
+  pages[1] = add_page (view, "Example", "https://example.com");
+  pages[2] = add_page (view, "Straße", NULL);
+
+  for (i = 0; i < 3; i++)
+    adw_tab_search_index_add_page (index, pages[i]);
+
+  g_assert_true (query_matches (index, "gnome", 1, pages[0]));
+  g_assert_true (query_matches (index, "EXAMPLE", 1, pages[1]));
+  g_assert_true (query_matches (index, "https://", 2, pages[0], pages[1]));
+  g_assert_true (query_matches (index, "e", 3, pages[0], pages[1], pages[2]));
+  g_assert_true (query_matches (index, ".o", 1, pages[0]));
+  g_assert_true (query_matches (index, "strasse", 1, pages[2]));
+  g_assert_true (query_matches (index, "gnomes", 0));
+
+  adw_tab_page_set_title (pages[2], "GNOME Shell");
+  g_assert_true (query_matches (index, "gnome", 2, pages[0], pages[2]));
+  g_assert_true (query_matches (index, "strasse", 0));
+
+  adw_tab_search_index_remove_page (index, pages[0]);
+  g_assert_true (query_matches (index, "gnome", 1, pages[2]));
+
+  g_assert_finalize_object (index);
+  g_assert_finalize_object (view);
+}
+
+static void
+changed_cb (GtkFilter       *filter,
+            GtkFilterChange  change,
+            GtkFilterChange *last_change)
+{
+  *last_change = change;
+}
+
+static void
+page_match_changed_cb (GtkFilter   *filter,
+                       AdwTabPage  *page,
+                       AdwTabPage **last_page)
+{
+  *last_page = page;
+}
+
+static void
+test_adw_tab_search_filter_changes (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  GtkFilter *filter = adw_tab_search_filter_new ();
+  AdwTabSearchFilter *search_filter = ADW_TAB_SEARCH_FILTER (filter);
+  GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+  AdwTabSearchIndex *index = adw_tab_search_index_new ();
+  AdwTabPage *pages[2];
+  AdwTabPage *changed_page = NULL;
+
+  pages[0] = add_page (view, "GNOME", "https://gnome.org");
+  pages[1] = add_page (view, "Example", "https://example.com");
+
+  adw_tab_search_index_add_page (index, pages[0]);
+  adw_tab_search_index_add_page (index, pages[1]);
+
+  adw_tab_search_filter_set_index (search_filter, index);
+  g_signal_connect (filter, "changed", G_CALLBACK (changed_cb), &change);
+  g_signal_connect (filter, "page-match-changed", G_CALLBACK (page_match_changed_cb), &changed_page);
+
+  g_assert_cmpint (gtk_filter_get_strictness (filter), ==, GTK_FILTER_MATCH_ALL);
+
+  adw_tab_search_filter_set_search (search_filter, "o");
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_true (gtk_filter_match (filter, pages[0]));
+  g_assert_true (gtk_filter_match (filter, pages[1]));
+
+  adw_tab_search_filter_set_search (search_filter, "gno");
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_true (gtk_filter_match (filter, pages[0]));
+  g_assert_false (gtk_filter_match (filter, pages[1]));
+
+  adw_tab_search_filter_set_search (search_filter, "gn");
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_LESS_STRICT);
+  g_assert_true (gtk_filter_match (filter, pages[0]));
+  g_assert_false (gtk_filter_match (filter, pages[1]));
+
+  adw_tab_search_filter_set_search (search_filter, "exa");
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_DIFFERENT);
+  g_assert_false (gtk_filter_match (filter, pages[0]));
+  g_assert_true (gtk_filter_match (filter, pages[1]));
+
+  /* Only the page is reported, without rechecking all of them */
+  change = GTK_FILTER_CHANGE_MORE_STRICT;
+  adw_tab_page_set_title (pages[0], "Examples");
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_true (changed_page == pages[0]);
+  g_assert_true (gtk_filter_match (filter, pages[0]));
+
+  /* Still matches */
+  changed_page = NULL;
+  adw_tab_page_set_title (pages[0], "More examples");
+  g_assert_null (changed_page);
+
+  adw_tab_search_filter_set_search (search_filter, NULL);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_LESS_STRICT);
+  g_assert_cmpint (gtk_filter_get_strictness (filter), ==, GTK_FILTER_MATCH_ALL);
+  g_assert_true (gtk_filter_match (filter, pages[1]));
+
+  g_assert_finalize_object (filter);
+  g_assert_finalize_object (index);
+  g_assert_finalize_object (view);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Adwaita/TabSearchIndex/query", test_adw_tab_search_index_query);
+  g_test_add_func ("/Adwaita/TabSearchFilter/changes", test_adw_tab_search_filter_changes);
+
+  return g_test_run ();
+}
@@ -49,8 +49,13 @@ assert_page_positions (AdwTabView  *view,
   for (i = 0; i < n; i++) {
     int index = va_arg (args, int);
 
-    if (index >= 0)
+    if (index >= 0) {
+      GtkWidget *child = adw_tab_page_get_child (pages[index]);
+
       g_assert_cmpint (adw_tab_view_get_page_position (view, pages[index]), ==, i);
+      g_assert_true (adw_tab_view_get_nth_page (view, i) == pages[index]);
+      g_assert_true (adw_tab_view_get_page (view, child) == pages[index]);
+    }
   }
 
   va_end (args);
@@ -250,6 +255,32 @@ test_adw_tab_view_shortcuts (void)
   g_assert_finalize_object (view);
 }
 
+static void
+test_adw_tab_view_thumbnail_cache_size (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  guint64 size;
+
+  g_assert_nonnull (view);
+
+  notified = 0;
+  g_signal_connect (view, "notify::thumbnail-cache-size", G_CALLBACK (notify_cb), NULL);
+
+  g_object_get (view, "thumbnail-cache-size", &size, NULL);
+  g_assert_cmpuint (size, ==, 128 * 1024 * 1024);
+  g_assert_cmpint (notified, ==, 0);
+
+  adw_tab_view_set_thumbnail_cache_size (view, 1024);
+  g_assert_cmpuint (adw_tab_view_get_thumbnail_cache_size (view), ==, 1024);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (view, "thumbnail-cache-size", (guint64) 0, NULL);
+  g_assert_cmpuint (adw_tab_view_get_thumbnail_cache_size (view), ==, 0);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (view);
+}
+
 static void
 test_adw_tab_view_get_page (void)
 {
@@ -932,6 +963,422 @@ test_adw_tab_view_transfer (void)
   g_assert_finalize_object (view2);
 }
 
+static GtkWidget *
+create_child_cb (AdwTabPage *page,
+                 int        *n_created)
+{
+  (*n_created)++;
+
+  return gtk_button_new ();
+}
+
+static void
+test_adw_tab_view_add_lazy (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabPage *pages[3];
+  GtkWidget *child;
+  int n_created = 0;
+
+  g_assert_nonnull (view);
+
+  pages[0] = adw_tab_view_append_lazy (view, (AdwTabPageFactoryFunc) create_child_cb, &n_created, NULL);
+  pages[1] = adw_tab_view_append_lazy (view, (AdwTabPageFactoryFunc) create_child_cb, &n_created, NULL);
+  pages[2] = adw_tab_view_insert_lazy (view, 1, (AdwTabPageFactoryFunc) create_child_cb, &n_created, NULL);
+
+  g_assert_cmpint (adw_tab_view_get_n_pages (view), ==, 3);
+  g_assert_true (adw_tab_view_get_nth_page (view, 1) == pages[2]);
+
+  /* The first page is selected right away, so it has to be created */
+  g_assert_true (adw_tab_view_get_selected_page (view) == pages[0]);
+  g_assert_cmpint (n_created, ==, 1);
+  g_assert_nonnull (adw_tab_page_get_child (pages[0]));
+  g_assert_null (adw_tab_page_get_child (pages[1]));
+  g_assert_null (adw_tab_page_get_child (pages[2]));
+
+  notified = 0;
+  g_signal_connect (pages[1], "notify::child", G_CALLBACK (notify_cb), NULL);
+
+  adw_tab_view_set_selected_page (view, pages[1]);
+  g_assert_cmpint (n_created, ==, 2);
+  g_assert_cmpint (notified, ==, 1);
+
+  child = adw_tab_page_get_child (pages[1]);
+  g_assert_nonnull (child);
+  g_assert_true (adw_tab_view_get_page (view, child) == pages[1]);
+
+  /* Selecting it again must not create another child */
+  adw_tab_view_set_selected_page (view, pages[0]);
+  adw_tab_view_set_selected_page (view, pages[1]);
+  g_assert_cmpint (n_created, ==, 2);
+  g_assert_true (adw_tab_page_get_child (pages[1]) == child);
+
+  adw_tab_view_close_page (view, pages[2]);
+  g_assert_cmpint (n_created, ==, 2);
+
+  g_assert_finalize_object (view);
+}
+
+static gboolean
+veto_cb (AdwTabView *view,
+         AdwTabPage *page,
+         AdwTabPage *vetoed_page)
+{
+  return page == vetoed_page;
+}
+
+static void
+test_adw_tab_view_hibernate (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabPage *pages[3];
+  guint n_hibernated, n_restored;
+  int n_created = 0;
+  int i;
+
+  g_assert_nonnull (view);
+
+  for (i = 0; i < 3; i++) {
+    pages[i] = adw_tab_view_append_lazy (view, (AdwTabPageFactoryFunc) create_child_cb, &n_created, NULL);
+    adw_tab_page_set_can_hibernate (pages[i], TRUE);
+  }
+
+  adw_tab_view_set_max_live_pages (view, 2);
+
+  for (i = 0; i < 3; i++)
+    adw_tab_view_set_selected_page (view, pages[i]);
+
+  g_assert_cmpint (n_created, ==, 3);
+
+  while (g_main_context_iteration (NULL, FALSE));
+
+  /* The least recently selected page goes first */
+  g_assert_true (adw_tab_page_get_hibernated (pages[0]));
+  g_assert_null (adw_tab_page_get_child (pages[0]));
+  g_assert_false (adw_tab_page_get_hibernated (pages[1]));
+  g_assert_false (adw_tab_page_get_hibernated (pages[2]));
+
+  adw_tab_view_set_selected_page (view, pages[0]);
+  g_assert_false (adw_tab_page_get_hibernated (pages[0]));
+  g_assert_nonnull (adw_tab_page_get_child (pages[0]));
+  g_assert_cmpint (n_created, ==, 4);
+
+  g_signal_connect (view, "hibernate-page", G_CALLBACK (veto_cb), pages[1]);
+
+  while (g_main_context_iteration (NULL, FALSE));
+
+  /* pages[1] is vetoed, so pages[2] is hibernated instead */
+  g_assert_false (adw_tab_page_get_hibernated (pages[1]));
+  g_assert_true (adw_tab_page_get_hibernated (pages[2]));
+
+  adw_tab_view_get_hibernation_counts (view, &n_hibernated, &n_restored);
+  g_assert_cmpuint (n_hibernated, ==, 2);
+  g_assert_cmpuint (n_restored, ==, 1);
+
+  g_assert_finalize_object (view);
+}
+
+static gboolean
+page_is_mapped (AdwTabPage *page)
+{
+  GtkWidget *bin = gtk_widget_get_parent (adw_tab_page_get_child (page));
+
+  return gtk_widget_get_child_visible (bin);
+}
+
+static void
+test_adw_tab_view_warm_pages (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabPage *pages[4];
+  int i;
+
+  g_assert_nonnull (view);
+
+  notified = 0;
+  g_signal_connect (view, "notify::max-warm-pages", G_CALLBACK (notify_cb), NULL);
+
+  add_pages (view, pages, 4, 0);
+
+  g_assert_cmpint (adw_tab_view_get_max_warm_pages (view), ==, 0);
+
+  adw_tab_view_set_max_warm_pages (view, 2);
+  g_assert_cmpint (adw_tab_view_get_max_warm_pages (view), ==, 2);
+  g_assert_cmpint (notified, ==, 1);
+
+  for (i = 0; i < 4; i++)
+    adw_tab_view_set_selected_page (view, pages[i]);
+
+  g_assert_false (page_is_mapped (pages[0]));
+  g_assert_true (page_is_mapped (pages[1]));
+  g_assert_true (page_is_mapped (pages[2]));
+  g_assert_true (page_is_mapped (pages[3]));
+
+  adw_tab_view_set_selected_page (view, pages[0]);
+  g_assert_true (page_is_mapped (pages[0]));
+  g_assert_false (page_is_mapped (pages[1]));
+  g_assert_true (page_is_mapped (pages[2]));
+  g_assert_true (page_is_mapped (pages[3]));
+
+  g_object_set (view, "max-warm-pages", 0, NULL);
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_true (page_is_mapped (pages[0]));
+  g_assert_false (page_is_mapped (pages[2]));
+  g_assert_false (page_is_mapped (pages[3]));
+
+  g_assert_finalize_object (view);
+}
+
+static void
+items_changed_cb (GListModel *model,
+                  guint       position,
+                  guint       removed,
+                  guint       added,
+                  guint      *change)
+{
+  change[0]++;
+  change[1] = position;
+  change[2] = removed;
+  change[3] = added;
+}
+
+static void
+assert_accessible_siblings (AdwTabView *view)
+{
+  GtkAccessible *accessible = gtk_accessible_get_first_accessible_child (GTK_ACCESSIBLE (view));
+  int i, n_pages = adw_tab_view_get_n_pages (view);
+
+  for (i = 0; i < n_pages; i++) {
+    GtkAccessible *next;
+
+    g_assert_true (accessible == GTK_ACCESSIBLE (adw_tab_view_get_nth_page (view, i)));
+
+    next = gtk_accessible_get_next_accessible_sibling (accessible);
+    g_object_unref (accessible);
+    accessible = next;
+  }
+
+  g_assert_null (accessible);
+}
+
+static void
+test_adw_tab_view_accessible_siblings (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabPage *pages[6];
+
+  g_assert_nonnull (view);
+
+  assert_accessible_siblings (view);
+
+  add_pages (view, pages, 6, 2);
+  assert_accessible_siblings (view);
+
+  adw_tab_view_reorder_last (view, pages[2]);
+  assert_accessible_siblings (view);
+
+  adw_tab_view_set_page_pinned (view, pages[3], TRUE);
+  assert_accessible_siblings (view);
+
+  adw_tab_view_close_page (view, pages[4]);
+  assert_accessible_siblings (view);
+
+  g_assert_finalize_object (view);
+}
+
+static void
+test_adw_tab_view_batch (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  GtkSelectionModel *model;
+  AdwTabPage *pages[8];
+  AdwTabPage *closed[4];
+  GtkWidget *children[4];
+  guint change[4] = { 0 };
+  int i;
+
+  g_assert_nonnull (view);
+
+  add_pages (view, pages, 4, 1);
+
+  model = adw_tab_view_get_pages (view);
+  g_signal_connect (model, "items-changed", G_CALLBACK (items_changed_cb), change);
+
+  notified = 0;
+  g_signal_connect (view, "notify::n-pages", G_CALLBACK (notify_cb), NULL);
+
+  for (i = 0; i < 4; i++)
+    children[i] = gtk_button_new ();
+
+  adw_tab_view_insert_pages (view, children, 4, 2);
+
+  for (i = 0; i < 4; i++)
+    pages[i + 4] = adw_tab_view_get_page (view, children[i]);
+
+  assert_page_positions (view, pages, 8, 1,
+                         0, 1, 4, 5, 6, 7, 2, 3);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpuint (change[0], ==, 1);
+  g_assert_cmpuint (change[1], ==, 2);
+  g_assert_cmpuint (change[2], ==, 0);
+  g_assert_cmpuint (change[3], ==, 4);
+
+  /* Pages 1, 4 and 5 are adjacent, page 3 is separate */
+  closed[0] = pages[4];
+  closed[1] = pages[3];
+  closed[2] = pages[1];
+  closed[3] = pages[5];
+
+  notified = 0;
+  change[0] = 0;
+  adw_tab_view_close_pages (view, closed, 4);
+  assert_page_positions (view, pages, 4, 1,
+                         0, 6, 7, 2);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpuint (change[0], ==, 2);
+  g_assert_cmpuint (change[1], ==, 1);
+  g_assert_cmpuint (change[2], ==, 3);
+  g_assert_cmpuint (change[3], ==, 0);
+
+  change[0] = 0;
+  g_assert_true (adw_tab_view_reorder_pages (view, 1, 2, 2));
+  assert_page_positions (view, pages, 4, 1,
+                         0, 2, 6, 7);
+  g_assert_cmpuint (change[0], ==, 1);
+  g_assert_cmpuint (change[1], ==, 1);
+  g_assert_cmpuint (change[2], ==, 3);
+  g_assert_cmpuint (change[3], ==, 3);
+
+  g_assert_true (adw_tab_view_reorder_pages (view, 2, 2, 1));
+  assert_page_positions (view, pages, 4, 1,
+                         0, 6, 7, 2);
+  g_assert_cmpuint (change[0], ==, 2);
+
+  g_assert_false (adw_tab_view_reorder_pages (view, 1, 3, 1));
+  g_assert_cmpuint (change[0], ==, 2);
+
+  g_assert_finalize_object (view);
+  g_assert_finalize_object (model);
+}
+
+static void
+destroy_cb (int *n_destroyed)
+{
+  (*n_destroyed)++;
+}
+
+static void
+test_adw_tab_view_save_restore_state (void)
+{
+  AdwTabView *view1 = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabView *view2 = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabView *view3 = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  GtkSelectionModel *model;
+  AdwTabPage *pages[3];
+  AdwTabPage *page;
+  GVariant *state1, *state2, *invalid;
+  GdkTexture *texture;
+  GBytes *bytes;
+  GIcon *icon;
+  guchar pixels[16];
+  guint change[4] = { 0 };
+  int n_created = 0, n_destroyed = 0;
+
+  add_pages (view1, pages, 3, 1);
+
+  icon = g_themed_icon_new ("go-home-symbolic");
+
+  memset (pixels, 0xff, sizeof (pixels));
+  bytes = g_bytes_new (pixels, sizeof (pixels));
+  texture = gdk_memory_texture_new (2, 2, GDK_MEMORY_DEFAULT, bytes, 8);
+
+  adw_tab_page_set_title (pages[0], "Pinned");
+  adw_tab_page_set_title (pages[1], "Title");
+  adw_tab_page_set_tooltip (pages[1], "Tooltip");
+  adw_tab_page_set_keyword (pages[1], "https://gnome.org");
+  adw_tab_page_set_icon (pages[1], icon);
+  adw_tab_page_set_thumbnail (pages[1], texture);
+  adw_tab_page_set_indicator_icon (pages[2], icon);
+  adw_tab_page_set_indicator_tooltip (pages[2], "Indicator");
+  adw_tab_page_set_indicator_activatable (pages[2], TRUE);
+  adw_tab_page_set_thumbnail_xalign (pages[2], 0.5);
+  adw_tab_page_set_thumbnail_yalign (pages[2], 1);
+  adw_tab_view_set_selected_page (view1, pages[2]);
+
+  state1 = adw_tab_view_save_state (view1, ADW_TAB_VIEW_STATE_THUMBNAILS);
+  g_assert_nonnull (state1);
+
+  model = adw_tab_view_get_pages (view2);
+  g_signal_connect (model, "items-changed", G_CALLBACK (items_changed_cb), change);
+
+  notified = 0;
+  g_signal_connect (view2, "notify::n-pages", G_CALLBACK (notify_cb), NULL);
+
+  g_assert_true (adw_tab_view_restore_state (view2, state1,
+                                             (AdwTabPageFactoryFunc) create_child_cb,
+                                             &n_created, NULL));
+
+  g_assert_cmpint (adw_tab_view_get_n_pages (view2), ==, 3);
+  g_assert_cmpint (adw_tab_view_get_n_pinned_pages (view2), ==, 1);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpuint (change[0], ==, 1);
+  g_assert_cmpuint (change[1], ==, 0);
+  g_assert_cmpuint (change[2], ==, 0);
+  g_assert_cmpuint (change[3], ==, 3);
+
+  /* Only the selected page has a child */
+  page = adw_tab_view_get_nth_page (view2, 2);
+  g_assert_true (adw_tab_view_get_selected_page (view2) == page);
+  g_assert_cmpint (n_created, ==, 1);
+  g_assert_nonnull (adw_tab_page_get_child (page));
+  g_assert_null (adw_tab_page_get_child (adw_tab_view_get_nth_page (view2, 0)));
+  g_assert_null (adw_tab_page_get_child (adw_tab_view_get_nth_page (view2, 1)));
+
+  g_assert_true (g_icon_equal (adw_tab_page_get_indicator_icon (page), icon));
+  g_assert_cmpstr (adw_tab_page_get_indicator_tooltip (page), ==, "Indicator");
+  g_assert_true (adw_tab_page_get_indicator_activatable (page));
+  g_assert_cmpfloat_with_epsilon (adw_tab_page_get_thumbnail_xalign (page), 0.5, FLT_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_tab_page_get_thumbnail_yalign (page), 1, FLT_EPSILON);
+
+  page = adw_tab_view_get_nth_page (view2, 1);
+  g_assert_false (adw_tab_page_get_pinned (page));
+  g_assert_cmpstr (adw_tab_page_get_title (page), ==, "Title");
+  g_assert_cmpstr (adw_tab_page_get_tooltip (page), ==, "Tooltip");
+  g_assert_cmpstr (adw_tab_page_get_keyword (page), ==, "https://gnome.org");
+  g_assert_true (g_icon_equal (adw_tab_page_get_icon (page), icon));
+
+  page = adw_tab_view_get_nth_page (view2, 0);
+  g_assert_true (adw_tab_page_get_pinned (page));
+  g_assert_cmpstr (adw_tab_page_get_title (page), ==, "Pinned");
+  g_assert_null (adw_tab_page_get_keyword (page));
+
+  /* Saving it again must produce the same state, including the thumbnail */
+  state2 = adw_tab_view_save_state (view2, ADW_TAB_VIEW_STATE_THUMBNAILS);
+  g_assert_true (g_variant_equal (state1, state2));
+
+  invalid = g_variant_ref_sink (g_variant_new ("(uv)", G_MAXUINT32,
+                                               g_variant_new_boolean (TRUE)));
+
+  g_assert_false (adw_tab_view_restore_state (view3, invalid,
+                                              (AdwTabPageFactoryFunc) create_child_cb,
+                                              &n_destroyed,
+                                              (GDestroyNotify) destroy_cb));
+  g_assert_cmpint (n_destroyed, ==, 1);
+  g_assert_cmpint (adw_tab_view_get_n_pages (view3), ==, 0);
+
+  g_variant_unref (invalid);
+  g_variant_unref (state2);
+  g_variant_unref (state1);
+  g_object_unref (texture);
+  g_bytes_unref (bytes);
+  g_object_unref (icon);
+
+  g_assert_finalize_object (view1);
+  g_assert_finalize_object (view2);
+  g_assert_finalize_object (view3);
+  g_assert_finalize_object (model);
+}
+
 static void
 test_adw_tab_view_pages (void)
 {
@@ -1340,6 +1787,42 @@ test_adw_tab_page_live_thumbnail (void)
   g_assert_finalize_object (view);
 }
 
+static void
+test_adw_tab_page_freeze_updates (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabPage *page;
+
+  g_assert_nonnull (view);
+
+  page = adw_tab_view_append (view, gtk_button_new ());
+  g_assert_nonnull (page);
+
+  notified = 0;
+  g_signal_connect (page, "notify::title", G_CALLBACK (notify_cb), NULL);
+  g_signal_connect (page, "notify::loading", G_CALLBACK (notify_cb), NULL);
+
+  adw_tab_page_freeze_updates (page);
+  adw_tab_page_set_title (page, "Loading");
+  adw_tab_page_set_loading (page, TRUE);
+
+  adw_tab_page_freeze_updates (page);
+  adw_tab_page_set_title (page, "Title");
+  adw_tab_page_thaw_updates (page);
+
+  g_assert_cmpstr (adw_tab_page_get_title (page), ==, "Title");
+  g_assert_true (adw_tab_page_get_loading (page));
+  g_assert_cmpint (notified, ==, 0);
+
+  adw_tab_page_thaw_updates (page);
+  g_assert_cmpint (notified, ==, 2);
+
+  adw_tab_page_set_loading (page, FALSE);
+  g_assert_cmpint (notified, ==, 3);
+
+  g_assert_finalize_object (view);
+}
+
 static void
 test_adw_tab_view_pages_to_list_view_setup (GtkSignalListItemFactory *factory,
                                             GtkListItem              *list_item,
@@ -1420,6 +1903,7 @@ main (int   argc,
   g_test_add_func ("/Adwaita/TabView/default_icon", test_adw_tab_view_default_icon);
   g_test_add_func ("/Adwaita/TabView/menu_model", test_adw_tab_view_menu_model);
   g_test_add_func ("/Adwaita/TabView/shortcuts", test_adw_tab_view_shortcuts);
+  g_test_add_func ("/Adwaita/TabView/thumbnail_cache_size", test_adw_tab_view_thumbnail_cache_size);
   g_test_add_func ("/Adwaita/TabView/get_page", test_adw_tab_view_get_page);
   g_test_add_func ("/Adwaita/TabView/select", test_adw_tab_view_select);
   g_test_add_func ("/Adwaita/TabView/add_basic", test_adw_tab_view_add_basic);
@@ -1434,6 +1918,12 @@ main (int   argc,
   g_test_add_func ("/Adwaita/TabView/close_signal", test_adw_tab_view_close_signal);
   g_test_add_func ("/Adwaita/TabView/close_select", test_adw_tab_view_close_select);
   g_test_add_func ("/Adwaita/TabView/transfer", test_adw_tab_view_transfer);
+  g_test_add_func ("/Adwaita/TabView/add_lazy", test_adw_tab_view_add_lazy);
+  g_test_add_func ("/Adwaita/TabView/hibernate", test_adw_tab_view_hibernate);
+  g_test_add_func ("/Adwaita/TabView/warm_pages", test_adw_tab_view_warm_pages);
+  g_test_add_func ("/Adwaita/TabView/accessible_siblings", test_adw_tab_view_accessible_siblings);
+  g_test_add_func ("/Adwaita/TabView/batch", test_adw_tab_view_batch);
+  g_test_add_func ("/Adwaita/TabView/save_restore_state", test_adw_tab_view_save_restore_state);
   g_test_add_func ("/Adwaita/TabView/pages", test_adw_tab_view_pages);
   g_test_add_func ("/Adwaita/TabView/pages_to_list_view", test_adw_tab_view_pages_to_list_view);
   g_test_add_func ("/Adwaita/TabPage/title", test_adw_tab_page_title);
@@ -1448,6 +1938,7 @@ main (int   argc,
   g_test_add_func ("/Adwaita/TabPage/thumbnail_xalign", test_adw_tab_page_thumbnail_xalign);
   g_test_add_func ("/Adwaita/TabPage/thumbnail_yalign", test_adw_tab_page_thumbnail_yalign);
   g_test_add_func ("/Adwaita/TabPage/live_thumbnail", test_adw_tab_page_live_thumbnail);
+  g_test_add_func ("/Adwaita/TabPage/freeze_updates", test_adw_tab_page_freeze_updates);
 
   return g_test_run ();
 }
@@ -7,6 +7,7 @@
  */
 
 #include <adwaita.h>
+#include "adw-animation-scheduler-private.h"
 
 int notified;
 
@@ -22,6 +23,14 @@ notify_cb (GtkWidget *widget, gpointer data)
   notified++;
 }
 
+static void
+count_notify_cb (GObject    *object,
+                 GParamSpec *pspec,
+                 int        *count)
+{
+  (*count)++;
+}
+
 static void
 test_adw_animation_value_from (void)
 {
@@ -164,6 +173,116 @@ test_adw_animation_easing (void)
   g_assert_finalize_object (widget);
 }
 
+static void
+test_adw_animation_cubic_bezier (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwTimedAnimation *animation =
+    ADW_TIMED_ANIMATION (adw_timed_animation_new (widget, 10, 20, 100,
+                                                  adw_callback_animation_target_new (value_cb, NULL, NULL)));
+  double x1, y1, x2, y2;
+  int i;
+
+  g_assert_false (adw_timed_animation_get_cubic_bezier (animation, NULL, NULL, NULL, NULL));
+
+  /* Evenly spaced control points on the diagonal make a linear curve */
+  adw_timed_animation_set_cubic_bezier (animation, 1 / 3.0, 1 / 3.0, 2 / 3.0, 2 / 3.0);
+  g_assert_true (adw_timed_animation_get_cubic_bezier (animation, &x1, &y1, &x2, &y2));
+  g_assert_true (G_APPROX_VALUE (x1, 1 / 3.0, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (y1, 1 / 3.0, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (x2, 2 / 3.0, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (y2, 2 / 3.0, DBL_EPSILON));
+
+  adw_animation_scheduler_start_override ();
+
+  adw_animation_play (ADW_ANIMATION (animation));
+
+  for (i = 1; i < 10; i++) {
+    adw_animation_scheduler_override_step (100);
+
+    g_assert_true (G_APPROX_VALUE (adw_animation_get_value (ADW_ANIMATION (animation)), 10 + i, 0.0001));
+  }
+
+  adw_animation_skip (ADW_ANIMATION (animation));
+
+  adw_animation_scheduler_end_override ();
+
+  adw_timed_animation_set_easing (animation, ADW_EASE_OUT_CUBIC);
+  g_assert_false (adw_timed_animation_get_cubic_bezier (animation, NULL, NULL, NULL, NULL));
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (widget);
+}
+
+static void
+test_adw_animation_cubic_bezier_property (void)
+{
+  GtkWidget *widget = g_object_ref_sink (gtk_button_new ());
+  AdwAnimationTarget *target =
+    adw_callback_animation_target_new (value_cb, NULL, NULL);
+  AdwTimedAnimation *animation =
+    ADW_TIMED_ANIMATION (adw_timed_animation_new (widget, 10, 20, 100,
+                                                  g_object_ref (target)));
+  GVariant *curve;
+  double x1, y1, x2, y2;
+  int easing_notified = 0;
+
+  notified = 0;
+
+  g_signal_connect (animation, "notify::cubic-bezier", G_CALLBACK (notify_cb), NULL);
+  g_signal_connect (animation, "notify::easing", G_CALLBACK (count_notify_cb), &easing_notified);
+
+  g_object_get (animation, "cubic-bezier", &curve, NULL);
+  g_assert_null (curve);
+
+  /* The curve replaces the easing function */
+  adw_timed_animation_set_cubic_bezier (animation, 0.25, 0.1, 0.25, 1);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpint (easing_notified, ==, 1);
+
+  g_object_get (animation, "cubic-bezier", &curve, NULL);
+  g_assert_nonnull (curve);
+  g_variant_get (curve, "(dddd)", &x1, &y1, &x2, &y2);
+  g_assert_true (G_APPROX_VALUE (x1, 0.25, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (y1, 0.1, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (x2, 0.25, DBL_EPSILON));
+  g_assert_true (G_APPROX_VALUE (y2, 1, DBL_EPSILON));
+  g_variant_unref (curve);
+
+  /* Same curve */
+  adw_timed_animation_set_cubic_bezier (animation, 0.25, 0.1, 0.25, 1);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (animation, "cubic-bezier", g_variant_new ("(dddd)", 0.42, 0.0, 0.58, 1.0), NULL);
+  g_assert_true (adw_timed_animation_get_cubic_bezier (animation, &x1, NULL, NULL, NULL));
+  g_assert_true (G_APPROX_VALUE (x1, 0.42, DBL_EPSILON));
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_cmpint (easing_notified, ==, 1);
+
+  /* -0 is the same control point as 0 */
+  adw_timed_animation_set_cubic_bezier (animation, 0.42, -0.0, 0.58, 1.0);
+  g_assert_cmpint (notified, ==, 2);
+
+  /* The easing function replaces the curve, even if it's the same one */
+  adw_timed_animation_set_easing (animation, adw_timed_animation_get_easing (animation));
+  g_assert_false (adw_timed_animation_get_cubic_bezier (animation, NULL, NULL, NULL, NULL));
+  g_assert_cmpint (notified, ==, 3);
+  g_assert_cmpint (easing_notified, ==, 2);
+
+  adw_timed_animation_set_cubic_bezier (animation, 0.25, 0.1, 0.25, 1);
+  g_assert_cmpint (notified, ==, 4);
+  g_assert_cmpint (easing_notified, ==, 3);
+
+  g_object_set (animation, "cubic-bezier", NULL, NULL);
+  g_assert_false (adw_timed_animation_get_cubic_bezier (animation, NULL, NULL, NULL, NULL));
+  g_assert_cmpint (notified, ==, 5);
+  g_assert_cmpint (easing_notified, ==, 4);
+
+  g_assert_finalize_object (animation);
+  g_assert_finalize_object (target);
+  g_assert_finalize_object (widget);
+}
+
 static void
 test_adw_animation_repeat_count (void)
 {
@@ -280,6 +399,8 @@ main (int   argc,
   g_test_add_func("/Adwaita/TimedAnimation/value_to", test_adw_animation_value_to);
   g_test_add_func("/Adwaita/TimedAnimation/duration", test_adw_animation_duration);
   g_test_add_func("/Adwaita/TimedAnimation/easing", test_adw_animation_easing);
+  g_test_add_func("/Adwaita/TimedAnimation/cubic_bezier", test_adw_animation_cubic_bezier);
+  g_test_add_func("/Adwaita/TimedAnimation/cubic_bezier_property", test_adw_animation_cubic_bezier_property);
   g_test_add_func("/Adwaita/TimedAnimation/repeat_count", test_adw_animation_repeat_count);
   g_test_add_func("/Adwaita/TimedAnimation/reverse", test_adw_animation_reverse);
   g_test_add_func("/Adwaita/TimedAnimation/alternate", test_adw_animation_alternate);